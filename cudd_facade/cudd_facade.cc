@@ -12,7 +12,12 @@
 
 
 // Standard library headers
+#include <map>
 #include <stdexcept>
+#include <tr1/unordered_map>
+
+// Boost headers
+#include <boost/functional/hash.hpp>
 
 // SFTA headers
 #include <sfta/cudd_facade.hh>
@@ -130,21 +135,434 @@ namespace SFTA
 		{
 			return isConstantCUDD(toCUDD(sfta_value));
 		}
+
+
+		/**
+		 * @brief  Gets the level of a CUDD node
+		 *
+		 * Returns the level of the variable of given CUDD node in the current
+		 * variable order of the manager. The level of a variable that does not
+		 * exist yet is the level it will be created at, and constant nodes are
+		 * below all variables.
+		 *
+		 * @param[in]  manager  CUDD manager
+		 * @param[in]  index    Index of the variable
+		 *
+		 * @returns  The level of the variable
+		 */
+		inline int getLevelCUDD(DdManager* manager, unsigned index)
+		{
+			if (static_cast<int>(index) < Cudd_ReadSize(manager))
+			{	// in case the variable already exists
+				return Cudd_ReadPerm(manager, static_cast<int>(index));
+			}
+
+			return static_cast<int>(index);
+		}
+
+
+		/**
+		 * @brief  Creates a CUDD node
+		 *
+		 * Creates a CUDD node of the variable with given index with given
+		 * children. In case the variable is above the variables of both children
+		 * in the current variable order, the node is taken directly from the
+		 * unique table, otherwise the if-then-else operation is used so that the
+		 * result respects the order. In case both children are the same node,
+		 * no node is created and the child is returned, so that the MTBDD stays
+		 * reduced. Note that the returned node is not referenced.
+		 *
+		 * @param[in]  manager    CUDD manager
+		 * @param[in]  index      Index of the variable of the node
+		 * @param[in]  thenChild  The "then" child of the node
+		 * @param[in]  elseChild  The "else" child of the node
+		 *
+		 * @returns  The node
+		 */
+		DdNode* createNodeCUDD(DdManager* manager, unsigned index,
+			DdNode* thenChild, DdNode* elseChild)
+		{
+			if (thenChild == elseChild)
+			{	// in case the node would not depend on the variable
+				return thenChild;
+			}
+
+			int level = getLevelCUDD(manager, index);
+
+			DdNode* node = static_cast<DdNode*>(0);
+			if ((isConstantCUDD(thenChild)
+				|| (level < getLevelCUDD(manager, thenChild->index)))
+				&& (isConstantCUDD(elseChild)
+				|| (level < getLevelCUDD(manager, elseChild->index))))
+			{	// in case the node can be placed directly above its children
+				do
+				{
+					manager->reordered = 0;
+					node = cuddUniqueInter(manager, static_cast<int>(index),
+						thenChild, elseChild);
+				} while (manager->reordered == 1);
+
+				assert(node != static_cast<DdNode*>(0));
+				return node;
+			}
+
+			DdNode* var = Cudd_addIthVar(manager, static_cast<int>(index));
+			assert(var != static_cast<DdNode*>(0));
+			Cudd_Ref(var);
+
+			node = Cudd_addIte(manager, var, thenChild, elseChild);
+			assert(node != static_cast<DdNode*>(0));
+			Cudd_Ref(node);
+			Cudd_RecursiveDeref(manager, var);
+			Cudd_Deref(node);
+
+			return node;
+		}
+
+
+		/**
+		 * @brief  Map of copied CUDD nodes
+		 *
+		 * Maps nodes of the source manager of a copy to their (referenced)
+		 * copies in the target manager.
+		 */
+		typedef std::tr1::unordered_map<DdNode*, DdNode*> CopiedNodeMap;
+
+
+		/**
+		 * @brief  Copies a CUDD node to another manager
+		 *
+		 * Recursively copies the MTBDD rooted at given node to the target
+		 * manager, translating values of leaves by given functor. Copies of all
+		 * visited nodes are stored (and referenced) in the map of copied nodes,
+		 * so that shared nodes are copied only once.
+		 *
+		 * @param[in]      target      Target CUDD manager
+		 * @param[in]      node        The node to be copied
+		 * @param[in]      leafMapper  Functor that translates values of leaves
+		 *                             (may be null)
+		 * @param[in,out]  copied      Map of already copied nodes
+		 *
+		 * @returns  The copy of the node (not referenced)
+		 */
+		DdNode* copyNodeCUDD(DdManager* target, DdNode* node,
+			CUDDFacade::AbstractMonadicApplyFunctor* leafMapper, CopiedNodeMap& copied)
+		{
+			CopiedNodeMap::const_iterator itCopied = copied.find(node);
+			if (itCopied != copied.end())
+			{	// in case the node has already been copied
+				return itCopied->second;
+			}
+
+			DdNode* copy = static_cast<DdNode*>(0);
+			if (isConstantCUDD(node))
+			{	// in case the node is a leaf
+				CUDDFacade::ValueType value = node->type.value;
+				if (leafMapper != static_cast<CUDDFacade::AbstractMonadicApplyFunctor*>(0))
+				{	// in case the value is to be translated
+					value = (*leafMapper)(value);
+				}
+
+				copy = Cudd_addConst(target, value);
+			}
+			else
+			{	// the children are kept referenced in the map
+				DdNode* thenChild = copyNodeCUDD(target, cuddT(node), leafMapper, copied);
+				DdNode* elseChild = copyNodeCUDD(target, cuddE(node), leafMapper, copied);
+
+				copy = createNodeCUDD(target, node->index, thenChild, elseChild);
+			}
+
+			assert(copy != static_cast<DdNode*>(0));
+			Cudd_Ref(copy);
+			copied.insert(std::make_pair(node, copy));
+
+			return copy;
+		}
+
+
+		/**
+		 * @brief  Suspends dynamic reordering
+		 *
+		 * Disables dynamic reordering of variables of a CUDD manager for the
+		 * lifetime of the object and restores the original setting when the
+		 * object is destroyed. Functions that walk the structure of an MTBDD
+		 * while creating new nodes need to hold an instance of this class,
+		 * because reordering may change the variables of existing nodes.
+		 */
+		class ReorderingSuspender
+		{
+		private:  // Private data members
+
+			DdManager* manager_;
+			Cudd_ReorderingType method_;
+			bool wasEnabled_;
+
+		private:  // Private methods
+
+			ReorderingSuspender(const ReorderingSuspender&);
+			ReorderingSuspender& operator=(const ReorderingSuspender&);
+
+		public:   // Public methods
+
+			explicit ReorderingSuspender(DdManager* manager)
+				: manager_(manager),
+					method_(CUDD_REORDER_SIFT),
+					wasEnabled_(Cudd_ReorderingStatus(manager, &method_) != 0)
+			{
+				if (wasEnabled_)
+				{	// in case reordering is enabled
+					Cudd_AutodynDisable(manager_);
+				}
+			}
+
+			~ReorderingSuspender()
+			{
+				if (wasEnabled_)
+				{	// in case reordering was enabled
+					Cudd_AutodynEnable(manager_, method_);
+				}
+			}
+		};
+	}
+}
+
+
+/**
+ * @brief  Cache of leaf results
+ *
+ * The structure that stores results of cached Apply operations on leaves. For
+ * every cached operation there is a table that maps tuples of leaves to the
+ * result of the functor of the operation.
+ */
+struct CUDDFacade::LeafCache
+{
+	/**
+	 * @brief  Key of the cache
+	 *
+	 * The type of the key of the table, i.e. a triple of leaves. Unused
+	 * positions (for binary and monadic operations) are set to 0.
+	 */
+	typedef std::pair<ValueType, std::pair<ValueType, ValueType> > KeyType;
+
+
+	/**
+	 * @brief  Table of a single operation
+	 *
+	 * The type of the table that maps keys to results of an operation.
+	 */
+	typedef std::tr1::unordered_map<KeyType, ValueType, boost::hash<KeyType> >
+		TableType;
+
+
+	/**
+	 * @brief  Tables of all operations
+	 *
+	 * The type that maps identifiers of operations to their tables.
+	 */
+	typedef std::map<OperationIdType, TableType> OperationToTableMap;
+
+
+	/**
+	 * Tables of all cached operations.
+	 */
+	OperationToTableMap tables;
+
+
+	/**
+	 * Identifier of the next created operation.
+	 */
+	OperationIdType nextOperation;
+
+
+	/**
+	 * The number of cache hits.
+	 */
+	size_t hits;
+
+
+	/**
+	 * The number of cache misses.
+	 */
+	size_t misses;
+
+
+	LeafCache()
+		: tables(), nextOperation(0), hits(0), misses(0)
+	{ }
+
+
+	/**
+	 * @brief  Gets the table of an operation
+	 *
+	 * Returns the table of given operation. In case there is no such
+	 * operation, an exception is thrown.
+	 *
+	 * @param[in]  op  Identifier of the operation
+	 *
+	 * @returns  The table of the operation
+	 */
+	TableType& getTable(OperationIdType op)
+	{
+		OperationToTableMap::iterator itTables = tables.find(op);
+		if (itTables == tables.end())
+		{	// in case the operation does not exist
+			throw std::runtime_error("Trying to access cached operation \""
+				+ Convert::ToString(op) + "\" that does not exist!");
+		}
+
+		return itTables->second;
+	}
+
+
+	/**
+	 * @brief  Gets the result of an operation on leaves
+	 *
+	 * Returns the result of the functor for given leaves. The result is taken
+	 * from the table in case it is there, otherwise it is computed by @p func
+	 * and stored into the table.
+	 *
+	 * @param[in]  table  The table of the operation
+	 * @param[in]  key    The leaves
+	 * @param[in]  func   The functor computing the result for the leaves
+	 *
+	 * @returns  Result of the operation on the leaves
+	 */
+	template <class Functor>
+	ValueType getResult(TableType& table, const KeyType& key, Functor& func)
+	{
+		TableType::const_iterator itTable = table.find(key);
+		if (itTable != table.end())
+		{	// in case the result is cached
+			++hits;
+			return itTable->second;
+		}
+
+		++misses;
+		ValueType res = func(key);
+		table.insert(std::make_pair(key, res));
+
+		return res;
 	}
+};
+
+
+/**
+ * @brief  Parameters of a cached Apply operation
+ *
+ * The structure that is passed to callbacks of cached Apply operations. It
+ * contains the functor of the operation and the cache where results are
+ * stored.
+ *
+ * @tparam  Functor  The type of the Apply functor
+ */
+template <class Functor>
+struct CachedApplyParameters
+{
+	/**
+	 * The functor of the operation.
+	 */
+	Functor* func;
+
+
+	/**
+	 * The cache of leaf results.
+	 */
+	CUDDFacade::LeafCache* cache;
+
+
+	/**
+	 * The table of the operation in the cache.
+	 */
+	CUDDFacade::LeafCache::TableType* table;
+
+
+	CachedApplyParameters(Functor* fnc, CUDDFacade::LeafCache* lc,
+		CUDDFacade::OperationIdType op)
+		: func(fnc), cache(lc), table(&lc->getTable(op))
+	{ }
+
+
+	/**
+	 * @brief  Calls the functor
+	 *
+	 * Calls the functor of the operation on the leaves in given key. The
+	 * positions of the key that are not used by the functor are ignored.
+	 *
+	 * @param[in]  key  The leaves
+	 *
+	 * @returns  Result of the functor
+	 */
+	CUDDFacade::ValueType operator()(const CUDDFacade::LeafCache::KeyType& key);
+
+
+private:  // Private methods
+
+	CachedApplyParameters(const CachedApplyParameters&);
+	CachedApplyParameters& operator=(const CachedApplyParameters&);
+};
+
+
+template <>
+CUDDFacade::ValueType
+	CachedApplyParameters<CUDDFacade::AbstractApplyFunctor>::operator()(
+	const CUDDFacade::LeafCache::KeyType& key)
+{
+	return (*func)(key.first, key.second.first);
+}
+
+
+template <>
+CUDDFacade::ValueType
+	CachedApplyParameters<CUDDFacade::AbstractTernaryApplyFunctor>::operator()(
+	const CUDDFacade::LeafCache::KeyType& key)
+{
+	return (*func)(key.first, key.second.first, key.second.second);
 }
 
 
-CUDDFacade::CUDDFacade()
-	: manager_(static_cast<Manager*>(0))
+template <>
+CUDDFacade::ValueType
+	CachedApplyParameters<CUDDFacade::AbstractMonadicApplyFunctor>::operator()(
+	const CUDDFacade::LeafCache::KeyType& key)
 {
+	return (*func)(key.first);
+}
+
+
+CUDDFacade::CUDDFacade(const ManagerConfiguration& config)
+	: manager_(static_cast<Manager*>(0)),
+		leafCache_(new LeafCache())
+{
+	unsigned uniqueSlots = (config.uniqueSlots != 0)?
+		config.uniqueSlots : CUDD_UNIQUE_SLOTS;
+	unsigned cacheSlots = (config.cacheSlots != 0)?
+		config.cacheSlots : CUDD_CACHE_SLOTS;
+
 	// Create the manager
-	if ((manager_ = fromCUDD(Cudd_Init(0, 0, CUDD_UNIQUE_SLOTS, CUDD_CACHE_SLOTS, 0)))
-		== static_cast<Manager*>(0))
+	if ((manager_ = fromCUDD(Cudd_Init(0, 0, uniqueSlots, cacheSlots,
+		config.maxMemory))) == static_cast<Manager*>(0))
 	{	// in case the manager could not be created
+		delete leafCache_;
 		std::string error_msg = "CUDD Manager could not be created";
 		SFTA_LOGGER_FATAL(error_msg);
 		throw std::runtime_error(error_msg);
 	}
+
+	if (config.maxCacheSlots != 0)
+	{	// in case the maximum size of the computed table is given
+		Cudd_SetMaxCacheHard(toCUDD(manager_), config.maxCacheSlots);
+	}
+
+	if (config.gcThreshold != 0)
+	{	// in case the garbage collection threshold is given
+		Cudd_SetLooseUpTo(toCUDD(manager_), config.gcThreshold);
+	}
+
+	if (config.dynamicReordering)
+	{	// in case variables are to be reordered dynamically
+		EnableDynamicReordering();
+	}
 }
 
 
@@ -292,6 +710,25 @@ CUDDFacade::Node* CUDDFacade::Times(Node* lhs, Node* rhs) const
 }
 
 
+CUDDFacade::Node* CUDDFacade::Ite(Node* ifNode, Node* thenNode,
+	Node* elseNode) const
+{
+	// Assertions
+	assert(manager_ != static_cast<Manager*>(0));
+	assert(ifNode != static_cast<Node*>(0));
+	assert(thenNode != static_cast<Node*>(0));
+	assert(elseNode != static_cast<Node*>(0));
+
+	Node* res = fromCUDD(Cudd_addIte(toCUDD(manager_), toCUDD(ifNode),
+		toCUDD(thenNode), toCUDD(elseNode)));
+
+	// check the return value
+	assert(res != static_cast<Node*>(0));
+
+	return res;
+}
+
+
 DdNode* applyCallback(DdManager* dd, DdNode** f, DdNode** g, void* data)
 {
 	// Assertions
@@ -397,6 +834,115 @@ DdNode* monadicApplyCallback(DdManager* dd, DdNode* f, void* data)
 }
 
 
+DdNode* cachedApplyCallback(DdManager* dd, DdNode** f, DdNode** g, void* data)
+{
+	// Assertions
+	assert(dd   != static_cast<DdManager*>(0));
+	assert(f    != static_cast<DdNode**>(0));
+	assert(g    != static_cast<DdNode**>(0));
+	assert(data != static_cast<void*>(0));
+
+	// get values of the nodes
+	DdNode* F = *f;
+	DdNode* G = *g;
+
+	// Further assertions
+	assert(F    != static_cast<DdNode*>(0));
+	assert(G    != static_cast<DdNode*>(0));
+
+	if (isConstantCUDD(F) && isConstantCUDD(G))
+	{	// in case we are at leaves
+
+		// get the parameters of the operation
+		CachedApplyParameters<CUDDFacade::AbstractApplyFunctor>& params =
+			*(static_cast<CachedApplyParameters<CUDDFacade::AbstractApplyFunctor>*>(data));
+
+		DdNode* res = cuddUniqueConst(dd, params.cache->getResult(*params.table,
+			std::make_pair(cuddV(F), std::make_pair(cuddV(G), 0U)), params));
+
+		// check the return value
+		assert(res != static_cast<DdNode*>(0));
+
+		return res;
+	}
+	else
+	{	// in case we are not at leaves
+		return static_cast<DdNode*>(0);
+	}
+}
+
+
+DdNode* cachedTernaryApplyCallback(DdManager* dd, DdNode** f, DdNode** g,
+	DdNode** h, void* data)
+{
+	// Assertions
+	assert(dd   != static_cast<DdManager*>(0));
+	assert(f    != static_cast<DdNode**>(0));
+	assert(g    != static_cast<DdNode**>(0));
+	assert(h    != static_cast<DdNode**>(0));
+	assert(data != static_cast<void*>(0));
+
+	// get values of the nodes
+	DdNode* F = *f;
+	DdNode* G = *g;
+	DdNode* H = *h;
+
+	// Further assertions
+	assert(F    != static_cast<DdNode*>(0));
+	assert(G    != static_cast<DdNode*>(0));
+	assert(H    != static_cast<DdNode*>(0));
+
+	if (isConstantCUDD(F) && isConstantCUDD(G) && isConstantCUDD(H))
+	{	// in case we are at leaves
+
+		// get the parameters of the operation
+		CachedApplyParameters<CUDDFacade::AbstractTernaryApplyFunctor>& params =
+			*(static_cast<CachedApplyParameters<CUDDFacade::AbstractTernaryApplyFunctor>*>(data));
+
+		DdNode* res = cuddUniqueConst(dd, params.cache->getResult(*params.table,
+			std::make_pair(cuddV(F), std::make_pair(cuddV(G), cuddV(H))), params));
+
+		// check the return value
+		assert(res != static_cast<DdNode*>(0));
+
+		return res;
+	}
+	else
+	{	// in case we are not at leaves
+		return static_cast<DdNode*>(0);
+	}
+}
+
+
+DdNode* cachedMonadicApplyCallback(DdManager* dd, DdNode* f, void* data)
+{
+	// Assertions
+	assert(dd   != static_cast<DdManager*>(0));
+	assert(f    != static_cast<DdNode*>(0));
+	assert(data != static_cast<void*>(0));
+
+	if (isConstantCUDD(f))
+	{	// in case we are at leaves
+
+		// get the parameters of the operation
+		CachedApplyParameters<CUDDFacade::AbstractMonadicApplyFunctor>& params =
+			*(static_cast<CachedApplyParameters<CUDDFacade::AbstractMonadicApplyFunctor>*>(data));
+
+		DdNode* res = cuddUniqueConst(dd, params.cache->getResult(*params.table,
+			std::make_pair(cuddV(f), std::make_pair(0U, 0U)), params));
+
+		// check the return value
+		assert(res != static_cast<DdNode*>(0));
+
+		return(res);
+	}
+	else
+	{	// in case we are not at leaves
+		return static_cast<DdNode*>(0);
+	}
+}
+
+
 CUDDFacade::Node* CUDDFacade::Apply(Node* lhs, Node* rhs,
 	AbstractApplyFunctor* func) const
 {
@@ -454,6 +1000,220 @@ CUDDFacade::Node* CUDDFacade::MonadicApply(Node* root,
 }
 
 
+CUDDFacade::OperationIdType CUDDFacade::CreateCachedOperation() const
+{
+	// Assertions
+	assert(leafCache_ != static_cast<LeafCache*>(0));
+
+	OperationIdType op = leafCache_->nextOperation++;
+	leafCache_->tables.insert(std::make_pair(op, LeafCache::TableType()));
+
+	return op;
+}
+
+
+void CUDDFacade::InvalidateCachedOperation(OperationIdType op) const
+{
+	// Assertions
+	assert(leafCache_ != static_cast<LeafCache*>(0));
+
+	leafCache_->getTable(op).clear();
+}
+
+
+void CUDDFacade::InvalidateAllCachedOperations() const
+{
+	// Assertions
+	assert(leafCache_ != static_cast<LeafCache*>(0));
+
+	for (LeafCache::OperationToTableMap::iterator itTables =
+		leafCache_->tables.begin(); itTables != leafCache_->tables.end(); ++itTables)
+	{	// clear the table of every operation
+		itTables->second.clear();
+	}
+}
+
+
+void CUDDFacade::EraseCachedOperation(OperationIdType op) const
+{
+	// Assertions
+	assert(leafCache_ != static_cast<LeafCache*>(0));
+
+	if (leafCache_->tables.erase(op) == 0)
+	{	// in case the operation does not exist
+		throw std::runtime_error("Trying to erase cached operation \""
+			+ Convert::ToString(op) + "\" that does not exist!");
+	}
+}
+
+
+CUDDFacade::Node* CUDDFacade::Apply(Node* lhs, Node* rhs,
+	AbstractApplyFunctor* func, OperationIdType op) const
+{
+	// Assertions
+	assert(manager_ != static_cast<Manager*>(0));
+	assert(leafCache_ != static_cast<LeafCache*>(0));
+	assert(lhs != static_cast<Node*>(0));
+	assert(rhs != static_cast<Node*>(0));
+	assert(func != static_cast<AbstractApplyFunctor*>(0));
+
+	CachedApplyParameters<AbstractApplyFunctor> params(func, leafCache_, op);
+
+	Node* res = fromCUDD(Cudd_addApplyWithData(
+		toCUDD(manager_), cachedApplyCallback, toCUDD(lhs), toCUDD(rhs), &params));
+
+	// check the return value
+	assert(res != static_cast<Node*>(0));
+
+	return res;
+}
+
+
+CUDDFacade::Node* CUDDFacade::TernaryApply(Node* lhs, Node* mhs, Node* rhs,
+	AbstractTernaryApplyFunctor* func, OperationIdType op) const
+{
+	// Assertions
+	assert(manager_ != static_cast<Manager*>(0));
+	assert(leafCache_ != static_cast<LeafCache*>(0));
+	assert(lhs != static_cast<Node*>(0));
+	assert(mhs != static_cast<Node*>(0));
+	assert(rhs != static_cast<Node*>(0));
+	assert(func != static_cast<AbstractTernaryApplyFunctor*>(0));
+
+	CachedApplyParameters<AbstractTernaryApplyFunctor> params(func, leafCache_, op);
+
+	Node* res = fromCUDD(Cudd_addTernaryApplyWithData(toCUDD(manager_),
+		cachedTernaryApplyCallback, toCUDD(lhs), toCUDD(mhs), toCUDD(rhs), &params));
+
+	// check the return value
+	assert(res != static_cast<Node*>(0));
+
+	return res;
+}
+
+
+CUDDFacade::Node* CUDDFacade::MonadicApply(Node* root,
+	AbstractMonadicApplyFunctor* func, OperationIdType op) const
+{
+	// Assertions
+	assert(manager_ != static_cast<Manager*>(0));
+	assert(leafCache_ != static_cast<LeafCache*>(0));
+	assert(root != static_cast<Node*>(0));
+	assert(func != static_cast<AbstractMonadicApplyFunctor*>(0));
+
+	CachedApplyParameters<AbstractMonadicApplyFunctor> params(func, leafCache_, op);
+
+	Node* res = fromCUDD(Cudd_addMonadicApplyWithData(
+		toCUDD(manager_), cachedMonadicApplyCallback, toCUDD(root), &params));
+
+	// check the return value
+	assert(res != static_cast<Node*>(0));
+
+	return res;
+}
+
+
+size_t CUDDFacade::GetLeafCacheHits() const
+{
+	// Assertions
+	assert(leafCache_ != static_cast<LeafCache*>(0));
+
+	return leafCache_->hits;
+}
+
+
+size_t CUDDFacade::GetLeafCacheMisses() const
+{
+	// Assertions
+	assert(leafCache_ != static_cast<LeafCache*>(0));
+
+	return leafCache_->misses;
+}
+
+
+unsigned long CUDDFacade::GetPeakNodeCount() const
+{
+	// Assertions
+	assert(manager_ != static_cast<Manager*>(0));
+
+	long peak = Cudd_ReadPeakNodeCount(toCUDD(manager_));
+	assert(peak >= 0);
+
+	return static_cast<unsigned long>(peak);
+}
+
+
+double CUDDFacade::GetComputedTableHitRate() const
+{
+	// Assertions
+	assert(manager_ != static_cast<Manager*>(0));
+
+	double lookups = Cudd_ReadCacheLookUps(toCUDD(manager_));
+	if (lookups == 0.0)
+	{	// in case there have been no lookups
+		return 0.0;
+	}
+
+	return Cudd_ReadCacheHits(toCUDD(manager_)) / lookups;
+}
+
+
+unsigned long CUDDFacade::GetNodeCount() const
+{
+	// Assertions
+	assert(manager_ != static_cast<Manager*>(0));
+
+	long count = Cudd_ReadNodeCount(toCUDD(manager_));
+	assert(count >= 0);
+
+	return static_cast<unsigned long>(count);
+}
+
+
+void CUDDFacade::EnableDynamicReordering() const
+{
+	// Assertions
+	assert(manager_ != static_cast<Manager*>(0));
+
+	Cudd_AutodynEnable(toCUDD(manager_), CUDD_REORDER_SIFT);
+}
+
+
+void CUDDFacade::DisableDynamicReordering() const
+{
+	// Assertions
+	assert(manager_ != static_cast<Manager*>(0));
+
+	Cudd_AutodynDisable(toCUDD(manager_));
+}
+
+
+void CUDDFacade::ReorderVariables() const
+{
+	// Assertions
+	assert(manager_ != static_cast<Manager*>(0));
+
+	if (Cudd_ReduceHeap(toCUDD(manager_), CUDD_REORDER_SIFT, 0) == 0)
+	{	// in case the reordering failed
+		std::string error_msg = "Reordering of variables failed";
+		SFTA_LOGGER_ERROR(error_msg);
+		throw std::runtime_error(error_msg);
+	}
+}
+
+
+unsigned CUDDFacade::GetReorderingCount() const
+{
+	// Assertions
+	assert(manager_ != static_cast<Manager*>(0));
+
+	int count = Cudd_ReadReorderings(toCUDD(manager_));
+	assert(count >= 0);
+
+	return static_cast<unsigned>(count);
+}
+
+
 CUDDFacade::Node* CUDDFacade::GetThenChild(Node* node) const
 {
 	// Assertions
@@ -514,6 +1274,9 @@ CUDDFacade::Node* CUDDFacade::ChangeVariableIndex(Node* root,
 		return root;
 	}
 
+	// the structure of the MTBDD must not change while it is being traversed
+	ReorderingSuspender suspender(toCUDD(manager_));
+
 	unsigned currentIndex = GetNodeIndex(root);
 	unsigned nodeIndex;
 	Node* thenChild = static_cast<Node*>(0);
@@ -522,24 +1285,29 @@ CUDDFacade::Node* CUDDFacade::ChangeVariableIndex(Node* root,
 	if (currentIndex == oldIndex)
 	{	// in case we hit a node with the desired variable index
 		thenChild = GetThenChild(root);
+		Ref(thenChild);
 		elseChild = GetElseChild(root);
+		Ref(elseChild);
 
 		nodeIndex = newIndex;
 	}
 	else
 	{
 		thenChild = ChangeVariableIndex(GetThenChild(root), oldIndex, newIndex);
+		Ref(thenChild);
 		elseChild = ChangeVariableIndex(GetElseChild(root), oldIndex, newIndex);
+		Ref(elseChild);
 
 		nodeIndex = currentIndex;
 	}
 
-	do
-	{	// perform conzistenciation of the MTBDD
-		toCUDD(manager_)->reordered = 0;
-		root = fromCUDD(cuddUniqueInter(toCUDD(manager_), nodeIndex,
-			toCUDD(thenChild), toCUDD(elseChild)));
-	} while (toCUDD(manager_)->reordered == 1);
+	// the new variable need not be above the children in the variable order
+	root = fromCUDD(createNodeCUDD(toCUDD(manager_), nodeIndex,
+		toCUDD(thenChild), toCUDD(elseChild)));
+	Ref(root);
+	RecursiveDeref(thenChild);
+	RecursiveDeref(elseChild);
+	Cudd_Deref(toCUDD(root));
 
 	return root;
 }
@@ -560,6 +1328,9 @@ CUDDFacade::Node* CUDDFacade::RemoveVariables(Node* root,
 		return root;
 	}
 
+	// the structure of the MTBDD must not change while it is being traversed
+	ReorderingSuspender suspender(toCUDD(manager_));
+
 	Node* thenChild = RemoveVariables(GetThenChild(root), predicate, merger);
 	Node* elseChild = RemoveVariables(GetElseChild(root), predicate, merger);
 
@@ -573,21 +1344,78 @@ CUDDFacade::Node* CUDDFacade::RemoveVariables(Node* root,
 	}
 	else
 	{	// in case the node is to stay
-		do
-		{
-			toCUDD(manager_)->reordered = 0;
-			root = fromCUDD(cuddUniqueInter(toCUDD(manager_), index,
-				toCUDD(thenChild), toCUDD(elseChild)));
-			Ref(root);
-			RecursiveDeref(elseChild);
-			RecursiveDeref(thenChild);
-		} while (toCUDD(manager_)->reordered == 1);
+		root = fromCUDD(createNodeCUDD(toCUDD(manager_), index,
+			toCUDD(thenChild), toCUDD(elseChild)));
+		Ref(root);
+		RecursiveDeref(elseChild);
+		RecursiveDeref(thenChild);
 	}
 
 	return root;
 }
 
 
+std::vector<CUDDFacade::Node*> CUDDFacade::CopyTo(const CUDDFacade& target,
+	const std::vector<Node*>& roots, AbstractMonadicApplyFunctor* leafMapper) const
+{
+	// Assertions
+	assert(manager_ != static_cast<Manager*>(0));
+	assert(target.manager_ != static_cast<Manager*>(0));
+
+	if (target.manager_ == manager_)
+	{	// in case there is nothing to copy between
+		throw std::runtime_error(__func__ +
+			std::string(": cannot copy MTBDDs to the same manager"));
+	}
+
+	// the structure of the MTBDDs must not change while they are being
+	// traversed, nodes of the target must not move while they are being created
+	ReorderingSuspender sourceSuspender(toCUDD(manager_));
+	ReorderingSuspender targetSuspender(toCUDD(target.manager_));
+
+	CopiedNodeMap copied;
+	std::vector<Node*> result;
+	result.reserve(roots.size());
+	try
+	{
+		for (std::vector<Node*>::const_iterator itRoots = roots.begin();
+			itRoots != roots.end(); ++itRoots)
+		{	// copy all roots
+			assert(*itRoots != static_cast<Node*>(0));
+
+			DdNode* copy = copyNodeCUDD(toCUDD(target.manager_), toCUDD(*itRoots),
+				leafMapper, copied);
+			Cudd_Ref(copy);
+			result.push_back(fromCUDD(copy));
+		}
+	}
+	catch (...)
+	{	// in case the leaf mapper fails, nothing stays referenced in the target
+		for (std::vector<Node*>::const_iterator itResult = result.begin();
+			itResult != result.end(); ++itResult)
+		{
+			Cudd_RecursiveDeref(toCUDD(target.manager_), toCUDD(*itResult));
+		}
+
+		for (CopiedNodeMap::const_iterator itCopied = copied.begin();
+			itCopied != copied.end(); ++itCopied)
+		{
+			Cudd_RecursiveDeref(toCUDD(target.manager_), itCopied->second);
+		}
+
+		throw;
+	}
+
+	for (CopiedNodeMap::const_iterator itCopied = copied.begin();
+		itCopied != copied.end(); ++itCopied)
+	{	// release the references held by the map
+		Cudd_RecursiveDeref(toCUDD(target.manager_), itCopied->second);
+	}
+
+	return result;
+}
+
+
 CUDDFacade::ValueType CUDDFacade::GetNodeValue(Node* node) const
 {
 	// Assertions
@@ -892,4 +1720,8 @@ CUDDFacade::~CUDDFacade()
 	// Delete the manager
 	Cudd_Quit(toCUDD(manager_));
 	manager_ = static_cast<Manager*>(0);
+
+	// Delete the cache of leaf results
+	delete leafCache_;
+	leafCache_ = static_cast<LeafCache*>(0);
 }
@@ -74,6 +74,27 @@ public:  // Public types
 	struct Node;
 
 
+	/**
+	 * @brief  Type of the cache of leaf results
+	 *
+	 * The type of the cache that stores results of cached Apply operations on
+	 * leaves. The type is defined only in the implementation file of the
+	 * facade.
+	 */
+	struct LeafCache;
+
+
+	/**
+	 * @brief  Identifier of a cached operation
+	 *
+	 * The type of identifiers of Apply operations the results of which on
+	 * leaves are cached by the facade.
+	 *
+	 * @see  CreateCachedOperation()
+	 */
+	typedef unsigned OperationIdType;
+
+
 	/**
 	 * @brief  String to node directory
 	 *
@@ -114,6 +135,73 @@ public:  // Public types
 	typedef ParentClass::AbstractMonadicApplyFunctor AbstractMonadicApplyFunctor;
 
 
+	/**
+	 * @brief  Configuration of MTBDD manager
+	 *
+	 * The structure that holds parameters of the MTBDD manager. The value of
+	 * 0 of any parameter means that the default value of the MTBDD package is
+	 * used.
+	 */
+	struct ManagerConfiguration
+	{
+		/**
+		 * Initial number of slots of each subtable of the unique table.
+		 */
+		unsigned uniqueSlots;
+
+
+		/**
+		 * Initial number of slots of the computed table (cache).
+		 */
+		unsigned cacheSlots;
+
+
+		/**
+		 * The maximum number of slots the computed table can grow to.
+		 */
+		unsigned maxCacheSlots;
+
+
+		/**
+		 * Target maximum memory occupation of the manager (in bytes).
+		 */
+		unsigned long maxMemory;
+
+
+		/**
+		 * @brief  Garbage collection threshold
+		 *
+		 * The number of slots of the unique table up to which the table is
+		 * grown when full instead of collecting garbage.
+		 */
+		unsigned gcThreshold;
+
+
+		/**
+		 * @brief  Dynamic reordering
+		 *
+		 * Determines whether variables are reordered by sifting whenever the
+		 * number of nodes of the manager grows too much.
+		 */
+		bool dynamicReordering;
+
+
+		/**
+		 * @brief  Constructor
+		 *
+		 * Creates the configuration with default values of all parameters.
+		 */
+		ManagerConfiguration()
+			: uniqueSlots(0),
+				cacheSlots(0),
+				maxCacheSlots(0),
+				maxMemory(0),
+				gcThreshold(0),
+				dynamicReordering(false)
+		{ }
+	};
+
+
 	/**
 	 * @brief  The abstract class for a functor for predicates over nodes
 	 *
@@ -166,6 +254,14 @@ private: // Private data members
 	Manager* manager_;
 
 
+	/**
+	 * @brief  Cache of leaf results
+	 *
+	 * Cache that stores results of cached Apply operations on leaves.
+	 */
+	LeafCache* leafCache_;
+
+
 private: // Private methods
 
 	/**
@@ -189,11 +285,14 @@ private: // Private methods
 public:  // Public methods
 
 	/**
-	 * @brief  Implicit constructor
+	 * @brief  Constructor
+	 *
+	 * Constructor of CUDDFacade. Initializes the CUDD manager with given
+	 * configuration.
 	 *
-	 * Implicit constructor of CUDDFacade. Initializes the CUDD manager.
+	 * @param[in]  config  Configuration of the manager
 	 */
-	CUDDFacade();
+	explicit CUDDFacade(const ManagerConfiguration& config = ManagerConfiguration());
 
 
 	/**
@@ -334,6 +433,26 @@ public:  // Public methods
 	Node* Times(Node* lhs, Node* rhs) const;
 
 
+	/**
+	 * @brief  If-then-else operation
+	 *
+	 * Creates an MTBDD that evaluates to @p thenNode for assignments that
+	 * satisfy the Boolean expression @p ifNode and to @p elseNode for other
+	 * assignments. In case @p ifNode is a single variable created by
+	 * AddIthVar(), this operation creates a new MTBDD node for the variable
+	 * with given children.
+	 *
+	 * @see  AddIthVar()
+	 *
+	 * @param[in]  ifNode    The condition (needs to be a Boolean expression)
+	 * @param[in]  thenNode  The MTBDD for assignments satisfying the condition
+	 * @param[in]  elseNode  The MTBDD for other assignments
+	 *
+	 * @returns  The resulting MTBDD
+	 */
+	Node* Ite(Node* ifNode, Node* thenNode, Node* elseNode) const;
+
+
 	/**
 	 * @brief  Apply operation
 	 *
@@ -388,6 +507,219 @@ public:  // Public methods
 	Node* MonadicApply(Node* root, AbstractMonadicApplyFunctor* func) const;
 
 
+	/**
+	 * @brief  Creates a new cached operation
+	 *
+	 * Creates a new identifier of an operation the results of which on leaves
+	 * are cached. The identifier can be passed to cached versions of Apply(),
+	 * TernaryApply() and MonadicApply(); the results of the functor are then
+	 * computed only once for every tuple of leaves. The cache needs to be
+	 * released using EraseCachedOperation() when it is no longer needed.
+	 *
+	 * @see  InvalidateCachedOperation()
+	 * @see  EraseCachedOperation()
+	 *
+	 * @returns  Identifier of the new operation
+	 */
+	OperationIdType CreateCachedOperation() const;
+
+
+	/**
+	 * @brief  Invalidates the cache of an operation
+	 *
+	 * Removes all results of given operation from the cache. This needs to be
+	 * called whenever the result of a stateful functor of the operation for
+	 * some leaves may change.
+	 *
+	 * @param[in]  op  Identifier of the operation
+	 */
+	void InvalidateCachedOperation(OperationIdType op) const;
+
+
+	/**
+	 * @brief  Invalidates the cache of all operations
+	 *
+	 * Removes the results of all operations from the cache, e.g. when the
+	 * meaning of some leaf value changes.
+	 */
+	void InvalidateAllCachedOperations() const;
+
+
+	/**
+	 * @brief  Erases a cached operation
+	 *
+	 * Releases the cache of given operation. The identifier of the operation
+	 * cannot be used any more.
+	 *
+	 * @param[in]  op  Identifier of the operation
+	 */
+	void EraseCachedOperation(OperationIdType op) const;
+
+
+	/**
+	 * @brief  Cached Apply operation
+	 *
+	 * Performs the Apply operation the same way as Apply() but the results of
+	 * the functor on pairs of leaves are cached under given operation.
+	 *
+	 * @see  Apply()
+	 * @see  CreateCachedOperation()
+	 *
+	 * @param[in]  lhs   Left-hand side MTBDD of Apply operation
+	 * @param[in]  rhs   Right-hand side MTBDD of Apply operation 
+	 * @param[in]  func  Functor with Apply operation
+	 * @param[in]  op    Identifier of the cached operation
+	 *
+	 * @returns  The resulting MTBDD
+	 */
+	Node* Apply(Node* lhs, Node* rhs, AbstractApplyFunctor* func,
+		OperationIdType op) const;
+
+
+	/**
+	 * @brief  Cached ternary Apply operation
+	 *
+	 * Performs the ternary Apply operation the same way as TernaryApply() but
+	 * the results of the functor on triples of leaves are cached under given
+	 * operation.
+	 *
+	 * @see  TernaryApply()
+	 * @see  CreateCachedOperation()
+	 *
+	 * @param[in]  lhs   Left-hand side MTBDD of Apply operation
+	 * @param[in]  mhs   Middle-hand side MTBDD of Apply operation
+	 * @param[in]  rhs   Right-hand side MTBDD of Apply operation 
+	 * @param[in]  func  Functor with Apply operation
+	 * @param[in]  op    Identifier of the cached operation
+	 *
+	 * @returns  The resulting MTBDD
+	 */
+	Node* TernaryApply(Node* lhs, Node* mhs, Node* rhs,
+		AbstractTernaryApplyFunctor* func, OperationIdType op) const;
+
+
+	/**
+	 * @brief  Cached monadic Apply operation
+	 *
+	 * Performs the monadic Apply operation the same way as MonadicApply() but
+	 * the results of the functor on leaves are cached under given operation.
+	 *
+	 * @see  MonadicApply()
+	 * @see  CreateCachedOperation()
+	 *
+	 * @param[in]  root  Root of the MTBDD of monadic Apply operation
+	 * @param[in]  func  Functor with monadic Apply operation
+	 * @param[in]  op    Identifier of the cached operation
+	 *
+	 * @returns  The resulting MTBDD
+	 */
+	Node* MonadicApply(Node* root, AbstractMonadicApplyFunctor* func,
+		OperationIdType op) const;
+
+
+	/**
+	 * @brief  Gets the number of hits of the leaf cache
+	 *
+	 * Returns the number of results of cached operations that were found in
+	 * the cache.
+	 *
+	 * @returns  The number of cache hits
+	 */
+	size_t GetLeafCacheHits() const;
+
+
+	/**
+	 * @brief  Gets the number of misses of the leaf cache
+	 *
+	 * Returns the number of results of cached operations that were not found
+	 * in the cache and needed to be computed.
+	 *
+	 * @returns  The number of cache misses
+	 */
+	size_t GetLeafCacheMisses() const;
+
+
+	/**
+	 * @brief  Gets the peak number of nodes
+	 *
+	 * Returns the peak number of nodes that were allocated by the manager at
+	 * the same time.
+	 *
+	 * @returns  The peak number of nodes
+	 */
+	unsigned long GetPeakNodeCount() const;
+
+
+	/**
+	 * @brief  Gets the hit rate of the computed table
+	 *
+	 * Returns the ratio of successful lookups into the computed table of the
+	 * manager to all lookups.
+	 *
+	 * @returns  The hit rate of the computed table (between 0 and 1)
+	 */
+	double GetComputedTableHitRate() const;
+
+
+	/**
+	 * @brief  Gets the number of live nodes
+	 *
+	 * Returns the number of nodes of all MTBDDs that are currently referenced
+	 * in the manager.
+	 *
+	 * @returns  The number of live nodes
+	 */
+	unsigned long GetNodeCount() const;
+
+
+	/**
+	 * @brief  Enables dynamic reordering
+	 *
+	 * Enables dynamic reordering of variables by sifting. The variables are
+	 * then reordered automatically during operations whenever the number of
+	 * nodes of the manager grows too much. Note that functors of Apply
+	 * operations may then be called more than once for the same leaves.
+	 *
+	 * @see  DisableDynamicReordering()
+	 * @see  ReorderVariables()
+	 */
+	void EnableDynamicReordering() const;
+
+
+	/**
+	 * @brief  Disables dynamic reordering
+	 *
+	 * Disables dynamic reordering of variables enabled previously by
+	 * EnableDynamicReordering().
+	 *
+	 * @see  EnableDynamicReordering()
+	 */
+	void DisableDynamicReordering() const;
+
+
+	/**
+	 * @brief  Reorders variables
+	 *
+	 * Immediately reorders variables of the manager by sifting in order to
+	 * decrease the number of nodes of all MTBDDs. Only referenced nodes are
+	 * kept by the reordering.
+	 *
+	 * @see  EnableDynamicReordering()
+	 */
+	void ReorderVariables() const;
+
+
+	/**
+	 * @brief  Gets the number of reorderings
+	 *
+	 * Returns how many times the variables of the manager have been
+	 * reordered.
+	 *
+	 * @returns  The number of reorderings
+	 */
+	unsigned GetReorderingCount() const;
+
+
 	/**
 	 * @brief  Gets node's "then" child
 	 *
@@ -460,7 +792,8 @@ public:  // Public methods
 	 * Changes the index of all nodes that represent the Boolean variable with
 	 * given index in an MTBDD rooted at given node. Note that the MTBDD needs
 	 * to be correctly formed, the behaviour is undefined otherwise. Variable
-	 * with the same index cannot occur in the MTBDD!
+	 * with the same index cannot occur in the MTBDD! The renamed nodes are
+	 * moved to the level of the new variable in the current variable order.
 	 *
 	 * @param[in]  root      The root of the MTBDD
 	 * @param[in]  oldIndex  The old index of the variable
@@ -494,6 +827,32 @@ public:  // Public methods
 		AbstractApplyFunctor* merger) const;
 
 
+	/**
+	 * @brief  Copies MTBDDs to another manager
+	 *
+	 * Copies MTBDDs rooted at given nodes to the manager of another facade
+	 * directly, node by node, without storing them into a string. Nodes that
+	 * are shared by the MTBDDs are copied only once. Values of leaves are
+	 * translated by given functor, e.g. to handles of a different leaf
+	 * allocator; the functor is called once for every leaf. Leaves that are
+	 * translated to the same value are merged, as are the nodes above them
+	 * that become redundant. Variables keep their indices, the copies respect
+	 * the variable order of the target manager. In case the functor throws an
+	 * exception, the exception is passed on and no copied node is left
+	 * referenced in the target. Note that the output MTBDDs are already
+	 * referenced so @c Ref() should not be called for them.
+	 *
+	 * @param[in]  target      The facade the MTBDDs are copied to
+	 * @param[in]  roots       Roots of the MTBDDs in this facade
+	 * @param[in]  leafMapper  The functor that translates values of leaves, or
+	 *                         null if the values are to be kept
+	 *
+	 * @returns  Roots of the copies in @p target, in the order of @p roots
+	 */
+	std::vector<Node*> CopyTo(const CUDDFacade& target,
+		const std::vector<Node*>& roots, AbstractMonadicApplyFunctor* leafMapper) const;
+
+
 	/**
 	 * @brief  Gets the value of a node
 	 *
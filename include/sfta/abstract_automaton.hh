@@ -15,6 +15,8 @@
 #include <sfta/base_transition_table_wrapper.hh>
 #include <sfta/convert.hh>
 #include <sfta/simulation_relation.hh>
+#include <sfta/witness_tree.hh>
+#include <sfta/worklist.hh>
 
 // Standard library headers
 #include <cassert>
@@ -94,9 +96,126 @@ public:   // Public data types
 
 		typedef SFTA::SimulationRelation<StateType> SimulationRelationType;
 
+		typedef SFTA::WitnessTree<SymbolType> WitnessTreeType;
+
+
+	private:  // Private data members
+
+
+		/**
+		 * The strategy of worklists of language inclusion checking.
+		 */
+		WorklistStrategy worklistStrategy_;
+
+
+		/**
+		 * Whether useless states are removed from products of automata.
+		 */
+		bool isPruningProducts_;
+
+
+		/**
+		 * The number of pairs processed by the last language inclusion check.
+		 */
+		mutable size_t processedPairs_;
+
+
+		/**
+		 * The tree witnessing that the last language inclusion check failed.
+		 */
+		mutable WitnessTreeType witness_;
+
+
+	protected:// Protected methods
+
+		inline void setNumberOfProcessedPairs(size_t processedPairs) const
+		{
+			processedPairs_ = processedPairs;
+		}
+
+		inline void setWitness(const WitnessTreeType& witness) const
+		{
+			witness_ = witness;
+		}
+
 
 	public:   // Public methods
 
+		Operation()
+			: worklistStrategy_(WORKLIST_BFS),
+				isPruningProducts_(false),
+				processedPairs_(0),
+				witness_()
+		{ }
+
+
+		/**
+		 * @brief  Sets the worklist strategy
+		 *
+		 * Sets the order in which pairs are explored by language inclusion
+		 * checking.
+		 *
+		 * @param[in]  strategy  The strategy
+		 */
+		inline void SetWorklistStrategy(WorklistStrategy strategy)
+		{
+			worklistStrategy_ = strategy;
+		}
+
+		inline WorklistStrategy GetWorklistStrategy() const
+		{
+			return worklistStrategy_;
+		}
+
+
+		/**
+		 * @brief  Sets pruning of products
+		 *
+		 * Sets whether useless states are removed from the automaton returned by
+		 * Intersection() right after the product is constructed.
+		 *
+		 * @param[in]  isPruning  @p true if products are to be pruned
+		 */
+		inline void SetPruningProducts(bool isPruning)
+		{
+			isPruningProducts_ = isPruning;
+		}
+
+		inline bool IsPruningProducts() const
+		{
+			return isPruningProducts_;
+		}
+
+
+		/**
+		 * @brief  Returns the number of processed pairs
+		 *
+		 * Returns the number of pairs processed by the last call of
+		 * CheckLanguageInclusion().
+		 *
+		 * @returns  The number of processed pairs
+		 */
+		inline size_t GetNumberOfProcessedPairs() const
+		{
+			return processedPairs_;
+		}
+
+
+		/**
+		 * @brief  Returns the witness of non-inclusion
+		 *
+		 * Returns a tree that is accepted by the smaller automaton and not by
+		 * the bigger automaton of the last call of CheckLanguageInclusion(). The
+		 * tree is empty if the inclusion holds or if the witness is not
+		 * available.
+		 *
+		 * @returns  The witness tree
+		 */
+		inline const WitnessTreeType& GetWitness() const
+		{
+			return witness_;
+		}
+
 
 		/**
 		 * @brief  Union of two automata
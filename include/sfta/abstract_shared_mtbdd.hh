@@ -14,6 +14,7 @@
 
 // Standard library headers
 #include <string>
+#include <vector>
 
 
 // insert the class into proper namespace
@@ -93,6 +94,30 @@ public:  // Public data types
 	typedef std::map<VariableAssignmentType, LeafType> DescriptionType;
 
 
+	/**
+	 * @brief  The container type for values to be set
+	 *
+	 * The type that serves as a container of pairs of variable assignments and
+	 * leaves that are to be set at once. This type is used by the SetValues()
+	 * method.
+	 *
+	 * @see  SetValues()
+	 */
+	typedef std::vector<std::pair<VariableAssignmentType, LeafType> >
+		AssignmentListType;
+
+
+	/**
+	 * @brief  Identifier of a cached operation
+	 *
+	 * The type of identifiers of Apply operations the results of which on
+	 * leaves are cached.
+	 *
+	 * @see  CreateCachedOperation()
+	 */
+	typedef unsigned OperationIdType;
+
+
 	/**
 	 * @brief  The base class for functors that perform @c Apply operations
 	 *
@@ -295,6 +320,26 @@ public:  // Public methods
 		const VariableAssignmentType& asgn, const LeafType& value) = 0;
 
 
+	/**
+	 * @brief  Sets the values of several leaves
+	 *
+	 * This function sets the values of several leaves of the MTBDD given by
+	 * its root at once. The result is the same as if SetValue() was called
+	 * for each pair of the container in its order, but the implementation may
+	 * take advantage of knowing all values in advance, e.g. to build the
+	 * MTBDD in a single pass.
+	 *
+	 * @see  SetValue()
+	 *
+	 * @param[in]  root    The root of the MTBDD in which the method works
+	 * @param[in]  values  The container of pairs of positions of leaves given
+	 *                     by the assignment to Boolean variables of the MTBDD
+	 *                     and values of the leaves to be set
+	 */
+	virtual void SetValues(const RootType& root,
+		const AssignmentListType& values) = 0;
+
+
 	/**
 	 * @brief  Gets references to leaves
 	 *
@@ -370,6 +415,184 @@ public:  // Public methods
 		AbstractMonadicApplyFunctorType* func) = 0;
 
 
+	/**
+	 * @brief  Creates a new cached operation
+	 *
+	 * Creates a new identifier of an Apply operation the results of which on
+	 * leaves are cached. When the identifier is passed to Apply(),
+	 * TernaryApply() or MonadicApply(), the functor is called only once for
+	 * every tuple of leaves and the cached result is used afterwards. The
+	 * operation needs to be erased by EraseCachedOperation() when it is no
+	 * longer needed.
+	 *
+	 * @see  InvalidateCachedOperation()
+	 * @see  EraseCachedOperation()
+	 *
+	 * @returns  Identifier of the new operation
+	 */
+	virtual OperationIdType CreateCachedOperation() = 0;
+
+
+	/**
+	 * @brief  Invalidates cached results of an operation
+	 *
+	 * Removes all cached results of given operation. A functor with a state
+	 * needs to invalidate the results each time its state changes in a way
+	 * that alters its results.
+	 *
+	 * @param[in]  op  Identifier of the operation
+	 */
+	virtual void InvalidateCachedOperation(const OperationIdType& op) = 0;
+
+
+	/**
+	 * @brief  Erases a cached operation
+	 *
+	 * Releases all resources of given cached operation. The identifier cannot
+	 * be used afterwards.
+	 *
+	 * @param[in]  op  Identifier of the operation
+	 */
+	virtual void EraseCachedOperation(const OperationIdType& op) = 0;
+
+
+	/**
+	 * @brief  Cached Apply function for two MTBDDs
+	 *
+	 * Performs given Apply operation on two MTBDDs the same way as Apply()
+	 * but the results of the functor are cached under given operation.
+	 *
+	 * @see  CreateCachedOperation()
+	 *
+	 * @param[in]  lhs   Left-hand side MTBDD
+	 * @param[in]  rhs   Right-hand side MTBDD
+	 * @param[in]  func  The operation to be performed on respective leaves of
+	 *                   given MTBDDs
+	 * @param[in]  op    Identifier of the cached operation
+	 *
+	 * @returns  Root of the MTBDD with the result of the operation
+	 */
+	virtual RootType Apply(const RootType& lhs, const RootType& rhs,
+		AbstractApplyFunctorType* func, const OperationIdType& op) = 0;
+
+
+	/**
+	 * @brief  Cached ternary Apply function for three MTBDDs
+	 *
+	 * Performs given ternary Apply operation on three MTBDDs the same way as
+	 * TernaryApply() but the results of the functor are cached under given
+	 * operation.
+	 *
+	 * @see  CreateCachedOperation()
+	 *
+	 * @param[in]  lhs   Left-hand side MTBDD
+	 * @param[in]  mhs   Middle-hand side MTBDD
+	 * @param[in]  rhs   Right-hand side MTBDD
+	 * @param[in]  func  The operation to be performed on respective leaves of
+	 *                   given MTBDDs
+	 * @param[in]  op    Identifier of the cached operation
+	 *
+	 * @returns  Root of the MTBDD with the result of the operation
+	 */
+	virtual RootType TernaryApply(const RootType& lhs, const RootType& mhs,
+		const RootType& rhs, AbstractTernaryApplyFunctorType* func,
+		const OperationIdType& op) = 0;
+
+
+	/**
+	 * @brief  Cached monadic Apply function for an MTBDD
+	 *
+	 * Performs given monadic Apply operation on an MTBDD the same way as
+	 * MonadicApply() but the results of the functor are cached under given
+	 * operation.
+	 *
+	 * @see  CreateCachedOperation()
+	 *
+	 * @param[in]  root  Root of the MTBDD
+	 * @param[in]  func  The operation to be performed on all leaves of
+	 *                   given MTBDD
+	 * @param[in]  op    Identifier of the cached operation
+	 *
+	 * @returns  Root of the MTBDD with the result of the operation
+	 */
+	virtual RootType MonadicApply(const RootType& root,
+		AbstractMonadicApplyFunctorType* func, const OperationIdType& op) = 0;
+
+
+	/**
+	 * @brief  Gets the number of hits of cached operations
+	 *
+	 * Returns the number of times the result of a cached operation was found
+	 * in the cache.
+	 *
+	 * @returns  The number of cache hits
+	 */
+	virtual size_t GetCacheHits() const = 0;
+
+
+	/**
+	 * @brief  Gets the number of misses of cached operations
+	 *
+	 * Returns the number of times the result of a cached operation needed to
+	 * be computed by its functor.
+	 *
+	 * @returns  The number of cache misses
+	 */
+	virtual size_t GetCacheMisses() const = 0;
+
+
+	/**
+	 * @brief  Gets the peak number of nodes
+	 *
+	 * Returns the peak number of MTBDD nodes that were allocated at the same
+	 * time.
+	 *
+	 * @returns  The peak number of nodes
+	 */
+	virtual unsigned long GetPeakNodeCount() const = 0;
+
+
+	/**
+	 * @brief  Gets the hit rate of the computed table
+	 *
+	 * Returns the ratio of successful lookups into the computed table of the
+	 * MTBDD package to all lookups.
+	 *
+	 * @returns  The hit rate of the computed table (between 0 and 1)
+	 */
+	virtual double GetComputedTableHitRate() const = 0;
+
+
+	/**
+	 * @brief  Gets the number of live nodes
+	 *
+	 * Returns the number of MTBDD nodes that are currently referenced.
+	 *
+	 * @returns  The number of live nodes
+	 */
+	virtual unsigned long GetNodeCount() const = 0;
+
+
+	/**
+	 * @brief  Enables or disables dynamic reordering
+	 *
+	 * Enables or disables dynamic reordering of variables, which is carried
+	 * out automatically during operations when the MTBDDs grow too much.
+	 *
+	 * @param[in]  enable  Should dynamic reordering be enabled?
+	 */
+	virtual void SetDynamicReordering(bool enable) = 0;
+
+
+	/**
+	 * @brief  Reorders variables
+	 *
+	 * Immediately reorders variables of all MTBDDs in order to decrease the
+	 * number of their nodes. The semantics of the MTBDDs does not change.
+	 */
+	virtual void ReorderVariables() = 0;
+
+
 	/**
 	 * @brief  Creates a new root of a MTBDD
 	 *
@@ -381,16 +604,43 @@ public:  // Public methods
 	virtual RootType CreateRoot() = 0;
 
 
+	/**
+	 * @brief  Adds an owner of a root
+	 *
+	 * Increments the reference count of given root, so that it needs to be
+	 * erased one more time before its MTBDD is dereferenced. Used when the
+	 * root is shared, e.g. by several automata.
+	 *
+	 * @param[in]  root  The root of the MTBDD to be referenced
+	 */
+	virtual void ReferenceRoot(const RootType& root) = 0;
+
+
 	/**
 	 * @brief  Erases a root
 	 *
-	 * Erases given root and dereferences proper MTBDD
+	 * Drops a reference to given root. In case it was the last one, erases
+	 * the root and dereferences proper MTBDD.
 	 *
 	 * @param[in]  root  The root of the MTBDD to be erased
 	 */
 	virtual void EraseRoot(const RootType& root) = 0;
 
 
+	/**
+	 * @brief  Releases roots of temporary MTBDDs
+	 *
+	 * Erases all given roots at once and dereferences their MTBDDs. Unlike
+	 * EraseRoot(), leaves of the MTBDDs are left to the leaf allocator, which
+	 * makes the method suitable for intermediate results of operations.
+	 *
+	 * @see  EraseRoot()
+	 *
+	 * @param[in]  roots  The roots of the MTBDDs to be released
+	 */
+	virtual void ReleaseRoots(const std::vector<RootType>& roots) = 0;
+
+
 	/**
 	 * @brief  Sets the value of the bottom
 	 *
@@ -467,6 +717,20 @@ public:  // Public methods
 	virtual DescriptionType GetMinimumDescription(const RootType& root) const = 0;
 
 
+	/**
+	 * @brief  Restricts all MTBDDs to a zero variable
+	 *
+	 * Changes all MTBDDs so that assignments in which given variable is 1 are
+	 * mapped to the bottom value. Assignments in which the variable is 0 keep
+	 * their values. This is used when a new variable is added to an encoding
+	 * of symbols: the symbols that were encoded before have the value 0 of
+	 * the variable.
+	 *
+	 * @param[in]  var  The variable
+	 */
+	virtual void RestrictVariableToZero(const VariableType& var) = 0;
+
+
 	/**
 	 * @brief  Destructor
 	 *
@@ -48,6 +48,29 @@ public:
 
 	virtual void Build(std::istream& is, TreeAutomatonType* automaton) const = 0;
 
+
+	/**
+	 * @brief  Builds the automaton using a batch of transitions
+	 *
+	 * Builds the automaton from given input stream in the same way as
+	 * Build(), but all transitions are collected and inserted into the
+	 * automaton at once after the whole input has been read. The automaton
+	 * type needs to provide BeginTransitionBatch() and
+	 * CommitTransitionBatch() methods.
+	 *
+	 * @param[in]  is         The input stream
+	 * @param[in]  automaton  The automaton to be built
+	 */
+	void BuildInBatch(std::istream& is, TreeAutomatonType* automaton) const
+	{
+		// Assertions
+		assert(automaton != static_cast<TreeAutomatonType*>(0));
+
+		automaton->BeginTransitionBatch();
+		Build(is, automaton);
+		automaton->CommitTransitionBatch();
+	}
+
 	virtual ~AbstractTABuilder()
 	{ }
 };
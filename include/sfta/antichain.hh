@@ -0,0 +1,401 @@
+/*****************************************************************************
+ *  Symbolic Finite Tree Automata Library
+ *
+ *  Copyright (c) 2010  Ondra Lengal <ondra@lengal.net>
+ *
+ *  Description:
+ *    Header file with Antichain class that indexes sets of states by states
+ *    and answers subset and superset queries.
+ *
+ *****************************************************************************/
+
+#ifndef _SFTA_ANTICHAIN_HH_
+#define _SFTA_ANTICHAIN_HH_
+
+// Standard library headers
+#include <algorithm>
+#include <climits>
+#include <list>
+#include <ostream>
+#include <tr1/unordered_map>
+#include <vector>
+
+// SFTA headers
+#include <sfta/convert.hh>
+
+
+// insert the class into proper namespace
+namespace SFTA
+{
+	namespace Private
+	{
+		template
+		<
+			typename State,
+			class StateSet
+		>
+		class Antichain;
+	}
+}
+
+
+/**
+ * @brief   Antichain of sets of states
+ * @author  Ondra Lengal <ondra@lengal.net>
+ * @date    2010
+ *
+ * The class stores for each state a list of sets of states and answers the
+ * queries whether there is a subset or a superset of given set in the list.
+ * Every set carries a signature, which is a word with the bit of each state
+ * (modulo the width of the word) set. A set can only be a subset of another
+ * set if its signature is a subset of the signature of the other set, so most
+ * of the elements of the list are rejected by a single word operation and
+ * only the remaining ones are compared state by state.
+ *
+ * Sets passed to the methods of the class need to be sorted containers of
+ * states.
+ *
+ * @tparam  State     The type of states.
+ * @tparam  StateSet  The type of sorted sets of states.
+ */
+template
+<
+	typename State,
+	class StateSet
+>
+class SFTA::Private::Antichain
+{
+public:   // Public data types
+
+	typedef State StateType;
+	typedef StateSet StateSetType;
+
+	typedef unsigned long SignatureType;
+
+
+	/**
+	 * @brief  Element of the antichain
+	 *
+	 * A set of states together with a number that identifies the element and
+	 * the signature of the set.
+	 */
+	struct Element
+	{
+		size_t number;
+		StateSetType states;
+		SignatureType signature;
+
+		Element(size_t num, const StateSetType& sts, const SignatureType& sig)
+			: number(num),
+				states(sts),
+				signature(sig)
+		{ }
+
+		friend std::ostream& operator<<(std::ostream& os, const Element& elem)
+		{
+			return os << "(" << elem.number << ", " << elem.states << ")";
+		}
+	};
+
+	typedef std::list<Element> ElementListType;
+
+private:  // Private data types
+
+	typedef std::tr1::unordered_map<StateType, ElementListType> ListTableType;
+
+private:  // Private data members
+
+	/**
+	 * The number of bits of a signature.
+	 */
+	static const size_t SIGNATURE_BITS = sizeof(SignatureType) * CHAR_BIT;
+
+
+	/**
+	 * @brief  Lists of sets
+	 *
+	 * The table that maps each state to the list of its sets.
+	 */
+	ListTableType lists_;
+
+private:  // Private methods
+
+	template <class T>
+	static SignatureType computeSignature(const T& states)
+	{
+		SignatureType signature = 0;
+		for (typename T::const_iterator itStates = states.begin();
+			itStates != states.end(); ++itStates)
+		{	// set the bit of each state
+			signature |= static_cast<SignatureType>(1) <<
+				(static_cast<size_t>(*itStates) % SIGNATURE_BITS);
+		}
+
+		return signature;
+	}
+
+	template <class T, class U>
+	static inline bool isSubset(const T& lhs, const SignatureType& lhsSignature,
+		const U& rhs, const SignatureType& rhsSignature)
+	{
+		return ((lhsSignature & ~rhsSignature) == 0) && (lhs.size() <= rhs.size())
+			&& std::includes(rhs.begin(), rhs.end(), lhs.begin(), lhs.end());
+	}
+
+	const ElementListType* findList(const StateType& state) const
+	{
+		typename ListTableType::const_iterator itLists;
+		if ((itLists = lists_.find(state)) == lists_.end())
+		{	// in case there is no list for the state
+			return static_cast<const ElementListType*>(0);
+		}
+
+		return &(itLists->second);
+	}
+
+public:   // Public methods
+
+	Antichain()
+		: lists_()
+	{ }
+
+
+	/**
+	 * @brief  Returns elements of a state
+	 *
+	 * Returns the list of elements for given state.
+	 *
+	 * @param[in]  state  The state
+	 *
+	 * @returns  The list of elements, or null pointer if there is none
+	 */
+	inline const ElementListType* GetElements(const StateType& state) const
+	{
+		return findList(state);
+	}
+
+
+	/**
+	 * @brief  Checks for a subset
+	 *
+	 * Checks whether there is a subset of given set among the sets of given
+	 * state.
+	 *
+	 * @param[in]  state   The state
+	 * @param[in]  states  The set of states
+	 *
+	 * @returns  @p true if there is a subset of @p states, @p false otherwise
+	 */
+	template <class T>
+	bool ContainsSubsetOf(const StateType& state, const T& states) const
+	{
+		const ElementListType* elements = findList(state);
+		if (elements == static_cast<const ElementListType*>(0))
+		{	// in case there are no sets for the state
+			return false;
+		}
+
+		SignatureType signature = computeSignature(states);
+		for (typename ElementListType::const_iterator itElements = elements->begin();
+			itElements != elements->end(); ++itElements)
+		{	// try to find a subset
+			if (isSubset(itElements->states, itElements->signature, states, signature))
+			{
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+
+	/**
+	 * @brief  Checks for a superset
+	 *
+	 * Checks whether there is a superset of given set among the sets of given
+	 * state.
+	 *
+	 * @param[in]  state   The state
+	 * @param[in]  states  The set of states
+	 *
+	 * @returns  @p true if there is a superset of @p states, @p false otherwise
+	 */
+	template <class T>
+	inline bool ContainsSupersetOf(const StateType& state, const T& states) const
+	{
+		return FindSupersetOf(state, states) != static_cast<const Element*>(0);
+	}
+
+
+	/**
+	 * @brief  Finds a superset
+	 *
+	 * Finds an element with a superset of given set among the elements of
+	 * given state.
+	 *
+	 * @param[in]  state   The state
+	 * @param[in]  states  The set of states
+	 *
+	 * @returns  The element with a superset of @p states, or null pointer if
+	 *           there is none
+	 */
+	template <class T>
+	const Element* FindSupersetOf(const StateType& state, const T& states) const
+	{
+		const ElementListType* elements = findList(state);
+		if (elements == static_cast<const ElementListType*>(0))
+		{	// in case there are no sets for the state
+			return static_cast<const Element*>(0);
+		}
+
+		SignatureType signature = computeSignature(states);
+		for (typename ElementListType::const_iterator itElements = elements->begin();
+			itElements != elements->end(); ++itElements)
+		{	// try to find a superset
+			if (isSubset(states, signature, itElements->states, itElements->signature))
+			{
+				return &(*itElements);
+			}
+		}
+
+		return static_cast<const Element*>(0);
+	}
+
+
+	/**
+	 * @brief  Inserts a set
+	 *
+	 * Inserts given set among the sets of given state without checking for
+	 * subsumption.
+	 *
+	 * @param[in]  state   The state
+	 * @param[in]  number  The number identifying the element
+	 * @param[in]  states  The set of states
+	 */
+	inline void Insert(const StateType& state, size_t number,
+		const StateSetType& states)
+	{
+		lists_[state].push_back(Element(number, states, computeSignature(states)));
+	}
+
+
+	/**
+	 * @brief  Erases supersets
+	 *
+	 * Erases all supersets of given set from the sets of given state.
+	 *
+	 * @param[in]   state    The state
+	 * @param[in]   states   The set of states
+	 * @param[out]  numbers  Container the numbers of erased elements are
+	 *                       appended to
+	 */
+	template <class T>
+	void EraseSupersetsOf(const StateType& state, const T& states,
+		std::vector<size_t>& numbers)
+	{
+		typename ListTableType::iterator itLists;
+		if ((itLists = lists_.find(state)) == lists_.end())
+		{	// in case there are no sets for the state
+			return;
+		}
+
+		SignatureType signature = computeSignature(states);
+		ElementListType& elements = itLists->second;
+		typename ElementListType::iterator itElements = elements.begin();
+		while (itElements != elements.end())
+		{	// remove all supersets
+			if (isSubset(states, signature, itElements->states, itElements->signature))
+			{	// in case the element is a superset
+				numbers.push_back(itElements->number);
+				itElements = elements.erase(itElements);
+			}
+			else
+			{
+				++itElements;
+			}
+		}
+	}
+
+
+	/**
+	 * @brief  Erases subsets
+	 *
+	 * Erases all subsets of given set from the sets of given state.
+	 *
+	 * @param[in]  state   The state
+	 * @param[in]  states  The set of states
+	 */
+	template <class T>
+	void EraseSubsetsOf(const StateType& state, const T& states)
+	{
+		typename ListTableType::iterator itLists;
+		if ((itLists = lists_.find(state)) == lists_.end())
+		{	// in case there are no sets for the state
+			return;
+		}
+
+		SignatureType signature = computeSignature(states);
+		ElementListType& elements = itLists->second;
+		typename ElementListType::iterator itElements = elements.begin();
+		while (itElements != elements.end())
+		{	// remove all subsets
+			if (isSubset(itElements->states, itElements->signature, states, signature))
+			{	// in case the element is a subset
+				itElements = elements.erase(itElements);
+			}
+			else
+			{
+				++itElements;
+			}
+		}
+	}
+
+
+	/**
+	 * @brief  Erases a set
+	 *
+	 * Erases one occurrence of given set from the sets of given state.
+	 *
+	 * @param[in]  state   The state
+	 * @param[in]  states  The set of states
+	 *
+	 * @returns  @p true if the set was found, @p false otherwise
+	 */
+	bool Erase(const StateType& state, const StateSetType& states)
+	{
+		typename ListTableType::iterator itLists;
+		if ((itLists = lists_.find(state)) == lists_.end())
+		{	// in case there are no sets for the state
+			return false;
+		}
+
+		ElementListType& elements = itLists->second;
+		for (typename ElementListType::iterator itElements = elements.begin();
+			itElements != elements.end(); ++itElements)
+		{	// find the set
+			if (itElements->states == states)
+			{
+				elements.erase(itElements);
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+
+	friend std::ostream& operator<<(std::ostream& os, const Antichain& antichain)
+	{
+		os << "{";
+		for (typename ListTableType::const_iterator itLists =
+			antichain.lists_.begin(); itLists != antichain.lists_.end(); ++itLists)
+		{	// print the list of each state
+			os << " " << itLists->first << " -> "
+				<< Convert::ToString(itLists->second);
+		}
+
+		return os << " }";
+	}
+};
+
+#endif
@@ -57,6 +57,24 @@ public:   // public methods
 		return nextState_++;
 	}
 
+
+	/**
+	 * @brief  Reserves a state
+	 *
+	 * Makes sure that CreateState() never returns given state, e.g. because
+	 * the state has been copied from an automaton with a different wrapper.
+	 *
+	 * @param[in]  state  The state that is already used
+	 */
+	void ReserveState(const StateType& state)
+	{
+		if (!(state < nextState_))
+		{	// in case the state could be created later
+			nextState_ = state;
+			++nextState_;
+		}
+	}
+
 	virtual ~BaseTransitionTableWrapper()
 	{ }
 };
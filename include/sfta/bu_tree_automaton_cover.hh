@@ -26,6 +26,7 @@
 #include <sfta/set.hh>
 #include <sfta/symbol_dictionary.hh>
 #include <sfta/vector.hh>
+#include <sfta/worklist.hh>
 
 
 // Loki header files
@@ -165,10 +166,61 @@ private:  // Private data types
 	typedef typename NDSymbolicBUTreeAutomaton::TransitionType
 		InternalTransitionType;
 
+	typedef std::map<SymbolType, InternalRightHandSideType>
+		SymbolToInternalRightHandSideMap;
+
+	typedef std::map<InternalLeftHandSideType, SymbolToInternalRightHandSideMap>
+		PendingTransitionMap;
+
+	typedef NDSymbolicBUTreeAutomaton::TreeType InternalTreeType;
+
+	typedef typename NDSymbolicBUTreeAutomaton::NDSymbolicTDTreeAutomatonType
+		NDSymbolicTDTreeAutomaton;
+
+	typedef typename NDSymbolicBUTreeAutomaton::HierarchyRoot::Operation::
+		SimulationRelationType InternalSimulationType;
+
+
+	/**
+	 * @brief  Translator of symbols of witness trees
+	 *
+	 * Translates an internal symbol of a witness tree to the name of the
+	 * symbol.
+	 */
+	class WitnessSymbolTranslator
+	{
+	private:  // Private data members
+
+		const BUTreeAutomatonCover* aut_;
+
+	public:   // Public methods
+
+		explicit WitnessSymbolTranslator(const BUTreeAutomatonCover* aut)
+			: aut_(aut)
+		{ }
+
+		std::string operator()(const InternalSymbolType& symbol) const
+		{
+			// any of the symbols will do, they have the same transitions
+			std::vector<SymbolType> symbols = aut_->translateInternalSymbolToSymbols(symbol);
+			if (symbols.empty())
+			{
+				throw std::runtime_error(__func__ +
+					std::string(": no symbol for ") + Convert::ToString(symbol));
+			}
+
+			return symbols.front();
+		}
+	};
+
 public:   // Public data types
 
 	typedef typename NDSymbolicBUTreeAutomaton::TTWrapperPtrType TTWrapperPtr;
 
+	typedef typename NDSymbolicBUTreeAutomaton::MTBDDTTWrapperType TTWrapperType;
+
+	typedef typename TTWrapperType::ConfigurationType ManagerConfigurationType;
+
 	typedef std::multimap<StateType, StateType> SimulationRelationType;
 
 	typedef SFTA::SymbolDictionary
@@ -179,6 +231,8 @@ public:   // Public data types
 
 	typedef Loki::SmartPtr<SymbolDictionaryType> SymbolDictionaryPtrType;
 
+	typedef NDSymbolicBUTreeAutomaton::ReductionStatistics ReductionStatisticsType;
+
 	/**
 	 * @brief  Class with operations
 	 *
@@ -187,8 +241,146 @@ public:   // Public data types
 	 */
 	class Operation
 	{
+	public:   // Public data types
+
+		/**
+		 * @brief  Result of a query of a batch
+		 *
+		 * The result of a single check of language inclusion of a batch of
+		 * checks against the same automaton.
+		 *
+		 * @see  CheckDownwardInclusionInBatch()
+		 */
+		struct BatchQueryResult
+		{
+			bool holds;
+			double time;
+			size_t processedPairs;
+			std::string witness;
+
+			BatchQueryResult()
+				: holds(false),
+					time(0.0),
+					processedPairs(0),
+					witness()
+			{ }
+		};
+
+	private:  // Private data members
+
+		WorklistStrategy worklistStrategy_;
+
+		bool isPruningProducts_;
+
+		bool isSimulationByCounters_;
+
+		mutable size_t processedPairs_;
+
+		mutable std::string witness_;
+
+	private:  // Private methods
+
+		template <class InternalOperation, class InternalAutomaton, class InternalSimulation>
+		bool checkLanguageInclusion(InternalOperation* oper, const Type* aut,
+			const InternalAutomaton* lhs, const InternalAutomaton* rhs,
+			const InternalSimulation* lhsSim, const InternalSimulation* rhsSim) const
+		{
+			// Assertions
+			assert(oper != static_cast<InternalOperation*>(0));
+			assert(aut != static_cast<Type*>(0));
+
+			oper->SetWorklistStrategy(worklistStrategy_);
+			bool result = oper->CheckLanguageInclusion(lhs, rhs, lhsSim, rhsSim);
+			processedPairs_ = oper->GetNumberOfProcessedPairs();
+			witness_ = oper->GetWitness().ToString(WitnessSymbolTranslator(aut));
+
+			return result;
+		}
+
 	public:   // Public methods
 
+		Operation()
+			: worklistStrategy_(WORKLIST_BFS),
+				isPruningProducts_(false),
+				isSimulationByCounters_(false),
+				processedPairs_(0),
+				witness_()
+		{ }
+
+
+		/**
+		 * @brief  Sets the worklist strategy
+		 *
+		 * Sets the order in which pairs are explored by the checks of language
+		 * inclusion.
+		 *
+		 * @param[in]  strategy  The strategy
+		 */
+		inline void SetWorklistStrategy(WorklistStrategy strategy)
+		{
+			worklistStrategy_ = strategy;
+		}
+
+
+		/**
+		 * @brief  Sets pruning of products
+		 *
+		 * Sets whether useless states are removed from the result of
+		 * Intersection().
+		 *
+		 * @param[in]  isPruning  @p true if products are to be pruned
+		 */
+		inline void SetPruningProducts(bool isPruning)
+		{
+			isPruningProducts_ = isPruning;
+		}
+
+
+		/**
+		 * @brief  Sets the algorithm of ComputeSimulationPreorder()
+		 *
+		 * Sets whether ComputeSimulationPreorder() uses the original algorithm
+		 * with counters in MTBDDs instead of partition refinement, so that the
+		 * results of the two algorithms can be compared.
+		 *
+		 * @param[in]  isByCounters  @p true if the original algorithm is to be
+		 *                           used
+		 */
+		inline void SetSimulationByCounters(bool isByCounters)
+		{
+			isSimulationByCounters_ = isByCounters;
+		}
+
+
+		/**
+		 * @brief  Returns the number of processed pairs
+		 *
+		 * Returns the number of pairs processed by the last check of language
+		 * inclusion.
+		 *
+		 * @returns  The number of processed pairs
+		 */
+		inline size_t GetNumberOfProcessedPairs() const
+		{
+			return processedPairs_;
+		}
+
+
+		/**
+		 * @brief  Returns the witness of non-inclusion
+		 *
+		 * Returns a tree that is accepted by the smaller automaton and not by the
+		 * bigger automaton of the last check of language inclusion, so that it
+		 * need not be searched for again.
+		 *
+		 * @returns  The tree as a term in the syntax of Timbuk, or an empty
+		 *           string if the inclusion holds
+		 */
+		inline const std::string& GetWitness() const
+		{
+			return witness_;
+		}
+
 		Type* Union(Type* lhs, Type* rhs) const;
 
 		Type* Intersection(Type* lhs, Type* rhs) const;
@@ -210,6 +402,44 @@ public:   // Public data types
 
 		bool DoesLanguageInclusionHoldDownwardsWithoutSim(const Type* lhs,
 			const Type* rhs, timespec* start) const;
+
+
+		/**
+		 * @brief  Prepares an automaton for a batch of checks of inclusion
+		 *
+		 * Computes the top-down automaton and the simulation preorder of the
+		 * bigger automaton of a batch of checks of downward language inclusion
+		 * ahead of the checks. The automaton keeps them until it is modified,
+		 * so that they are computed only once for the whole batch.
+		 *
+		 * @param[in]  rhs  The bigger automaton of the batch
+		 *
+		 * @returns  The time spent (in seconds of CPU time of the thread)
+		 *
+		 * @see  CheckDownwardInclusionInBatch()
+		 */
+		double PrepareDownwardInclusionBatch(const Type* rhs) const;
+
+
+		/**
+		 * @brief  Checks downward language inclusion within a batch
+		 *
+		 * Checks whether the language of @p lhs is a subset of the language of
+		 * @p rhs, which is supposed to have been prepared by
+		 * PrepareDownwardInclusionBatch(). Both automata need to share the
+		 * MTBDD wrapper and the symbol dictionary, e.g. by being constructed by
+		 * the same TABuildingDirector, so that the smaller automata can be
+		 * loaded one by one and released after their query.
+		 *
+		 * @param[in]  lhs  The smaller automaton
+		 * @param[in]  rhs  The bigger automaton
+		 *
+		 * @returns  The result of the query together with the time spent on
+		 *           it (including the conversion and simulation of @p lhs),
+		 *           the number of processed pairs and the witness
+		 */
+		BatchQueryResult CheckDownwardInclusionInBatch(const Type* lhs,
+			const Type* rhs) const;
 	};
 
 
@@ -223,9 +453,33 @@ private:  // Private data members
 
 	SymbolDictionaryPtrType symbolDict_;
 
-	size_t bddSize_;
+	bool isBatchOpen_;
 
-	InternalSymbolType nextSymbol_;
+	PendingTransitionMap pendingTransitions_;
+
+	/**
+	 * @brief  Cached top-down automaton
+	 *
+	 * The top-down automaton of the automaton, computed on the first demand
+	 * and dropped whenever the automaton is modified.
+	 *
+	 * @see  getTopDownAutomaton()
+	 */
+	mutable std::auto_ptr<NDSymbolicTDTreeAutomaton> topDownCache_;
+
+	/**
+	 * @brief  Cached simulation preorder
+	 *
+	 * @see  getSimulation()
+	 */
+	mutable std::auto_ptr<InternalSimulationType> simulationCache_;
+
+	/**
+	 * @brief  Cached identity relation
+	 *
+	 * @see  getIdentityRelation()
+	 */
+	mutable std::auto_ptr<InternalSimulationType> identityCache_;
 
 private:  // Private methods
 
@@ -237,6 +491,8 @@ private:  // Private methods
 	StateType translateInternalStateToState(
 		const InternalDualStateType& internalState) const;
 
+	InternalSymbolType translateSymbol(const SymbolType& symbol);
+
 	std::vector<SymbolType> translateInternalSymbolToSymbols(
 		const InternalSymbolType& internalSymbol) const;
 
@@ -246,48 +502,169 @@ private:  // Private methods
 
 	static std::string symbolsToString(const std::vector<SymbolType>& vec);
 
+	size_t parseTerm(const std::string& term, size_t& pos,
+		InternalTreeType& tree, bool& areSymbolsKnown) const;
+
+	void forgetRemovedStates();
+
+
+	/**
+	 * @brief  Returns the top-down automaton
+	 *
+	 * Returns the top-down automaton with the same language as the automaton.
+	 * The top-down automaton is computed on the first call and kept until the
+	 * automaton is modified, so that repeated checks of language inclusion
+	 * against the same automaton do not convert it again.
+	 *
+	 * @returns  The top-down automaton (owned by the cover)
+	 */
+	const NDSymbolicTDTreeAutomaton* getTopDownAutomaton() const;
+
+
+	/**
+	 * @brief  Returns the simulation preorder
+	 *
+	 * Returns the simulation preorder of the automaton, computed on the first
+	 * call and kept until the automaton is modified.
+	 *
+	 * @returns  The simulation preorder (owned by the cover)
+	 */
+	const InternalSimulationType* getSimulation() const;
+
+
+	/**
+	 * @brief  Returns the identity relation
+	 *
+	 * Returns the identity relation on states of the automaton, computed on
+	 * the first call and kept until the automaton is modified.
+	 *
+	 * @returns  The identity relation (owned by the cover)
+	 */
+	const InternalSimulationType* getIdentityRelation() const;
+
+
+	/**
+	 * @brief  Drops cached data
+	 *
+	 * Drops the cached top-down automaton and relations. Needs to be called
+	 * by every method that modifies the automaton.
+	 */
+	void invalidateCache();
+
 
 public:   // Public methods
 
-	explicit BUTreeAutomatonCover(size_t bddSize)
+	BUTreeAutomatonCover()
 		: automaton_(new NDSymbolicBUTreeAutomaton()),
 			state2internalStateMap_(),
 			areStatesFromOutside_(true),
 			symbolDict_(),
-			bddSize_(bddSize),
-			nextSymbol_(bddSize, 0)
+			isBatchOpen_(false),
+			pendingTransitions_(),
+			topDownCache_(),
+			simulationCache_(),
+			identityCache_()
 	{ }
 
-	BUTreeAutomatonCover(size_t bddSize, TTWrapperPtr wrapper, SymbolDictionaryPtrType symbolDict)
+	explicit BUTreeAutomatonCover(const ManagerConfigurationType& config)
+		: automaton_(new NDSymbolicBUTreeAutomaton(TTWrapperPtr(new TTWrapperType(config)))),
+			state2internalStateMap_(),
+			areStatesFromOutside_(true),
+			symbolDict_(),
+			isBatchOpen_(false),
+			pendingTransitions_(),
+			topDownCache_(),
+			simulationCache_(),
+			identityCache_()
+	{ }
+
+	BUTreeAutomatonCover(TTWrapperPtr wrapper, SymbolDictionaryPtrType symbolDict)
 		: automaton_(new NDSymbolicBUTreeAutomaton(wrapper)),
 			state2internalStateMap_(),
 			areStatesFromOutside_(true),
 			symbolDict_(symbolDict),
-			bddSize_(bddSize),
-			nextSymbol_(bddSize, 0)
+			isBatchOpen_(false),
+			pendingTransitions_(),
+			topDownCache_(),
+			simulationCache_(),
+			identityCache_()
 	{ }
 
-	BUTreeAutomatonCover(size_t bddSize, NDSymbolicBUTreeAutomaton* automaton, SymbolDictionaryPtrType symbolDict)
+	BUTreeAutomatonCover(NDSymbolicBUTreeAutomaton* automaton, SymbolDictionaryPtrType symbolDict)
 		: automaton_(automaton),
 			state2internalStateMap_(),
 			areStatesFromOutside_(false),
 			symbolDict_(symbolDict),
-			bddSize_(bddSize),
-			nextSymbol_(bddSize, 0)
+			isBatchOpen_(false),
+			pendingTransitions_(),
+			topDownCache_(),
+			simulationCache_(),
+			identityCache_()
 	{ }
 
 	void AddState(const StateType& state);
 
 	inline void AddSymbol(const SymbolType& symbol)
 	{
-		symbolDict_->Translate(symbol);
+		translateSymbol(symbol);
 	}
 
 	void AddTransition(const LeftHandSideType& lhs, const SymbolType& symbol,
 		const RightHandSideType& rhs);
 
+
+	/**
+	 * @brief  Starts a batch of transitions
+	 *
+	 * Starts a batch of transitions. Transitions added by AddTransition() are
+	 * not inserted into the automaton immediately but they are collected
+	 * until CommitTransitionBatch() is called. This is much faster when a lot
+	 * of transitions is added, e.g. when the automaton is being loaded.
+	 *
+	 * @see  CommitTransitionBatch()
+	 */
+	void BeginTransitionBatch();
+
+
+	/**
+	 * @brief  Commits a batch of transitions
+	 *
+	 * Inserts all transitions collected since the last call of
+	 * BeginTransitionBatch() into the automaton, building the transition
+	 * function of each left-hand side in a single pass.
+	 *
+	 * @see  BeginTransitionBatch()
+	 */
+	void CommitTransitionBatch();
+
 	void SetStateFinal(const StateType& state);
 
+
+	/**
+	 * @brief  Removes useless states
+	 *
+	 * Removes states of the automaton that do not occur in any accepting run,
+	 * together with their transitions, and forgets their names. Automata that
+	 * share transitions with this one, such as operands of a union, are not
+	 * affected.
+	 *
+	 * @returns  The number of removed states
+	 */
+	size_t RemoveUselessStates();
+
+
+	/**
+	 * @brief  Reduces the automaton using simulation
+	 *
+	 * Computes the simulation preorder of the automaton, merges states that
+	 * simulate each other and removes transitions that are simulated by other
+	 * transitions. Names of merged states are forgotten, the class of a state
+	 * is represented by one of its states.
+	 *
+	 * @returns  The numbers of removed states, transitions and MTBDD nodes
+	 */
+	ReductionStatisticsType ReduceBySimulation();
+
 	inline TTWrapperPtr GetTTWrapper()
 	{
 		return automaton_->GetTTWrapper();
@@ -300,7 +677,7 @@ public:   // Public methods
 
 	inline size_t GetBDDSize() const
 	{
-		return bddSize_;
+		return symbolDict_->GetEncodingWidth();
 	}
 
 	inline SymbolDictionaryPtrType GetSymbolDictionary() const
@@ -308,6 +685,51 @@ public:   // Public methods
 		return symbolDict_;
 	}
 
+
+	/**
+	 * @brief  Copies the automaton to another MTBDD manager
+	 *
+	 * Creates a copy of the automaton that uses given MTBDD wrapper and
+	 * symbol dictionary. The transitions are copied directly between the
+	 * MTBDD managers, without storing the automaton into text. The
+	 * dictionary needs to translate symbols the same way as the dictionary of
+	 * the automaton, e.g. by being its copy. Cached data are not copied.
+	 *
+	 * @param[in]  wrapper     The wrapper of the MTBDD manager of the copy
+	 * @param[in]  symbolDict  The symbol dictionary of the copy
+	 *
+	 * @returns  The copy (owned by the caller)
+	 */
+	Type* CopyToManager(TTWrapperPtr wrapper, SymbolDictionaryPtrType symbolDict) const;
+
 	std::string ToString() const;
+
+
+	/**
+	 * @brief  Checks whether the language is empty
+	 *
+	 * Checks whether the language of the automaton is empty. The check stops
+	 * as soon as a final state is found to be reachable.
+	 *
+	 * @returns  @p true if the language is empty, @p false otherwise
+	 */
+	inline bool IsEmpty() const
+	{
+		return automaton_->IsEmpty();
+	}
+
+
+	/**
+	 * @brief  Checks whether a term is accepted
+	 *
+	 * Checks whether the automaton accepts a tree given by a term in the syntax
+	 * of Timbuk, e.g. @p f(a, g(b)). A term with a symbol that the automaton
+	 * does not know is not accepted.
+	 *
+	 * @param[in]  term  The term
+	 *
+	 * @returns  @p true if the term is accepted, @p false otherwise
+	 */
+	bool Accepts(const std::string& term) const;
 };
 #endif
@@ -208,6 +208,35 @@ public:    // Public data types
 	typedef typename ParentClass::LeafContainer LeafContainer;
 
 
+	/**
+	 * @brief  The container type for values to be set
+	 *
+	 * The type that serves as a container of pairs of variable assignments and
+	 * leaves. This type is used by the SetValues() method.
+	 *
+	 * @see  SetValues()
+	 */
+	typedef typename ParentClass::AssignmentListType AssignmentListType;
+
+
+	/**
+	 * @brief  Identifier of a cached operation
+	 *
+	 * The type of identifiers of cached Apply operations.
+	 *
+	 * @see  CreateCachedOperation()
+	 */
+	typedef typename ParentClass::OperationIdType OperationIdType;
+
+
+	/**
+	 * @brief  Configuration of the MTBDD manager
+	 *
+	 * The type of configuration of the MTBDD manager.
+	 */
+	typedef SFTA::Private::CUDDFacade::ManagerConfiguration ConfigurationType;
+
+
 private:   // Private data types
 
 
@@ -262,6 +291,59 @@ private:   // Private data types
 	typedef std::vector<typename RA::RootType> RootArray;
 
 
+	/**
+	 * @brief  Value waiting to be inserted into an MTBDD
+	 *
+	 * The structure that holds a variable assignment together with the handle
+	 * of the leaf that is to be set for the assignment. It is used by
+	 * SetValues() when building an MTBDD for several values at once.
+	 */
+	struct PendingValue
+	{
+	public:   // Public data members
+
+		/**
+		 * Variable assignment.
+		 */
+		VariableAssignmentType asgn;
+
+		/**
+		 * Handle of the leaf.
+		 */
+		typename LA::HandleType handle;
+
+		/**
+		 * Index of the last variable with non-don't-care value plus one.
+		 */
+		size_t depth;
+
+	public:   // Public methods
+
+		PendingValue(const VariableAssignmentType& inAsgn,
+			const typename LA::HandleType& inHandle, size_t inDepth)
+			: asgn(inAsgn), handle(inHandle), depth(inDepth)
+		{ }
+	};
+
+
+	/**
+	 * @brief  The type for an array of pending values
+	 *
+	 * The type that represents an array of values that are to be inserted into
+	 * an MTBDD.
+	 */
+	typedef std::vector<PendingValue> PendingValueArray;
+
+
+	/**
+	 * @brief  The type for an array of indices
+	 *
+	 * The type that represents an array of indices into an array of pending
+	 * values.
+	 */
+	typedef std::vector<size_t> IndexArray;
+
+
 	/**
 	 * @brief  Generic Apply functor
 	 *
@@ -584,6 +666,67 @@ private:   // Private data types
 	};
 
 
+	/**
+	 * @brief  Leaf transfer functor
+	 *
+	 * Monadic Apply functor that translates a handle of a leaf of one MTBDD
+	 * to the handle of the same leaf in another MTBDD, which is used when
+	 * MTBDDs are copied between the two. The bottom is mapped to the bottom.
+	 */
+	class LeafTransferMonadicApplyFunctor
+		: public CUDDFacade::AbstractMonadicApplyFunctor
+	{
+	private:
+
+		/**
+		 * The MTBDD the leaves are copied from.
+		 */
+		CUDDSharedMTBDD* source_;
+
+		/**
+		 * The MTBDD the leaves are copied to.
+		 */
+		CUDDSharedMTBDD* target_;
+
+	private:
+
+		LeafTransferMonadicApplyFunctor(const LeafTransferMonadicApplyFunctor& func);
+		LeafTransferMonadicApplyFunctor& operator=(
+			const LeafTransferMonadicApplyFunctor& func);
+
+	public:
+
+		LeafTransferMonadicApplyFunctor(CUDDSharedMTBDD* source,
+			CUDDSharedMTBDD* target)
+			: source_(source), target_(target)
+		{
+			// Assertions
+			assert(source != static_cast<CUDDSharedMTBDD*>(0));
+			assert(target != static_cast<CUDDSharedMTBDD*>(0));
+		}
+
+
+		/**
+		 * @brief  The operation
+		 *
+		 * Creates the leaf of given handle in the target MTBDD.
+		 *
+		 * @param[in]  val  The handle in the source MTBDD
+		 *
+		 * @returns  The handle in the target MTBDD
+		 */
+		virtual CUDDFacade::ValueType operator()(const CUDDFacade::ValueType& val)
+		{
+			if (val == LA::BOTTOM)
+			{	// in case the leaf is the bottom
+				return LA::BOTTOM;
+			}
+
+			return target_->LA::createLeaf(source_->LA::getLeafOfHandle(val));
+		}
+	};
+
+
 private:  // Private data members
 
 
@@ -684,8 +827,6 @@ private:  // Private methods
 	CUDDFacade::Node* createMTBDDForVariableAssignment(
 		const VariableAssignmentType& vars, const LeafType& value)
 	{
-		assert(vars.VariablesCount() <= GetMaxSize());
-
 		CUDDFacade::ValueType leaf = LA::createLeaf(value);
 		CUDDFacade::Node* node = cudd_.AddConst(leaf);
 		cudd_.Ref(node);
@@ -709,6 +850,93 @@ private:  // Private methods
 	}
 
 
+	/**
+	 * @brief  Creates a new MTBDD for several variable assignments
+	 *
+	 * Creates a new MTBDD in the shared MTBDD that contains values of given
+	 * pending values restricted to given indices, for the variables from @p
+	 * var on. The MTBDD is built bottom-up in a single pass. In case several
+	 * pending values overlap, the one with the highest index takes
+	 * precedence. Assignments not covered by any of the values are mapped to
+	 * the background.
+	 *
+	 * @param[in]  values   Array of pending values
+	 * @param[in]  indices  Ordered array of indices of values (to @p values)
+	 *                      that are consistent with the current path
+	 * @param[in]  var      Index of the current variable
+	 *
+	 * @returns  The root of the created MTBDD
+	 */
+	CUDDFacade::Node* createMTBDDForVariableAssignments(
+		const PendingValueArray& values, const IndexArray& indices, size_t var)
+	{
+		if (indices.empty())
+		{	// in case there is no value for this subtree
+			CUDDFacade::Node* node = cudd_.ReadBackground();
+			cudd_.Ref(node);
+			return node;
+		}
+
+		const PendingValue& last = values[indices.back()];
+		if (last.depth <= var)
+		{	// in case the last value overwrites the whole subtree
+			CUDDFacade::Node* node = cudd_.AddConst(last.handle);
+			cudd_.Ref(node);
+			return node;
+		}
+
+		IndexArray thenIndices;
+		IndexArray elseIndices;
+		for (typename IndexArray::const_iterator itIndices = indices.begin();
+			itIndices != indices.end(); ++itIndices)
+		{	// split the values according to the value of the current variable
+			const VariableAssignmentType& asgn = values[*itIndices].asgn;
+
+			char val = VariableAssignmentType::DONT_CARE;
+			if (var < asgn.VariablesCount())
+			{	// in case the variable is in the assignment
+				val = asgn.GetIthVariableValue(var);
+			}
+
+			if (val != VariableAssignmentType::ZERO)
+			{
+				thenIndices.push_back(*itIndices);
+			}
+
+			if (val != VariableAssignmentType::ONE)
+			{
+				elseIndices.push_back(*itIndices);
+			}
+		}
+
+		if ((thenIndices.size() == indices.size()) &&
+			(elseIndices.size() == indices.size()))
+		{	// in case the variable is don't care for all values
+			return createMTBDDForVariableAssignments(values, indices, var + 1);
+		}
+
+		CUDDFacade::Node* thenNode =
+			createMTBDDForVariableAssignments(values, thenIndices, var + 1);
+		CUDDFacade::Node* elseNode =
+			createMTBDDForVariableAssignments(values, elseIndices, var + 1);
+
+		if (thenNode == elseNode)
+		{	// in case both children are the same, the node is redundant
+			cudd_.RecursiveDeref(elseNode);
+			return thenNode;
+		}
+
+		CUDDFacade::Node* varNode = getIthVariable(var);
+		CUDDFacade::Node* node = cudd_.Ite(varNode, thenNode, elseNode);
+		cudd_.Ref(node);
+		cudd_.RecursiveDeref(varNode);
+		cudd_.RecursiveDeref(thenNode);
+		cudd_.RecursiveDeref(elseNode);
+
+		return node;
+	}
+
+
 	/**
 	 * @brief  Creates a projection MTBDD for a variable assignment
 	 *
@@ -724,8 +952,6 @@ private:  // Private methods
 	CUDDFacade::Node* createMTBDDForVariableProjection(
 		const VariableAssignmentType& vars)
 	{
-		assert(vars.VariablesCount() <= GetMaxSize());
-
 		CUDDFacade::Node* node = cudd_.AddConst(1);
 		cudd_.Ref(node);
 
@@ -797,13 +1023,17 @@ private:  // Private methods
 	}
 
 
+	/**
+	 * @brief  Gets the number of variables
+	 *
+	 * Returns the number of variables that have been referenced in the shared
+	 * MTBDD, i.e., the index of the highest referenced variable plus one.
+	 *
+	 * @returns  The number of variables
+	 */
 	size_t GetMaxSize() const
 	{
-		// TODO: declare a private field maxSize_ that remembers the maximum
-		// possible size of the MTBDD, i.e., if a new variable is first
-		// referenced, the value is increased, and if a variable is removed (or
-		// renamed), the value is possibly decreased.
-		return 64;
+		return cudd_.GetVarCount();
 	}
 
 public:   // Public methods
@@ -818,6 +1048,18 @@ public:   // Public methods
 	{ }
 
 
+	/**
+	 * @brief  Constructor with configuration of the manager
+	 *
+	 * The constructor of CUDDSharedMTBDD that creates the MTBDD manager with
+	 * given configuration.
+	 *
+	 * @param[in]  config  Configuration of the MTBDD manager
+	 */
+	explicit CUDDSharedMTBDD(const ConfigurationType& config) : cudd_(config)
+	{ }
+
+
 	virtual void SetValue(const RootType& root,
 		const VariableAssignmentType& asgn, const LeafType& value)
 	{
@@ -839,6 +1081,60 @@ public:   // Public methods
 	}
 
 
+	virtual void SetValues(const RootType& root,
+		const AssignmentListType& values)
+	{
+		PendingValueArray pending;
+		pending.reserve(values.size());
+		for (typename AssignmentListType::const_iterator itValues = values.begin();
+			itValues != values.end(); ++itValues)
+		{	// translate all leaves to handles
+			typename LA::HandleType handle = LA::createLeaf(itValues->second);
+			if (handle == LA::BOTTOM)
+			{	// setting the bottom value does not change the MTBDD
+				continue;
+			}
+
+			size_t depth = itValues->first.VariablesCount();
+			while ((depth > 0) && (itValues->first.GetIthVariableValue(depth - 1)
+				== VariableAssignmentType::DONT_CARE))
+			{	// find the last variable that is not don't care
+				--depth;
+			}
+
+			pending.push_back(PendingValue(itValues->first, handle, depth));
+		}
+
+		if (pending.empty())
+		{	// in case there is nothing to be set
+			return;
+		}
+
+		IndexArray indices(pending.size());
+		for (size_t i = 0; i < indices.size(); ++i)
+		{	// all values are consistent with the empty path
+			indices[i] = i;
+		}
+
+		CUDDFacade::Node* mtbddAsgn =
+			createMTBDDForVariableAssignments(pending, indices, 0);
+		CUDDFacade::Node* rootNode = RA::getHandleOfRoot(root);
+
+		OverwriteByRightApplyFunctor overwriter;
+		CUDDFacade::Node* res = cudd_.Apply(rootNode, mtbddAsgn, &overwriter);
+		cudd_.Ref(res);
+
+		// remove the temporary MTBDD
+		cudd_.RecursiveDeref(mtbddAsgn);
+
+		// get rid of the old MTBDD for the function
+		cudd_.RecursiveDeref(rootNode);
+
+		// substitute the new MTBDD for the old one
+		RA::changeHandleOfRoot(root, res);
+	}
+
+
 	virtual LeafContainer GetValue(const RootType& root,
 		const VariableAssignmentType& asgn)
 	{
@@ -991,6 +1287,131 @@ public:   // Public methods
 	}
 
 
+	virtual OperationIdType CreateCachedOperation()
+	{
+		return cudd_.CreateCachedOperation();
+	}
+
+
+	virtual void InvalidateCachedOperation(const OperationIdType& op)
+	{
+		cudd_.InvalidateCachedOperation(op);
+	}
+
+
+	virtual void EraseCachedOperation(const OperationIdType& op)
+	{
+		cudd_.EraseCachedOperation(op);
+	}
+
+
+	virtual RootType Apply(const RootType& lhs, const RootType& rhs,
+		AbstractApplyFunctorType* func, const OperationIdType& op)
+	{
+		// Assertions
+		assert(func
+			!= static_cast<typename ParentClass::AbstractApplyFunctorType*>(0));
+
+		GenericApplyFunctor applier(this, func);
+
+		// carry out the cached Apply operation
+		CUDDFacade::Node* res = cudd_.Apply(RA::getHandleOfRoot(lhs),
+			RA::getHandleOfRoot(rhs), &applier, op);
+
+		cudd_.Ref(res);
+
+		return RA::allocateRoot(res);
+	}
+
+
+	virtual RootType TernaryApply(const RootType& lhs, const RootType& mhs,
+		const RootType& rhs, AbstractTernaryApplyFunctorType* func,
+		const OperationIdType& op)
+	{
+		// Assertions
+		assert(func
+			!= static_cast<typename ParentClass::AbstractTernaryApplyFunctorType*>(0));
+
+		GenericTernaryApplyFunctor applier(this, func);
+
+		// carry out the cached ternary Apply operation
+		CUDDFacade::Node* res = cudd_.TernaryApply(RA::getHandleOfRoot(lhs),
+			RA::getHandleOfRoot(mhs), RA::getHandleOfRoot(rhs), &applier, op);
+
+		cudd_.Ref(res);
+
+		return RA::allocateRoot(res);
+	}
+
+
+	virtual RootType MonadicApply(const RootType& root,
+		AbstractMonadicApplyFunctorType* func, const OperationIdType& op)
+	{
+		// Assertions
+		assert(func
+			!= static_cast<typename ParentClass::AbstractMonadicApplyFunctorType*>(0));
+
+		GenericMonadicApplyFunctor applier(this, func);
+
+		// carry out the cached monadic Apply operation
+		CUDDFacade::Node* res = cudd_.MonadicApply(RA::getHandleOfRoot(root),
+			&applier, op);
+
+		cudd_.Ref(res);
+
+		return RA::allocateRoot(res);
+	}
+
+
+	virtual size_t GetCacheHits() const
+	{
+		return cudd_.GetLeafCacheHits();
+	}
+
+
+	virtual size_t GetCacheMisses() const
+	{
+		return cudd_.GetLeafCacheMisses();
+	}
+
+
+	virtual unsigned long GetPeakNodeCount() const
+	{
+		return cudd_.GetPeakNodeCount();
+	}
+
+
+	virtual double GetComputedTableHitRate() const
+	{
+		return cudd_.GetComputedTableHitRate();
+	}
+
+
+	virtual unsigned long GetNodeCount() const
+	{
+		return cudd_.GetNodeCount();
+	}
+
+
+	virtual void SetDynamicReordering(bool enable)
+	{
+		if (enable)
+		{	// in case reordering is to be enabled
+			cudd_.EnableDynamicReordering();
+		}
+		else
+		{	// in case reordering is to be disabled
+			cudd_.DisableDynamicReordering();
+		}
+	}
+
+
+	virtual void ReorderVariables()
+	{
+		cudd_.ReorderVariables();
+	}
+
+
 	virtual RootType CreateRoot()
 	{
 		CUDDFacade::Node* node = cudd_.ReadBackground();
@@ -1000,16 +1421,82 @@ public:   // Public methods
 	}
 
 
+	virtual void ReferenceRoot(const RootType& root)
+	{
+		RA::referenceRoot(root);
+	}
+
+
 	virtual void EraseRoot(const RootType& root)
 	{
-		eraseCUDDRoot(RA::getHandleOfRoot(root));
-		RA::eraseRoot(root);
+		CUDDFacade::Node* node = RA::getHandleOfRoot(root);
+		if (RA::eraseRoot(root))
+		{	// in case this was the last owner of the root
+			eraseCUDDRoot(node);
+		}
+	}
+
+
+	virtual void ReleaseRoots(const RootArray& roots)
+	{
+		for (typename RootArray::const_iterator itRoots = roots.begin();
+			itRoots != roots.end(); ++itRoots)
+		{	// leaf handles are never reused, so plain dereference is sufficient
+			CUDDFacade::Node* node = RA::getHandleOfRoot(*itRoots);
+			if (RA::eraseRoot(*itRoots))
+			{	// in case this was the last owner of the root
+				cudd_.RecursiveDeref(node);
+			}
+		}
+	}
+
+
+	/**
+	 * @brief  Copies MTBDDs to another shared MTBDD
+	 *
+	 * Copies the MTBDDs of given roots to another shared MTBDD directly
+	 * between the CUDD managers, without serialization into text. Leaves are
+	 * inserted into the leaf allocator of @p target and handles in the copies
+	 * are translated accordingly. Both shared MTBDDs need to have the same
+	 * bottom.
+	 *
+	 * @param[in]  target  The shared MTBDD the MTBDDs are copied to
+	 * @param[in]  roots   Roots of the MTBDDs in this shared MTBDD
+	 *
+	 * @returns  Roots of the copies in @p target, in the order of @p roots
+	 */
+	RootArray CopyTo(CUDDSharedMTBDD& target, const RootArray& roots)
+	{
+		std::vector<CUDDFacade::Node*> nodes;
+		nodes.reserve(roots.size());
+		for (typename RootArray::const_iterator itRoots = roots.begin();
+			itRoots != roots.end(); ++itRoots)
+		{	// collect the nodes of the roots
+			nodes.push_back(RA::getHandleOfRoot(*itRoots));
+		}
+
+		LeafTransferMonadicApplyFunctor transfer(this, &target);
+		std::vector<CUDDFacade::Node*> copies = cudd_.CopyTo(target.cudd_, nodes,
+			&transfer);
+
+		RootArray result;
+		result.reserve(copies.size());
+		for (std::vector<CUDDFacade::Node*>::const_iterator itCopies = copies.begin();
+			itCopies != copies.end(); ++itCopies)
+		{	// the copies are already referenced
+			result.push_back(target.RA::allocateRoot(*itCopies));
+		}
+
+		return result;
 	}
 
 
 	virtual void SetBottomValue(const LeafType& bottom)
 	{
 		LA::setBottom(bottom);
+
+		// the bottom handle now stands for a different leaf
+		cudd_.InvalidateAllCachedOperations();
 	}
 
 
@@ -1082,7 +1569,10 @@ public:   // Public methods
 		CUDDFacade::Node* newRoot = RA::getHandleOfRoot(root);
 		cudd_.Ref(newRoot);
 
-		for (VariableType i = 0; i < GetMaxSize(); ++i)
+		// renaming may reference new variables
+		const size_t maxSize = GetMaxSize();
+
+		for (VariableType i = 0; i < maxSize; ++i)
 		{	// rename all variables according to given renaming functor
 			VariableType newName;
 			if ((newName = (*func)(i)) != i)
@@ -1160,13 +1650,37 @@ public:   // Public methods
 	}
 
 
+	virtual void RestrictVariableToZero(const VariableType& var)
+	{
+		CUDDFacade::Node* varNode = getIthVariable(var);
+		CUDDFacade::Node* bottom = cudd_.ReadBackground();
+
+		RootArray roots = RA::getAllRoots();
+		for (typename RootArray::const_iterator itRoots = roots.begin();
+			itRoots != roots.end(); ++itRoots)
+		{	// restrict all roots
+			CUDDFacade::Node* rootNode = RA::getHandleOfRoot(*itRoots);
+			CUDDFacade::Node* res = cudd_.Ite(varNode, bottom, rootNode);
+			cudd_.Ref(res);
+
+			// get rid of the old MTBDD
+			cudd_.RecursiveDeref(rootNode);
+
+			// substitute the new MTBDD for the old one
+			RA::changeHandleOfRoot(*itRoots, res);
+		}
+
+		cudd_.RecursiveDeref(varNode);
+	}
+
+
 	virtual ~CUDDSharedMTBDD()
 	{
 		RootArray roots = RA::getAllRoots();
 		for (typename RootArray::const_iterator it = roots.begin();
 			it != roots.end(); ++it)
-		{	// traverse all roots
-			EraseRoot(*it);
+		{	// traverse all roots, regardless of the number of their owners
+			eraseCUDDRoot(RA::getHandleOfRoot(*it));
 		}
 	}
 };
@@ -0,0 +1,684 @@
+/*****************************************************************************
+ *  Symbolic Finite Tree Automata Library
+ *
+ *  Copyright (c) 2010  Ondra Lengal <ondra@lengal.net>
+ *
+ *  Description:
+ *    Header file with LTSSimulation class that computes the simulation
+ *    preorder of a labelled transition system by partition refinement.
+ *
+ *****************************************************************************/
+
+#ifndef _SFTA_LTS_SIMULATION_HH_
+#define _SFTA_LTS_SIMULATION_HH_
+
+// Standard library headers
+#include <algorithm>
+#include <deque>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <tr1/unordered_map>
+#include <vector>
+
+// SFTA headers
+#include <sfta/convert.hh>
+
+
+// insert the class into proper namespace
+namespace SFTA
+{
+	namespace Private
+	{
+		class LTSSimulation;
+	}
+}
+
+
+/**
+ * @brief   Simulation preorder of a labelled transition system
+ * @author  Ondra Lengal <ondra@lengal.net>
+ * @date    2010
+ *
+ * The class computes the maximal simulation preorder of a labelled
+ * transition system whose states and labels are dense unsigned values. The
+ * algorithm follows the one of Ranzato and Tapparo as adapted to labelled
+ * transition systems (see the reference implementation in @p reflib/alg/
+ * rantap.ml): the preorder is kept as a partition of states together with
+ * a relation on its blocks, and blocks are split according to sets of
+ * states that are found not to simulate any state of a block. For every
+ * block, the number of successors of each state over each label that are
+ * in the blocks related to the block is counted, so that a state is removed
+ * from the simulators of the block as soon as the counter drops to zero.
+ *
+ * The initial partition puts states with different initial classes or
+ * different sets of enabled labels into different blocks, and a block is
+ * related to another one iff they are of the same initial class and the
+ * labels enabled in the first one are enabled in the second one as well.
+ * States of different initial classes are therefore never in the relation.
+ */
+class SFTA::Private::LTSSimulation
+{
+public:   // Public data types
+
+	typedef size_t StateType;
+	typedef size_t LabelType;
+
+private:  // Private data types
+
+
+	/**
+	 * @brief  Transition leading to a state
+	 *
+	 * A transition as seen from its target state, together with the index of
+	 * the counter of the pair of its source state and its label.
+	 */
+	struct PreTransition
+	{
+		LabelType label;
+		StateType source;
+		size_t counter;
+
+		PreTransition(const LabelType& lab, const StateType& src, size_t cnt)
+			: label(lab),
+				source(src),
+				counter(cnt)
+		{ }
+
+		friend bool operator<(const PreTransition& lhs, const PreTransition& rhs)
+		{
+			return lhs.label < rhs.label;
+		}
+	};
+
+	typedef std::vector<PreTransition> PreTransitionListType;
+
+	typedef std::pair<StateType, size_t> SourceType;
+	typedef std::vector<SourceType> SourceListType;
+	typedef std::tr1::unordered_map<LabelType, SourceListType> LabelToSourcesType;
+
+	typedef std::vector<StateType> StateListType;
+	typedef std::map<LabelType, StateListType> RemoveMapType;
+	typedef std::tr1::unordered_map<size_t, size_t> CounterMapType;
+
+
+	/**
+	 * @brief  Block of the partition
+	 *
+	 * A block of states together with the states that do not simulate the
+	 * block and are yet to be processed (indexed by labels) and the counters
+	 * of successors in the blocks related to the block (indexed by counters
+	 * of pairs of a state and a label, zero counters are not stored).
+	 */
+	struct Block
+	{
+		StateListType states;
+		StateListType tmp;
+		RemoveMapType remove;
+		CounterMapType relCount;
+
+		Block()
+			: states(),
+				tmp(),
+				remove(),
+				relCount()
+		{ }
+	};
+
+	typedef std::deque<Block> BlockListType;
+	typedef std::deque<std::vector<bool> > RelationType;
+
+	typedef std::pair<LabelType, size_t> TaskType;
+	typedef std::vector<TaskType> TaskListType;
+
+
+	/**
+	 * @brief  Transition of the system
+	 *
+	 * A transition ordered by its source state and its label.
+	 */
+	struct Transition
+	{
+		StateType source;
+		LabelType label;
+		StateType target;
+
+		Transition(const StateType& src, const LabelType& lab, const StateType& tgt)
+			: source(src),
+				label(lab),
+				target(tgt)
+		{ }
+
+		friend bool operator<(const Transition& lhs, const Transition& rhs)
+		{
+			return (lhs.source < rhs.source) ||
+				((lhs.source == rhs.source) && ((lhs.label < rhs.label) ||
+				((lhs.label == rhs.label) && (lhs.target < rhs.target))));
+		}
+
+		friend bool operator==(const Transition& lhs, const Transition& rhs)
+		{
+			return (lhs.source == rhs.source) && (lhs.label == rhs.label) &&
+				(lhs.target == rhs.target);
+		}
+	};
+
+	typedef std::vector<Transition> TransitionListType;
+
+	typedef SFTA::Private::Convert Convert;
+
+private:  // Private data members
+
+	size_t numStates_;
+
+	std::vector<size_t> classes_;
+
+	TransitionListType transitions_;
+
+
+	/**
+	 * Transitions leading to each state, sorted by labels.
+	 */
+	std::vector<PreTransitionListType> pre_;
+
+
+	/**
+	 * Sources of transitions over each label (together with their counters).
+	 */
+	LabelToSourcesType sources_;
+
+	BlockListType blocks_;
+
+	RelationType relation_;
+
+	std::vector<size_t> stateBlock_;
+
+	std::vector<size_t> statePos_;
+
+	std::vector<bool> isInTmp_;
+
+	std::vector<bool> isBlockMarked_;
+
+	TaskListType tasks_;
+
+	bool isComputed_;
+
+private:  // Private methods
+
+	LTSSimulation(const LTSSimulation&);
+	LTSSimulation& operator=(const LTSSimulation&);
+
+
+	size_t createBlock()
+	{
+		blocks_.push_back(Block());
+		isBlockMarked_.push_back(false);
+
+		return blocks_.size() - 1;
+	}
+
+	void addToBlock(const StateType& state, size_t block)
+	{
+		stateBlock_[state] = block;
+		statePos_[state] = blocks_[block].states.size();
+		blocks_[block].states.push_back(state);
+	}
+
+	void addToRemove(size_t block, const LabelType& label, const StateType& state)
+	{
+		StateListType& remove = blocks_[block].remove[label];
+		if (remove.empty())
+		{	// in case the block needs to be processed for the label
+			tasks_.push_back(TaskType(label, block));
+		}
+
+		remove.push_back(state);
+	}
+
+
+	/**
+	 * @brief  Builds the initial partition-relation pair
+	 *
+	 * Builds transitions leading to each state, the initial partition and
+	 * relation, and the counters and sets of removed states of the blocks.
+	 */
+	void initialize()
+	{
+		typedef std::pair<size_t, std::vector<LabelType> > BlockKeyType;
+		typedef std::map<BlockKeyType, size_t> KeyToBlockType;
+
+		std::sort(transitions_.begin(), transitions_.end());
+		transitions_.erase(std::unique(transitions_.begin(), transitions_.end()),
+			transitions_.end());
+
+		// number the pairs of a source state and a label and collect enabled
+		// labels of states
+		std::vector<std::vector<LabelType> > enabled(numStates_);
+		size_t counter = 0;
+		for (size_t i = 0; i < transitions_.size(); ++i)
+		{
+			const Transition& trans = transitions_[i];
+			if ((i == 0) || (transitions_[i - 1].source != trans.source) ||
+				(transitions_[i - 1].label != trans.label))
+			{	// in case the pair of the source and the label is new
+				counter = i;
+				enabled[trans.source].push_back(trans.label);
+				sources_[trans.label].push_back(SourceType(trans.source, counter));
+			}
+
+			pre_[trans.target].push_back(PreTransition(trans.label, trans.source,
+				counter));
+		}
+
+		for (StateType state = 0; state < numStates_; ++state)
+		{
+			std::stable_sort(pre_[state].begin(), pre_[state].end());
+		}
+
+		// states of the same class with the same enabled labels form a block
+		KeyToBlockType keyToBlock;
+		std::vector<const BlockKeyType*> blockKeys;
+		for (StateType state = 0; state < numStates_; ++state)
+		{
+			BlockKeyType key(classes_[state], enabled[state]);
+
+			KeyToBlockType::const_iterator itKey;
+			if ((itKey = keyToBlock.find(key)) == keyToBlock.end())
+			{	// in case there is no block for the key yet
+				itKey = keyToBlock.insert(std::make_pair(key, createBlock())).first;
+				blockKeys.push_back(&(itKey->first));
+			}
+
+			addToBlock(state, itKey->second);
+		}
+
+		for (size_t i = 0; i < blocks_.size(); ++i)
+		{
+			relation_.push_back(std::vector<bool>(blocks_.size(), false));
+			for (size_t j = 0; j < blocks_.size(); ++j)
+			{
+				const BlockKeyType& lhs = *blockKeys[i];
+				const BlockKeyType& rhs = *blockKeys[j];
+
+				relation_[i][j] = (lhs.first == rhs.first) && std::includes(
+					rhs.second.begin(), rhs.second.end(),
+					lhs.second.begin(), lhs.second.end());
+			}
+		}
+
+		for (size_t block = 0; block < blocks_.size(); ++block)
+		{
+			Block& blk = blocks_[block];
+
+			// count successors in the related blocks
+			for (size_t related = 0; related < blocks_.size(); ++related)
+			{
+				if (!relation_[block][related])
+				{
+					continue;
+				}
+
+				const StateListType& states = blocks_[related].states;
+				for (StateListType::const_iterator itStates = states.begin();
+					itStates != states.end(); ++itStates)
+				{
+					const PreTransitionListType& pre = pre_[*itStates];
+					for (PreTransitionListType::const_iterator itPre = pre.begin();
+						itPre != pre.end(); ++itPre)
+					{
+						++blk.relCount[itPre->counter];
+					}
+				}
+			}
+
+			// collect labels of transitions leading to the block
+			std::vector<LabelType> labels;
+			for (StateListType::const_iterator itStates = blk.states.begin();
+				itStates != blk.states.end(); ++itStates)
+			{
+				const PreTransitionListType& pre = pre_[*itStates];
+				for (PreTransitionListType::const_iterator itPre = pre.begin();
+					itPre != pre.end(); ++itPre)
+				{
+					labels.push_back(itPre->label);
+				}
+			}
+
+			std::sort(labels.begin(), labels.end());
+			labels.erase(std::unique(labels.begin(), labels.end()), labels.end());
+
+			// states with a transition over the label but with no successor in
+			// the related blocks do not simulate the block
+			for (std::vector<LabelType>::const_iterator itLabels = labels.begin();
+				itLabels != labels.end(); ++itLabels)
+			{
+				const SourceListType& sources = sources_[*itLabels];
+				for (SourceListType::const_iterator itSources = sources.begin();
+					itSources != sources.end(); ++itSources)
+				{
+					if (blk.relCount.find(itSources->second) == blk.relCount.end())
+					{	// in case there is no successor in the related blocks
+						addToRemove(block, *itLabels, itSources->first);
+					}
+				}
+			}
+		}
+	}
+
+
+	/**
+	 * @brief  Splits the partition
+	 *
+	 * Splits the blocks of the partition so that each block is either
+	 * a subset of given set of states or disjoint with it. A new block
+	 * inherits the relation, the counters and the removed states of the
+	 * block it has been split from.
+	 *
+	 * @param[in]  remove  The set of states
+	 */
+	void split(const StateListType& remove)
+	{
+		std::vector<size_t> touched;
+		for (StateListType::const_iterator itRemove = remove.begin();
+			itRemove != remove.end(); ++itRemove)
+		{
+			const StateType& state = *itRemove;
+			if (isInTmp_[state])
+			{	// in case the state has already been moved
+				continue;
+			}
+
+			size_t block = stateBlock_[state];
+			Block& blk = blocks_[block];
+
+			// move the state from the block to its temporary part
+			StateType last = blk.states.back();
+			blk.states[statePos_[state]] = last;
+			statePos_[last] = statePos_[state];
+			blk.states.pop_back();
+
+			statePos_[state] = blk.tmp.size();
+			blk.tmp.push_back(state);
+			isInTmp_[state] = true;
+
+			if (blk.tmp.size() == 1)
+			{	// in case the block is touched for the first time
+				touched.push_back(block);
+			}
+		}
+
+		for (std::vector<size_t>::const_iterator itTouched = touched.begin();
+			itTouched != touched.end(); ++itTouched)
+		{
+			const size_t& block = *itTouched;
+			Block& blk = blocks_[block];
+
+			size_t target = block;
+			if (blk.states.empty())
+			{	// in case the whole block is removed
+				blk.states.swap(blk.tmp);
+			}
+			else
+			{	// in case the block is to be split
+				target = createBlock();
+				Block& newBlk = blocks_[target];
+				newBlk.states.swap(blk.tmp);
+				newBlk.remove = blk.remove;
+				newBlk.relCount = blk.relCount;
+
+				for (RemoveMapType::const_iterator itRemove = newBlk.remove.begin();
+					itRemove != newBlk.remove.end(); ++itRemove)
+				{
+					if (!itRemove->second.empty())
+					{	// in case the new block needs to be processed for the label
+						tasks_.push_back(TaskType(itRemove->first, target));
+					}
+				}
+
+				for (RelationType::iterator itRows = relation_.begin();
+					itRows != relation_.end(); ++itRows)
+				{
+					itRows->push_back((*itRows)[block]);
+				}
+
+				relation_.push_back(relation_[block]);
+			}
+
+			const StateListType& states = blocks_[target].states;
+			for (StateListType::const_iterator itStates = states.begin();
+				itStates != states.end(); ++itStates)
+			{
+				stateBlock_[*itStates] = target;
+				isInTmp_[*itStates] = false;
+			}
+		}
+	}
+
+
+	/**
+	 * @brief  Processes states that do not simulate a block
+	 *
+	 * Splits the partition according to the states that have a transition
+	 * over given label but do not simulate any state of given block, and
+	 * removes the blocks of these states from the simulators of blocks with
+	 * a transition over the label into the block.
+	 *
+	 * @param[in]  label  The label
+	 * @param[in]  block  The block
+	 */
+	void processTask(const LabelType& label, size_t block)
+	{
+		RemoveMapType::iterator itRemove;
+		if ((itRemove = blocks_[block].remove.find(label)) ==
+			blocks_[block].remove.end())
+		{	// in case there is nothing to be processed
+			return;
+		}
+
+		StateListType remove;
+		remove.swap(itRemove->second);
+		blocks_[block].remove.erase(itRemove);
+
+		StateListType previous = blocks_[block].states;
+		split(remove);
+
+		// the blocks that consist of the removed states
+		std::vector<size_t> removedBlocks;
+		for (StateListType::const_iterator itStates = remove.begin();
+			itStates != remove.end(); ++itStates)
+		{
+			size_t removedBlock = stateBlock_[*itStates];
+			if (!isBlockMarked_[removedBlock])
+			{
+				isBlockMarked_[removedBlock] = true;
+				removedBlocks.push_back(removedBlock);
+			}
+		}
+
+		for (std::vector<size_t>::const_iterator itBlocks = removedBlocks.begin();
+			itBlocks != removedBlocks.end(); ++itBlocks)
+		{
+			isBlockMarked_[*itBlocks] = false;
+		}
+
+		std::vector<size_t> predecessorBlocks;
+		for (StateListType::const_iterator itStates = previous.begin();
+			itStates != previous.end(); ++itStates)
+		{
+			const PreTransitionListType& pre = pre_[*itStates];
+			std::pair<PreTransitionListType::const_iterator,
+				PreTransitionListType::const_iterator> range = std::equal_range(
+				pre.begin(), pre.end(), PreTransition(label, 0, 0));
+
+			for (PreTransitionListType::const_iterator itPre = range.first;
+				itPre != range.second; ++itPre)
+			{	// for each block with a transition over the label into the block
+				size_t predBlock = stateBlock_[itPre->source];
+				if (isBlockMarked_[predBlock])
+				{	// in case the block has already been processed
+					continue;
+				}
+
+				isBlockMarked_[predBlock] = true;
+				predecessorBlocks.push_back(predBlock);
+
+				for (std::vector<size_t>::const_iterator itBlocks =
+					removedBlocks.begin(); itBlocks != removedBlocks.end(); ++itBlocks)
+				{
+					const size_t& removedBlock = *itBlocks;
+					if (!relation_[predBlock][removedBlock])
+					{
+						continue;
+					}
+
+					relation_[predBlock][removedBlock] = false;
+
+					// decrement counters of predecessors of the removed block
+					CounterMapType& relCount = blocks_[predBlock].relCount;
+					const StateListType& states = blocks_[removedBlock].states;
+					for (StateListType::const_iterator itRemoved = states.begin();
+						itRemoved != states.end(); ++itRemoved)
+					{
+						const PreTransitionListType& removedPre = pre_[*itRemoved];
+						for (PreTransitionListType::const_iterator itRemPre =
+							removedPre.begin(); itRemPre != removedPre.end(); ++itRemPre)
+						{
+							CounterMapType::iterator itCount = relCount.find(itRemPre->counter);
+							if (itCount == relCount.end())
+							{	// in case the counters are inconsistent
+								throw std::logic_error(__func__ +
+									std::string(": missing counter for state ") +
+									Convert::ToString(itRemPre->source));
+							}
+
+							if (--(itCount->second) == 0)
+							{	// in case there is no successor in the related blocks left
+								relCount.erase(itCount);
+								addToRemove(predBlock, itRemPre->label, itRemPre->source);
+							}
+						}
+					}
+				}
+			}
+		}
+
+		for (std::vector<size_t>::const_iterator itBlocks = predecessorBlocks.begin();
+			itBlocks != predecessorBlocks.end(); ++itBlocks)
+		{
+			isBlockMarked_[*itBlocks] = false;
+		}
+	}
+
+public:   // Public methods
+
+	explicit LTSSimulation(size_t numStates)
+		: numStates_(numStates),
+			classes_(numStates, 0),
+			transitions_(),
+			pre_(numStates),
+			sources_(),
+			blocks_(),
+			relation_(),
+			stateBlock_(numStates, 0),
+			statePos_(numStates, 0),
+			isInTmp_(numStates, false),
+			isBlockMarked_(),
+			tasks_(),
+			isComputed_(false)
+	{ }
+
+
+	/**
+	 * @brief  Sets the initial class of a state
+	 *
+	 * Sets the class of the initial partition of given state. States of
+	 * different classes never simulate each other. All states are of class 0
+	 * by default.
+	 *
+	 * @param[in]  state  The state
+	 * @param[in]  cls    The class
+	 */
+	void SetInitialClass(const StateType& state, size_t cls)
+	{
+		if (state >= numStates_)
+		{
+			throw std::runtime_error(__func__ + std::string(": invalid state ")
+				+ Convert::ToString(state));
+		}
+
+		classes_[state] = cls;
+	}
+
+	void AddTransition(const StateType& source, const LabelType& label,
+		const StateType& target)
+	{
+		if ((source >= numStates_) || (target >= numStates_))
+		{
+			throw std::runtime_error(__func__ + std::string(": invalid transition ")
+				+ Convert::ToString(source) + " -> " + Convert::ToString(target));
+		}
+
+		if (isComputed_)
+		{
+			throw std::runtime_error(__func__ +
+				std::string(": the simulation has already been computed"));
+		}
+
+		transitions_.push_back(Transition(source, label, target));
+	}
+
+
+	/**
+	 * @brief  Computes the simulation
+	 *
+	 * Computes the maximal simulation preorder contained in the initial
+	 * relation.
+	 */
+	void Compute()
+	{
+		if (isComputed_)
+		{	// in case there is nothing to be done
+			return;
+		}
+
+		initialize();
+
+		while (!tasks_.empty())
+		{	// until there are states that do not simulate some block
+			TaskType task = tasks_.back();
+			tasks_.pop_back();
+
+			processTask(task.first, task.second);
+		}
+
+		isComputed_ = true;
+	}
+
+
+	/**
+	 * @brief  Checks whether a state is simulated by another one
+	 *
+	 * @param[in]  smaller  The simulated state
+	 * @param[in]  bigger   The simulating state
+	 *
+	 * @returns  @p true if @p smaller is simulated by @p bigger, @p false
+	 *           otherwise
+	 */
+	inline bool IsSimulated(const StateType& smaller, const StateType& bigger) const
+	{
+		if (!isComputed_)
+		{
+			throw std::runtime_error(__func__ +
+				std::string(": the simulation has not been computed"));
+		}
+
+		return relation_[stateBlock_[smaller]][stateBlock_[bigger]];
+	}
+
+	inline size_t GetNumberOfBlocks() const
+	{
+		return blocks_.size();
+	}
+};
+
+#endif
@@ -38,7 +38,8 @@ namespace SFTA
  * 
  * @see  SFTA::CUDDSharedMTBDD
  *
- * @tparam  Leaf                         The type of leaf.
+ * @tparam  Leaf                         The type of leaf (needs to be ordered
+ *                                       by @c operator<).
  * @tparam  Handle                       The type of handle.
  * @tparam  AbstractMonadicApplyFunctor  The type of the monadic Apply functor
  *                                       of the underlying MTBDD package
@@ -79,6 +80,15 @@ private:  // Private data types
 	typedef std::map<HandleType, LeafType> LeafContainer;
 
 
+	/**
+	 * @brief  The index type for leaves
+	 *
+	 * The data type that serves as an index mapping leaves back to their
+	 * handles.
+	 */
+	typedef std::map<LeafType, HandleType> LeafIndex;
+
+
 	/**
 	 * @brief  The type of the Convert class
 	 *
@@ -116,6 +126,16 @@ private:  // Private data members
 	LeafContainer asocArr_;
 
 
+	/**
+	 * @brief  The index of leaves
+	 *
+	 * The index that maps each stored leaf to the lowest handle associated
+	 * with it. It is kept in sync with @p asocArr_ so that a leaf can be found
+	 * in logarithmic time.
+	 */
+	LeafIndex leafIndex_;
+
+
 	/**
 	 * @brief  Counter of indices
 	 *
@@ -147,6 +167,38 @@ private:  // Private methods
 	MapLeafAllocator(const MapLeafAllocator&);
 	MapLeafAllocator& operator=(const MapLeafAllocator&);
 
+
+	/**
+	 * @brief  Removes a leaf from the index
+	 *
+	 * Removes the index entry of given leaf in case it points to given handle.
+	 * If there is another handle with the same leaf in the container, the
+	 * entry is redirected to the lowest such handle.
+	 *
+	 * @param[in]  leaf    The leaf to be removed from the index
+	 * @param[in]  handle  The handle that is being detached from the leaf
+	 */
+	void unindexLeaf(const LeafType& leaf, const HandleType& handle)
+	{
+		typename LeafIndex::iterator itIndex = leafIndex_.find(leaf);
+		if ((itIndex == leafIndex_.end()) || (itIndex->second != handle))
+		{	// in case the index does not point to the handle
+			return;
+		}
+
+		leafIndex_.erase(itIndex);
+
+		for (typename LeafContainer::const_iterator it = asocArr_.begin();
+			it != asocArr_.end(); ++it)
+		{	// try to find another handle with the same leaf
+			if ((it->first != handle) && (it->second == leaf))
+			{	// in case we found it
+				leafIndex_.insert(std::make_pair(leaf, it->first));
+				return;
+			}
+		}
+	}
+
 protected:// Protected methods
 
 	/**
@@ -155,7 +207,7 @@ protected:// Protected methods
 	 * The default constructor
 	 */
 	MapLeafAllocator()
-		: asocArr_(), nextIndex_(BOTTOM + 1),
+		: asocArr_(), leafIndex_(), nextIndex_(BOTTOM + 1),
 		releaser_(new ReleaserMonadicApplyFunctor())
 	{ }
 
@@ -171,8 +223,17 @@ protected:// Protected methods
 	 */
 	void setBottom(const LeafType& leaf)
 	{
+		typename LeafContainer::iterator itBottom = asocArr_.find(BOTTOM);
+		if (itBottom != asocArr_.end())
+		{	// in case bottom has already been set, remove it from the index
+			unindexLeaf(itBottom->second, BOTTOM);
+		}
+
 		// set the value of bottom
 		asocArr_[BOTTOM] = leaf;
+
+		// bottom has the lowest handle so it always takes precedence
+		leafIndex_[leaf] = BOTTOM;
 	}
 
 
@@ -188,17 +249,16 @@ protected:// Protected methods
 	 */
 	HandleType createLeaf(const LeafType& leaf)
 	{
-		for (typename LeafContainer::const_iterator it = asocArr_.begin();
-			it != asocArr_.end(); ++it)
-		{	// try to find the leaf in already created leaves
-			if (it->second == leaf)
-			{	// in case we found it
-				return it->first;
-			}
+		// try to find the leaf in already created leaves
+		typename LeafIndex::const_iterator itIndex = leafIndex_.find(leaf);
+		if (itIndex != leafIndex_.end())
+		{	// in case we found it
+			return itIndex->second;
 		}
 
 		// otherwise create a new leaf
 		asocArr_[nextIndex_] = leaf;
+		leafIndex_.insert(std::make_pair(leaf, nextIndex_));
 		++nextIndex_;
 		return nextIndex_ - 1;
 	}
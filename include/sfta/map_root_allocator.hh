@@ -76,6 +76,15 @@ private:  // private data types
 	typedef std::map<RootType, HandleType> HandleContainer;
 
 
+	/**
+	 * @brief  Container of reference counts
+	 *
+	 * The data type that maps shared roots to the number of their additional
+	 * owners.
+	 */
+	typedef std::map<RootType, size_t> ReferenceContainer;
+
+
 private:  // private data members
 
 	/**
@@ -95,6 +104,24 @@ private:  // private data members
 	RootType nextIndex_;
 
 
+	/**
+	 * @brief  Erased roots
+	 *
+	 * Roots that have been erased and may be allocated again, so that
+	 * short-lived roots do not exhaust the range of indices.
+	 */
+	std::vector<RootType> freeRoots_;
+
+
+	/**
+	 * @brief  Shared roots
+	 *
+	 * Numbers of additional owners of roots that were referenced by
+	 * referenceRoot(). Roots that have a single owner are not present.
+	 */
+	ReferenceContainer sharedRoots_;
+
+
 protected:// protected methods
 
 
@@ -103,7 +130,7 @@ protected:// protected methods
 	 *
 	 * The constructor.
 	 */
-	MapRootAllocator() : arr_(), nextIndex_(0)
+	MapRootAllocator() : arr_(), nextIndex_(0), freeRoots_(), sharedRoots_()
 	{ }
 
 
@@ -111,6 +138,7 @@ protected:// protected methods
 	 * @brief  Allocates a new root
 	 *
 	 * This method allocates a new root for given handle and returns the root.
+	 * Previously erased roots are reused first.
 	 *
 	 * @param[in]  handle  The handle the root is to be pointing to
 	 *
@@ -118,6 +146,15 @@ protected:// protected methods
 	 */
 	RootType allocateRoot(const HandleType& handle)
 	{
+		if (!freeRoots_.empty())
+		{	// in case there is an erased root
+			RootType root = freeRoots_.back();
+			freeRoots_.pop_back();
+			arr_[root] = handle;
+
+			return root;
+		}
+
 		arr_[nextIndex_] = handle;
 		++nextIndex_;
 
@@ -222,14 +259,38 @@ protected:// protected methods
 	}
 
 
+	/**
+	 * @brief  Adds an owner of a root
+	 *
+	 * This method increments the reference count of a root, so that the root
+	 * is kept until eraseRoot() is called once more for it.
+	 *
+	 * @param[in]  root  The root to be referenced
+	 */
+	void referenceRoot(RootType root)
+	{
+		if (arr_.find(root) == arr_.end())
+		{	// in case it couldn't be found
+			throw std::runtime_error("Trying to reference root \""
+				+ SFTA::Private::Convert::ToString(root) + "\" that is not managed.");
+		}
+
+		++sharedRoots_[root];
+	}
+
+
 	/**
 	 * @brief  Erases a root
 	 *
-	 * This method erases a root from the container of roots.
+	 * This method drops a reference to a root and erases the root from the
+	 * container of roots in case it was the last one.
 	 *
 	 * @param[in]  root  The root to be erased
+	 *
+	 * @returns  @p true in case the root was erased, @p false in case it still
+	 *           has other owners
 	 */
-	void eraseRoot(RootType root)
+	bool eraseRoot(RootType root)
 	{
 		// try to find given root
 		typename HandleContainer::iterator it = arr_.find(root);
@@ -239,7 +300,21 @@ protected:// protected methods
 				+ SFTA::Private::Convert::ToString(root) + "\" that is not managed.");
 		}
 
+		typename ReferenceContainer::iterator itShared = sharedRoots_.find(root);
+		if (itShared != sharedRoots_.end())
+		{	// in case the root is shared
+			if (--(itShared->second) == 0)
+			{
+				sharedRoots_.erase(itShared);
+			}
+
+			return false;
+		}
+
 		arr_.erase(it);
+		freeRoots_.push_back(root);
+
+		return true;
 	}
 
 
@@ -0,0 +1,258 @@
+/*****************************************************************************
+ *  Symbolic Finite Tree Automata Library
+ *
+ *  Copyright (c) 2010  Ondra Lengal <ondra@lengal.net>
+ *
+ *  Description:
+ *    Header file with MemoryArena class that allocates small objects from
+ *    large blocks of memory and releases them all at once.
+ *
+ *****************************************************************************/
+
+#ifndef _SFTA_MEMORY_ARENA_HH_
+#define _SFTA_MEMORY_ARENA_HH_
+
+// Standard library headers
+#include <new>
+#include <vector>
+
+
+// insert the class into proper namespace
+namespace SFTA
+{
+	namespace Private
+	{
+		class MemoryArena;
+	}
+}
+
+
+/**
+ * @brief   Arena of memory
+ * @author  Ondra Lengal <ondra@lengal.net>
+ * @date    2010
+ *
+ * The class allocates memory for objects by bumping an offset in large
+ * blocks, so that an allocation costs a few instructions. Objects are never
+ * freed one by one. Instead, the position in the arena can be saved using
+ * GetMark() and all memory allocated after that is released in constant time
+ * by Rewind(), which makes the arena suitable for nested computations. Blocks
+ * are kept for later allocations and returned to the system only when the
+ * arena is destroyed.
+ *
+ * Destructors of the objects are not called, so only objects that do not
+ * need them (such as plain structures and arrays of pointers) should be
+ * stored in the arena.
+ */
+class SFTA::Private::MemoryArena
+{
+public:   // Public data types
+
+
+	/**
+	 * @brief  Position in the arena
+	 *
+	 * The position that the arena can be rewound to.
+	 */
+	struct MarkType
+	{
+		size_t block;
+		size_t offset;
+
+		MarkType(size_t blk, size_t off)
+			: block(blk),
+				offset(off)
+		{ }
+	};
+
+private:  // Private data types
+
+
+	/**
+	 * @brief  Type with the strictest alignment
+	 *
+	 * Union of types with the strictest alignment requirements, all
+	 * allocations are aligned to its size.
+	 */
+	union AlignType
+	{
+		long l;
+		double d;
+		long double ld;
+		void* p;
+	};
+
+	typedef std::pair<char*, size_t> BlockType;
+	typedef std::vector<BlockType> BlockVectorType;
+
+private:  // Private data members
+
+
+	/**
+	 * The alignment of allocated memory.
+	 */
+	static const size_t ALIGNMENT = sizeof(AlignType);
+
+
+	/**
+	 * Default size of a block of memory.
+	 */
+	static const size_t DEFAULT_BLOCK_SIZE = 64 * 1024;
+
+
+	/**
+	 * @brief  Blocks of memory
+	 *
+	 * Allocated blocks of memory together with their sizes.
+	 */
+	BlockVectorType blocks_;
+
+	size_t blockSize_;
+
+
+	/**
+	 * The index of the block that memory is allocated from.
+	 */
+	size_t block_;
+
+
+	/**
+	 * The offset of free memory in the current block.
+	 */
+	size_t offset_;
+
+private:  // Private methods
+
+	MemoryArena(const MemoryArena&);
+	MemoryArena& operator=(const MemoryArena&);
+
+public:   // Public methods
+
+	explicit MemoryArena(size_t blockSize = DEFAULT_BLOCK_SIZE)
+		: blocks_(),
+			blockSize_(blockSize),
+			block_(0),
+			offset_(0)
+	{ }
+
+
+	/**
+	 * @brief  Allocates memory
+	 *
+	 * Allocates an aligned chunk of memory of given size. If the current block
+	 * is full, the allocation continues in the next block, which is allocated
+	 * if necessary.
+	 *
+	 * @param[in]  size  The size of the memory in bytes
+	 *
+	 * @returns  Pointer to the memory
+	 */
+	void* Allocate(size_t size)
+	{
+		// round the size up to the alignment
+		size = ((size + ALIGNMENT - 1) / ALIGNMENT) * ALIGNMENT;
+		if (size == 0)
+		{	// in case nothing is demanded, return a unique pointer anyway
+			size = ALIGNMENT;
+		}
+
+		while ((block_ < blocks_.size()) && (offset_ + size > blocks_[block_].second))
+		{	// skip blocks that are too small
+			++block_;
+			offset_ = 0;
+		}
+
+		if (block_ == blocks_.size())
+		{	// in case a new block is needed
+			size_t blockSize = (size > blockSize_)? size : blockSize_;
+			blocks_.push_back(BlockType(new char[blockSize], blockSize));
+			offset_ = 0;
+		}
+
+		void* result = blocks_[block_].first + offset_;
+		offset_ += size;
+
+		return result;
+	}
+
+
+	/**
+	 * @brief  Allocates an array
+	 *
+	 * Allocates uninitialized memory for an array of objects.
+	 *
+	 * @param[in]  count  The number of objects in the array
+	 *
+	 * @returns  Pointer to the first object
+	 */
+	template <class T>
+	inline T* AllocateArray(size_t count)
+	{
+		return static_cast<T*>(Allocate(count * sizeof(T)));
+	}
+
+
+	/**
+	 * @brief  Creates an object
+	 *
+	 * Creates a value-initialized object in the arena.
+	 *
+	 * @returns  Pointer to the object
+	 */
+	template <class T>
+	inline T* Create()
+	{
+		return new (Allocate(sizeof(T))) T();
+	}
+
+
+	/**
+	 * @brief  Returns the current position
+	 *
+	 * Returns the current position in the arena, which can be later passed to
+	 * Rewind().
+	 *
+	 * @returns  The position
+	 */
+	inline MarkType GetMark() const
+	{
+		return MarkType(block_, offset_);
+	}
+
+
+	/**
+	 * @brief  Rewinds the arena
+	 *
+	 * Releases all memory allocated since given position was obtained.
+	 *
+	 * @param[in]  mark  The position
+	 */
+	inline void Rewind(const MarkType& mark)
+	{
+		block_ = mark.block;
+		offset_ = mark.offset;
+	}
+
+
+	/**
+	 * @brief  Releases all memory
+	 *
+	 * Releases all memory of the arena, the blocks are kept for later use.
+	 */
+	inline void Clear()
+	{
+		block_ = 0;
+		offset_ = 0;
+	}
+
+	~MemoryArena()
+	{
+		for (BlockVectorType::iterator itBlocks = blocks_.begin();
+			itBlocks != blocks_.end(); ++itBlocks)
+		{
+			delete [] itBlocks->first;
+		}
+	}
+};
+
+#endif
@@ -67,6 +67,8 @@ public:   // Public data types
 
 	typedef SharedMTBDD SharedMTBDDType;
 
+	typedef typename SharedMTBDDType::ConfigurationType ConfigurationType;
+
 
 private:  // Private data members
 
@@ -87,6 +89,13 @@ public:   // Public methods
 		assert(mtbdd_ != static_cast<SharedMTBDDType*>(0));
 	}
 
+	explicit MTBDDTransitionTableWrapper(const ConfigurationType& config)
+		: mtbdd_(new SharedMTBDDType(config))
+	{
+		// Assertions
+		assert(mtbdd_ != static_cast<SharedMTBDDType*>(0));
+	}
+
 	inline SharedMTBDDType* GetMTBDD() const
 	{
 		// Assertions
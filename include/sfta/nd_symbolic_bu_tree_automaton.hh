@@ -12,13 +12,21 @@
 #define _ND_SYMBOLIC_BU_TREE_AUTOMATON_HH_
 
 // SFTA headers
+#include <sfta/antichain.hh>
 #include <sfta/inflatable_vector.hh>
+#include <sfta/lts_simulation.hh>
+#include <sfta/root_arena.hh>
 #include <sfta/symbolic_bu_tree_automaton.hh>
 #include <sfta/nd_symbolic_td_tree_automaton.hh>
+#include <sfta/witness_tree.hh>
 
 // Standard library headers
+#include <algorithm>
 #include <queue>
+#include <set>
 #include <tr1/unordered_map>
+#include <tr1/unordered_set>
+#include <vector>
 
 // Boost library headers
 #include <boost/functional/hash.hpp>
@@ -114,6 +122,30 @@ public:   // Public data types
 		SFTA::OrderedVector
 	> NDSymbolicTDTreeAutomatonType;
 
+	typedef SFTA::WitnessTree<SymbolType> TreeType;
+
+
+	/**
+	 * @brief  Statistics of a reduction
+	 *
+	 * The numbers of states, transitions and live MTBDD nodes removed by
+	 * a reduction of the automaton. Transitions are counted as triples of
+	 * a left-hand side, a cube of symbols and a state. The number of nodes
+	 * is negative in case the reduced MTBDDs need more nodes.
+	 */
+	struct ReductionStatistics
+	{
+		size_t removedStates;
+		size_t removedTransitions;
+		long removedNodes;
+
+		ReductionStatistics()
+			: removedStates(0),
+				removedTransitions(0),
+				removedNodes(0)
+		{ }
+	};
+
 
 	/**
 	 * @brief  @copybrief SFTA::SymbolicBUTreeAutomaton::Operation
@@ -127,6 +159,8 @@ public:   // Public data types
 
 		typedef typename SharedMTBDDType::RootType RootType;
 		typedef typename SharedMTBDDType::LeafType LeafType;
+		typedef typename SharedMTBDDType::OperationIdType OperationIdType;
+		typedef SFTA::Private::RootArena<SharedMTBDDType> RootArenaType;
 
 		typedef Type* (Operation::*BinaryOperation)(const Type&, const Type&) const;
 
@@ -154,31 +188,340 @@ public:   // Public data types
 
 			typedef OrderedVector<StateType> StateSetType;
 			typedef std::pair<size_t, StateSetType> NumberSetType;
-			typedef std::list<NumberSetType> StateSetListType;
-			typedef std::tr1::unordered_map<StateType, StateSetListType>
-				StateToStateSetListHashTableType;
+			typedef SFTA::Private::Antichain<StateType, StateSetType> AntichainType;
+			typedef typename AntichainType::ElementListType StateSetListType;
 			typedef std::pair<StateType, NumberSetType> AntichainPairType;
-			typedef std::queue<AntichainPairType> PairQueueType;
+
+			// pairs with fewer states of the bigger automaton go first
+			struct PairPriority
+			{
+				size_t operator()(const AntichainPairType& pair) const
+				{
+					return pair.second.second.size();
+				}
+			};
+
+			typedef SFTA::Private::Worklist<AntichainPairType, PairPriority>
+				PairQueueType;
 			typedef std::set<size_t> RevokedSetType;
+			typedef std::vector<size_t> NumberVectorType;
+
+			typedef typename HierarchyRoot::Operation::WitnessTreeType
+				WitnessTreeType;
+
+
+			/**
+			 * @brief  Record of a pair
+			 *
+			 * The pair (state, set of states) with the left-hand side of the
+			 * smaller automaton and the numbers of the pairs it was created from,
+			 * which is enough to find a tree that leads to the pair.
+			 */
+			struct PairRecord
+			{
+				StateType state;
+				StateSetType biggerStates;
+				LeftHandSideType lhs;
+				NumberVectorType predecessors;
+
+				PairRecord(const StateType& st, const StateSetType& bigger,
+					const LeftHandSideType& lh, const NumberVectorType& preds)
+					: state(st),
+						biggerStates(bigger),
+						lhs(lh),
+						predecessors(preds)
+				{ }
+			};
+
+			typedef std::vector<PairRecord> PairRecordVectorType;
+
+
+			class UnionApplyFunctor
+				: public SharedMTBDDType::AbstractApplyFunctorType
+			{
+			public:
+				virtual LeafType operator()(const LeafType& lhs, const LeafType& rhs)
+				{
+					return lhs.Union(rhs);
+				}
+			};
+
+
+			/**
+			 * @brief  Apply functor that finds symbols of a pair
+			 *
+			 * The functor returns a nonempty leaf for symbols under which the state
+			 * of the pair is reached in the smaller automaton and exactly the set
+			 * of states of the pair is reached in the bigger automaton.
+			 */
+			class WitnessApplyFunctor
+				: public SharedMTBDDType::AbstractApplyFunctorType
+			{
+			private:  // Private data members
+
+				const PairRecord& record_;
+
+			private:  // Private methods
+
+				WitnessApplyFunctor(const WitnessApplyFunctor&);
+				WitnessApplyFunctor& operator=(const WitnessApplyFunctor&);
+
+			public:   // Public methods
+
+				explicit WitnessApplyFunctor(const PairRecord& record)
+					: record_(record)
+				{ }
+
+				virtual LeafType operator()(const LeafType& lhs, const LeafType& rhs)
+				{
+					StateSetType biggerStates;
+					for (typename LeafType::const_iterator itRhs = rhs.begin();
+						itRhs != rhs.end(); ++itRhs)
+					{
+						biggerStates.insert(itRhs->GetElement());
+					}
+
+					if (biggerStates == record_.biggerStates)
+					{	// in case the set of the bigger automaton matches
+						for (typename LeafType::const_iterator itLhs = lhs.begin();
+							itLhs != lhs.end(); ++itLhs)
+						{
+							if (itLhs->GetElement() == record_.state)
+							{
+								return lhs;
+							}
+						}
+					}
+
+					return LeafType();
+				}
+			};
 
 		private:  // Private data members
 
 			const Type* smallerAut_;
 			const Type* biggerAut_;
 
+			// cached operations for union of sets of states and for collecting
+			// of pairs into the antichain
+			OperationIdType unionOperation_;
+			OperationIdType collectorOperation_;
+
+			// the order of processing of pairs
+			WorklistStrategy strategy_;
+
+			// the number of processed pairs
+			size_t processedPairs_;
+
+			// records of all pairs inserted into the antichain (indexed by their
+			// numbers)
+			PairRecordVectorType records_;
+
+			// the tree witnessing that the inclusion does not hold
+			WitnessTreeType witness_;
+
 		private:  // Private methods
 
 			InclusionCheckingFunctor(const InclusionCheckingFunctor&);
 			InclusionCheckingFunctor& operator=(const InclusionCheckingFunctor&);
 
+
+			/**
+			 * @brief  Unites roots of the bigger automaton
+			 *
+			 * Unites the roots of all left-hand sides of the bigger automaton from
+			 * the cartesian product of given sets of states.
+			 *
+			 * @param[in]  biggerSets  The sets of states
+			 * @param[in]  tmpRoots    The arena the intermediate roots are added to
+			 *
+			 * @returns  The united root
+			 */
+			RootType uniteBiggerRoots(const std::vector<const StateSetType*>& biggerSets,
+				RootArenaType& tmpRoots)
+			{
+				if (biggerSets.empty())
+				{	// in case the only left-hand side is the nullary one
+					return biggerAut_->getRoot(LeftHandSideType());
+				}
+
+				SharedMTBDDType* mtbdd = smallerAut_->GetTTWrapper()->GetMTBDD();
+				UnionApplyFunctor unionFunc;
+
+				// initialize vector of set iterators
+				std::vector<typename StateSetType::const_iterator> setVecIterator;
+				for (typename std::vector<const StateSetType*>::const_iterator itSets =
+					biggerSets.begin(); itSets != biggerSets.end(); ++itSets)
+				{
+					setVecIterator.push_back((*itSets)->begin());
+				}
+
+				// generate all possible arity-tuples of states from 'biggerSets'
+				RootType unitedRoots = tmpRoots.Add(mtbdd->CreateRoot());
+				int setIndex = setVecIterator.size() - 1;
+				while (setIndex >= 0)
+				{
+					// get the left-hand side vector
+					LeftHandSideType biggerLhs;
+					bool setEmpty = false;
+					for (size_t iVec = 0; iVec < setVecIterator.size(); ++iVec)
+					{
+						typename StateSetType::const_iterator& itTmp = setVecIterator[iVec];
+
+						if (itTmp == biggerSets[iVec]->end())
+						{	// in case the set is empty
+							setEmpty = true;
+							break;
+						}
+
+						biggerLhs.push_back(*itTmp);
+					}
+
+					if (setEmpty)
+					{
+						break;
+					}
+
+					unitedRoots = tmpRoots.Add(mtbdd->Apply(unitedRoots,
+						biggerAut_->getRoot(biggerLhs), &unionFunc, unionOperation_));
+
+					setIndex = setVecIterator.size() - 1;
+
+					do
+					{
+						setVecIterator[setIndex]++;
+
+						if (setVecIterator[setIndex] == biggerSets[setIndex]->end())
+						{
+							setVecIterator[setIndex] = biggerSets[setIndex]->begin();
+							--setIndex;
+						}
+						else
+						{
+							break;
+						}
+					} while (setIndex >= 0);
+				}
+
+				return unitedRoots;
+			}
+
+
+			/**
+			 * @brief  Adds a pair to the witness tree
+			 *
+			 * Adds the subtree leading to the pair with given number to the witness
+			 * tree. The symbol of the root of the subtree is found by a single
+			 * Apply on the roots the pair was created from.
+			 *
+			 * @param[in]  number    The number of the pair
+			 * @param[in]  nodes     Nodes of already added pairs
+			 * @param[in]  tmpRoots  The arena the intermediate roots are added to
+			 *
+			 * @returns  The index of the node of the pair in the witness tree
+			 */
+			size_t addWitnessNode(size_t number, NumberVectorType& nodes,
+				RootArenaType& tmpRoots)
+			{
+				assert(number < records_.size());
+
+				if (nodes[number] != records_.size())
+				{	// in case the subtree has already been added
+					return nodes[number];
+				}
+
+				const PairRecord& record = records_[number];
+
+				typename WitnessTreeType::ChildrenType children;
+				std::vector<const StateSetType*> biggerSets;
+				for (typename NumberVectorType::const_iterator itPreds =
+					record.predecessors.begin(); itPreds != record.predecessors.end();
+					++itPreds)
+				{
+					children.push_back(addWitnessNode(*itPreds, nodes, tmpRoots));
+					biggerSets.push_back(&(records_[*itPreds].biggerStates));
+				}
+
+				SharedMTBDDType* mtbdd = smallerAut_->GetTTWrapper()->GetMTBDD();
+
+				WitnessApplyFunctor witnessFunc(record);
+				RootType witnessRoot = tmpRoots.Add(mtbdd->Apply(
+					smallerAut_->getRoot(record.lhs), uniteBiggerRoots(biggerSets, tmpRoots),
+					&witnessFunc));
+
+				typedef typename SharedMTBDDType::DescriptionType DescriptionType;
+				DescriptionType description = mtbdd->GetMinimumDescription(witnessRoot);
+				for (typename DescriptionType::const_iterator itDesc = description.begin();
+					itDesc != description.end(); ++itDesc)
+				{
+					if (!itDesc->second.empty())
+					{	// in case the symbol leads to the pair
+						nodes[number] = witness_.AddNode(itDesc->first, children);
+						return nodes[number];
+					}
+				}
+
+				throw std::runtime_error(__func__ +
+					std::string(": cannot find a symbol of pair ") +
+					Convert::ToString(std::make_pair(record.state, record.biggerStates)));
+			}
+
+
+			/**
+			 * @brief  Builds the witness tree
+			 *
+			 * Builds the tree that leads to the pair with given number.
+			 *
+			 * @param[in]  number  The number of the pair
+			 */
+			void buildWitness(size_t number)
+			{
+				witness_.Clear();
+
+				// nodes of pairs, the number of records means that the pair has not
+				// been added yet
+				NumberVectorType nodes(records_.size(), records_.size());
+
+				RootArenaType tmpRoots(smallerAut_->GetTTWrapper()->GetMTBDD());
+				witness_.SetRoot(addWitnessNode(number, nodes, tmpRoots));
+			}
+
 		public:   // Public methods
 
-			InclusionCheckingFunctor(const Type* smallerAut, const Type* biggerAut)
+			InclusionCheckingFunctor(const Type* smallerAut, const Type* biggerAut,
+				WorklistStrategy strategy)
 				: smallerAut_(smallerAut),
-					biggerAut_(biggerAut)
+					biggerAut_(biggerAut),
+					unionOperation_(),
+					collectorOperation_(),
+					strategy_(strategy),
+					processedPairs_(0),
+					records_(),
+					witness_()
 			{
 				assert(smallerAut_ != static_cast<Type*>(0));
 				assert(biggerAut_ != static_cast<Type*>(0));
+
+				SharedMTBDDType* mtbdd = smallerAut_->GetTTWrapper()->GetMTBDD();
+				unionOperation_ = mtbdd->CreateCachedOperation();
+				collectorOperation_ = mtbdd->CreateCachedOperation();
+			}
+
+			~InclusionCheckingFunctor()
+			{
+				SharedMTBDDType* mtbdd = smallerAut_->GetTTWrapper()->GetMTBDD();
+				mtbdd->EraseCachedOperation(collectorOperation_);
+				mtbdd->EraseCachedOperation(unionOperation_);
+			}
+
+			inline size_t GetNumberOfProcessedPairs() const
+			{
+				return processedPairs_;
+			}
+
+			inline const WitnessTreeType& GetWitness() const
+			{
+				return witness_;
 			}
 
 			bool operator()()
@@ -190,11 +533,20 @@ public:   // Public data types
 
 					const Type* smallerAut_;
 					const Type* biggerAut_;
-					StateToStateSetListHashTableType* antichain_;
+					AntichainType* antichain_;
 					PairQueueType* pairQueue_;
 					bool failed_;
 					size_t counter_;
 					RevokedSetType* revokedNumbers_;
+					PairRecordVectorType* records_;
+
+					// the left-hand side of the smaller automaton and the numbers of
+					// pairs that new pairs are created from
+					LeftHandSideType lhs_;
+					NumberVectorType predecessors_;
+
+					// the number of the pair that made the inclusion fail
+					size_t failingNumber_;
 
 				private:  // Private methods
 
@@ -204,142 +556,78 @@ public:   // Public data types
 				public:   // Public data members
 
 					CollectorApplyFunctor(const Type* smallerAut, const Type* biggerAut,
-						StateToStateSetListHashTableType* antichain, PairQueueType* pairQueue,
-						RevokedSetType* revokedNumbers)
+						AntichainType* antichain, PairQueueType* pairQueue,
+						RevokedSetType* revokedNumbers, PairRecordVectorType* records)
 						: smallerAut_(smallerAut),
 							biggerAut_(biggerAut),
 							antichain_(antichain),
 							pairQueue_(pairQueue),
 							failed_(false),
 							counter_(),
-							revokedNumbers_(revokedNumbers)
+							revokedNumbers_(revokedNumbers),
+							records_(records),
+							lhs_(),
+							predecessors_(),
+							failingNumber_(0)
 					{
 						assert(smallerAut_ != static_cast<Type*>(0));
 						assert(biggerAut_ != static_cast<Type*>(0));
-						assert(antichain_ != static_cast<StateToStateSetListHashTableType*>(0));
+						assert(antichain_ != static_cast<AntichainType*>(0));
 						assert(pairQueue_ != static_cast<PairQueueType*>(0));
 						assert(revokedNumbers_ != static_cast<RevokedSetType*>(0));
+						assert(records_ != static_cast<PairRecordVectorType*>(0));
+					}
+
+
+					/**
+					 * @brief  Sets the origin of new pairs
+					 *
+					 * Sets the left-hand side of the smaller automaton and the numbers of
+					 * pairs that the pairs found by the following Apply are created from.
+					 *
+					 * @param[in]  lhs           The left-hand side
+					 * @param[in]  predecessors  The numbers of pairs
+					 */
+					inline void SetPredecessors(const LeftHandSideType& lhs,
+						const NumberVectorType& predecessors)
+					{
+						lhs_ = lhs;
+						predecessors_ = predecessors;
 					}
 
 					virtual LeafType operator()(const LeafType& lhs, const LeafType& rhs)
 					{
 						if (!failed_)
 						{	// in case there is some sense in doing the following
+							StateSetType biggerStates;   // the set of states of 'rhs'
+							for (typename LeafType::const_iterator itRhs = rhs.begin();
+								itRhs != rhs.end(); ++itRhs)
+							{
+								biggerStates.insert(itRhs->GetElement());
+							}
+
 							for (typename LeafType::const_iterator itLhs = lhs.begin();
 								itLhs != lhs.end() && !(failed_); ++itLhs)
 							{
 								const StateType& smallerState = itLhs->GetElement();
 
-								bool addSet = false;         // flag that indicates that the following
-								                             // variable should be checked for finality
-								StateSetType biggerStates;   // contains newly added set to antichain
-								                             // (if such exists)
-
-								typename StateToStateSetListHashTableType::iterator itHT;
-								if ((itHT = antichain_->find(smallerState)) != antichain_->end())
-								{	// if there is already some list for the smallerState
-									StateSetListType& biggerSetList = itHT->second;
-
-									// try to find some smaller set in the antichain
-									bool isSubset = true;
-									typename StateSetListType::const_iterator itList;
-									for (itList = biggerSetList.begin();
-										itList != biggerSetList.end(); ++itList)
-									{
-										const StateSetType& listItem = itList->second;
-
-										// check if 'listItem' is a subset of 'rhs'
-										typename LeafType::const_iterator itRhs = rhs.begin();
-										for (typename StateSetType::const_iterator itAntichainSet
-											= listItem.begin(); itAntichainSet != listItem.end();
-											++itAntichainSet)
-										{
-											while ((itRhs != rhs.end()) &&
-												(itRhs->GetElement() < *itAntichainSet))
-											{
-												++itRhs;
-											}
-
-											if ((itRhs == rhs.end()) || (itRhs->GetElement() != *itAntichainSet))
-											{	// in case the 'listItem' is not a subset of 'rhs'
-												isSubset = false;
-												break;
-											}
-										}
-
-										assert(!isSubset || (itRhs != rhs.end()) || rhs.empty());
-
-										if (isSubset)
-										{	// in case we found some subset
-											break;
-										}
-									}
-
-									if (!isSubset)
-									{	// in case there is no smaller set in the antichain
-										addSet = true;
-
-										// remove all bigger sets from the antichain
-										typename StateSetListType::iterator itList;
-										bool incrementIterator = true;
-										for (itList = biggerSetList.begin();
-											itList != biggerSetList.end();
-											itList = incrementIterator? ++itList : itList)
-										{
-											incrementIterator = true;
-											const StateSetType& listItem = itList->second;
-
-											// check if 'rhs' is a subset of 'listItem'
-											bool rhsIsSubset = true;
-											typename StateSetType::const_iterator itAntichainSet
-												= listItem.begin();
-											for (typename LeafType::const_iterator itRhs = rhs.begin();
-												itRhs != rhs.end(); ++itRhs)
-											{
-												while ((itAntichainSet != listItem.end()) &&
-													(*itAntichainSet < itRhs->GetElement()))
-												{
-													++itAntichainSet;
-												}
-
-												if ((itAntichainSet == listItem.end()) ||
-													(*itAntichainSet != itRhs->GetElement()))
-												{	// in case the 'rhs' is not a subset of 'listItem'
-													rhsIsSubset = false;
-													break;
-												}
-											}
-
-											assert(!rhsIsSubset || (itAntichainSet != listItem.end()));
-
-											if (rhsIsSubset)
-											{	// in case 'rhs' is smaller, remove 'listItem' from antichain
-												itList = biggerSetList.erase(itList);
-												revokedNumbers_->insert(itList->first);
-												incrementIterator = false;
-											}
-										}
-									}
-								}
-								else
-								{	// if there isn't any list for smallerState
-									addSet = true;
-									itHT = antichain_->insert(std::make_pair(smallerState, StateSetListType())).first;
-								}
-
-								if (addSet)
+								// the pair is added unless there is some smaller set in the
+								// antichain, in which case all bigger sets are removed
+								if (!antichain_->ContainsSubsetOf(smallerState, biggerStates))
 								{
-									//SFTA_LOGGER_INFO("Adding pair " + Convert::ToString(std::make_pair(smallerState, Convert::ToString(rhs))));
-									for (typename LeafType::const_iterator itRhs = rhs.begin();
-										itRhs != rhs.end(); ++itRhs)
-									{
-										biggerStates.insert(itRhs->GetElement());
-									}
+									std::vector<size_t> revoked;
+									antichain_->EraseSupersetsOf(smallerState, biggerStates, revoked);
+									revokedNumbers_->insert(revoked.begin(), revoked.end());
 
 									AntichainPairType newPair = std::make_pair(smallerState,
 										std::make_pair(getNewNumber(), biggerStates));
-									itHT->second.push_back(newPair.second);
-									pairQueue_->push(newPair);
+									antichain_->Insert(smallerState, newPair.second.first,
+										newPair.second.second);
+									pairQueue_->Push(newPair);
+
+									assert(records_->size() == newPair.second.first);
+									records_->push_back(PairRecord(smallerState, biggerStates,
+										lhs_, predecessors_));
 
 									if (smallerAut_->IsStateFinal(smallerState))
 									{	// in case the state from the smaller automaton is final
@@ -356,7 +644,7 @@ public:   // Public data types
 
 										if (failed_)
 										{
-											//SFTA_LOGGER_INFO("Failing pair: " + Convert::ToString(std::make_pair(smallerState, rhs)));
+											failingNumber_ = newPair.second.first;
 										}
 									}
 								}
@@ -371,66 +659,64 @@ public:   // Public data types
 						return failed_;
 					}
 
-					inline size_t getNewNumber()
+					inline size_t GetFailingNumber() const
 					{
-						return counter_++;
+						return failingNumber_;
 					}
-				};
-
 
-				class UnionApplyFunctor
-					: public SharedMTBDDType::AbstractApplyFunctorType
-				{
-				public:
-					virtual LeafType operator()(const LeafType& lhs, const LeafType& rhs)
+					inline size_t getNewNumber()
 					{
-						return lhs.Union(rhs);
+						return counter_++;
 					}
 				};
 
 
-				UnionApplyFunctor unionFunc;
-
 				// the antichain
-				StateToStateSetListHashTableType antichain;
-				// queue of pairs (state, state_set) added to antichain
-				// TODO: try stack here (compare with the queue)
-				PairQueueType pairQueue;
+				AntichainType antichain;
+				// worklist of pairs (state, state_set) added to antichain
+				PairQueueType pairQueue(strategy_);
 				// set of numbers of revoked pairs
 				RevokedSetType revokedNumbers;
 
+				// records of pairs are kept only for the witness of this run
+				records_.clear();
+				witness_.Clear();
+
 				CollectorApplyFunctor collector(smallerAut_, biggerAut_, &antichain,
-					&pairQueue, &revokedNumbers);
+					&pairQueue, &revokedNumbers, &records_);
 
 				SharedMTBDDType* mtbdd = smallerAut_->GetTTWrapper()->GetMTBDD();
 
+				// the collector is stateful: calling it again for the same pair of
+				// leaves does not change the antichain, but only within a single
+				// run with the same antichain
+				mtbdd->InvalidateCachedOperation(collectorOperation_);
+
+				// intermediate results are released in bulk once they are not needed
+				RootArenaType tmpRoots(mtbdd);
+
 				RootType smallerRoot = smallerAut_->getRoot(LeftHandSideType());
 				RootType biggerRoot = biggerAut_->getRoot(LeftHandSideType());
 
-				//RootType tmp =
-				mtbdd->Apply(smallerRoot, biggerRoot, &collector);
-
-				// Erase the following line for better performance ;-)
-				//mtbdd->EraseRoot(tmp);
+				collector.SetPredecessors(LeftHandSideType(), NumberVectorType());
+				tmpRoots.Add(mtbdd->Apply(smallerRoot, biggerRoot, &collector,
+					collectorOperation_));
+				tmpRoots.Release();
 
-				while (!collector.Failed() && !pairQueue.empty())
+				while (!collector.Failed() && !pairQueue.IsEmpty())
 				{
-					AntichainPairType nextPair = pairQueue.front();
-					pairQueue.pop();
-
-					//SFTA_LOGGER_INFO("Antichain = " + Convert::ToString(antichain));
+					AntichainPairType nextPair = pairQueue.Pop();
 
 					if (revokedNumbers.find(nextPair.second.first) == revokedNumbers.end())
 					{	// in case this pair has not been revoked
-						//SFTA_LOGGER_INFO("Processing pair: " + Convert::ToString(nextPair));
+						++processedPairs_;
 
 						StateType& smallerState = nextPair.first;
 
 						// find all superstates such that 'smallerState' is an element of
 						// these superstates
 						typename LHSRootContainerType::IndexValueArray smallerLhss =
-							smallerAut_->getRootMap().GetItemsWith(smallerState,
-							smallerAut_->getStates());
+							smallerAut_->getRootMap().GetItemsWith(smallerState);
 
 						for (size_t arity = 0; arity < smallerLhss.size(); ++arity)
 						{	// for each arity of left-hand side in smaller automaton
@@ -441,17 +727,18 @@ public:   // Public data types
 
 								const typename LHSRootContainerType::IndexValueType& lhsIV
 									= smallerLhss[arity][smallerIndex];
-								//SFTA_LOGGER_INFO("Checking LHS: " + Convert::ToString(lhsIV.first));
 
 								// collect vector of lists of possible values
 								bool allComponentsInAntichain = true;
 								std::vector<StateSetListType> listVector;
 								for (size_t arityIndex = 0; arityIndex < arity; ++arityIndex)
 								{
-									typename StateToStateSetListHashTableType::const_iterator itHT;
-									if ((itHT = antichain.find(lhsIV.first[arityIndex])) != antichain.end())
+									const StateSetListType* elements =
+										antichain.GetElements(lhsIV.first[arityIndex]);
+									if ((elements != static_cast<const StateSetListType*>(0)) &&
+										!elements->empty())
 									{
-										listVector.push_back(itHT->second);
+										listVector.push_back(*elements);
 									}
 									else
 									{
@@ -462,10 +749,6 @@ public:   // Public data types
 
 								if (allComponentsInAntichain)
 								{
-									//SFTA_LOGGER_INFO("All components are in the antichain for LHS " + Convert::ToString(lhsIV.first));
-
-									//SFTA_LOGGER_INFO("Respective sets: " + Convert::ToString(listVector));
-
 									assert(listVector.size() == arity);
 
 									// initialize vector of iterators
@@ -482,91 +765,30 @@ public:   // Public data types
 									int index = vecIterator.size() - 1;
 									while (index >= 0)
 									{	// until the most significant component overflows
-
-										std::string tmpString = "(";
-										for (typename std::vector<typename StateSetListType::const_iterator>
-											::const_iterator itItVec = vecIterator.begin();
-											itItVec != vecIterator.end(); ++itItVec)
-										{
-											tmpString += Convert::ToString(**itItVec) + ", ";
-										}
-
-										//SFTA_LOGGER_INFO("TODO: Generating.... " + tmpString + ")");
-
 										// generate the cartesian product of the sets
 
-										// initialize vector of set iterators
-										std::vector<typename StateSetType::const_iterator> setVecIterator;
+										// collect the tuple of sets together with the numbers of
+										// their pairs
+										std::vector<const StateSetType*> biggerSets;
+										NumberVectorType predecessors;
 										for (typename std::vector<typename StateSetListType::const_iterator>
 											::const_iterator itItVec = vecIterator.begin();
 											itItVec != vecIterator.end(); ++itItVec)
 										{
-											setVecIterator.push_back((*itItVec)->second.begin());
+											biggerSets.push_back(&((*itItVec)->states));
+											predecessors.push_back((*itItVec)->number);
 										}
 
-										assert(setVecIterator.size() == arity);
-
-										// generate all possible arity-tuples of sets from 'listVector'
-										RootType unitedRoots = mtbdd->CreateRoot();
-										int setIndex = setVecIterator.size() - 1;
-										while (setIndex >= 0)
-										{
-											// get the left-hand side vector
-											LeftHandSideType biggerLhs;
-											bool setEmpty = false;
-											for (size_t iVec = 0; iVec < setVecIterator.size(); ++iVec)
-											{
-												typename StateSetType::const_iterator& itTmp
-													= setVecIterator[iVec];
-
-												if (itTmp == vecIterator[iVec]->second.end())
-												{	// in case the set is empty
-													setEmpty = true;
-													break;
-												}
-
-												biggerLhs.push_back(*itTmp);
-											}
-
-											if (setEmpty)
-											{
-												break;
-											}
-
-											//SFTA_LOGGER_INFO("Generating.... " + Convert::ToString(biggerLhs));
-
-											//RootType tmpUnited = unitedRoots;
-											unitedRoots = mtbdd->Apply(unitedRoots,
-												biggerAut_->getRoot(biggerLhs), &unionFunc);
+										assert(biggerSets.size() == arity);
 
-											// Erase the following line for better performance ;-)
-											// mtbdd->EraseRoot(tmpUnited);
-
-											setIndex = setVecIterator.size() - 1;
-
-											do
-											{
-												setVecIterator[setIndex]++;
-
-												if (setVecIterator[setIndex] ==
-													vecIterator[setIndex]->second.end())
-												{
-													setVecIterator[setIndex] = vecIterator[setIndex]->second.begin();
-													--setIndex;
-												}
-												else
-												{
-													break;
-												}
-											} while (setIndex >= 0);
-										}
+										RootType unitedRoots = uniteBiggerRoots(biggerSets, tmpRoots);
 
-										//RootType tmpApplied =
-										mtbdd->Apply(smallerAut_->getRoot(lhsIV.first),
-											unitedRoots, &collector);
+										collector.SetPredecessors(lhsIV.first, predecessors);
+										tmpRoots.Add(mtbdd->Apply(smallerAut_->getRoot(lhsIV.first),
+											unitedRoots, &collector, collectorOperation_));
 
-										// Erase the following line for better performance ;-)
-										// mtbdd->EraseRoot(tmpApplied);
+										// all roots of this tuple of sets are dead now
+										tmpRoots.Release();
 
 										index = vecIterator.size() - 1;
 
@@ -589,10 +811,12 @@ public:   // Public data types
 							}
 						}
 					}
-					else
-					{
-						//SFTA_LOGGER_INFO("Revoked pair: " + Convert::ToString(nextPair));
-					}
+				}
+
+				if (collector.Failed())
+				{	// in case the inclusion does not hold, find the tree that leads to
+					// the failing pair
+					buildWitness(collector.GetFailingNumber());
 				}
 
 				return !collector.Failed();
@@ -653,9 +877,14 @@ public:   // Public data types
 			RootType lhsMtbdd = a1.getRoot(LeftHandSideType());
 			RootType rhsMtbdd = a2.getRoot(LeftHandSideType());
 
+			SharedMTBDDType* mtbdd = result->GetTTWrapper()->GetMTBDD();
 			UnionApplyFunctor unionFunc;
-			RootType resultRoot = result->GetTTWrapper()->GetMTBDD()->Apply(
-				lhsMtbdd, rhsMtbdd, &unionFunc);
+			RootType resultRoot = mtbdd->Apply(lhsMtbdd, rhsMtbdd, &unionFunc);
+
+			if (lhsMtbdd != result->getSinkSuperState())
+			{	// the copy of the first automaton does not own the root any more
+				mtbdd->EraseRoot(lhsMtbdd);
+			}
 
 			result->setRoot(LeftHandSideType(), resultRoot);
 
@@ -672,6 +901,11 @@ public:   // Public data types
 			typedef std::tr1::unordered_map<StatePair, StateType, HasherPair>
 				StatePairToStateTable;
 
+			// A2 states joined with an A1 state together with the product states
+			typedef std::pair<StateType, StateType> PartnerType;
+			typedef std::vector<PartnerType> PartnerListType;
+			typedef std::tr1::unordered_map<StateType, PartnerListType> JoinIndexType;
+
 			class IntersectionApplyFunctor
 				: public SharedMTBDDType::AbstractApplyFunctorType
 			{
@@ -754,6 +988,7 @@ public:   // Public data types
 			// create used data structures
 			NewStatesQueueType newStates;
 			StatePairToStateTable productStatesTable;
+			JoinIndexType joinIndex;
 			IntersectionApplyFunctor intersectionFunc(result, &newStates,
 				&productStatesTable);
 
@@ -766,6 +1001,12 @@ public:   // Public data types
 				lhsMtbdd, rhsMtbdd, &intersectionFunc);
 			result->setRoot(LeftHandSideType(), resultRoot);
 
+			// Left-hand sides of the product are joined from product states that
+			// have already been processed, which are kept in the join index for
+			// every A1 state. When a product state is processed, only those
+			// combinations in which it occurs are enumerated, so every pair of
+			// left-hand sides of A1 and A2 is joined exactly once, at the first
+			// position of the product state that was processed last.
 			while (!newStates.empty())
 			{	// until we process all states
 				StatePair productState = newStates.front().first;
@@ -778,61 +1019,115 @@ public:   // Public data types
 					result->SetStateFinal(resultState);
 				}
 
-				typename LHSRootContainerType::IndexValueArray a1Lhss =
-					a1.getRootMap().GetItemsWith(productState.first, a1.getStates());
+				// the product state may be joined from now on
+				PartnerListType& newPartners = joinIndex[productState.first];
+				newPartners.push_back(std::make_pair(productState.second, resultState));
+
+				// the list with the new product state only
+				PartnerListType pivotPartners;
+				pivotPartners.push_back(newPartners.back());
 
-				typename LHSRootContainerType::IndexValueArray a2Lhss =
-					a2.getRootMap().GetItemsWith(productState.second, a2.getStates());
+				typename LHSRootContainerType::IndexValueArray a1Lhss =
+					a1.getRootMap().GetItemsWith(productState.first);
 
+				for (size_t arity = 1; arity < a1Lhss.size(); ++arity)
+				{	// for each arity of left-hand side in A1
+					std::vector<const PartnerListType*> partners(arity);
+					std::vector<size_t> indices(arity);
 
-				for (size_t arity = 0;
-					(arity < a1Lhss.size()) && (arity < a2Lhss.size()); ++arity)
-				{	// for each arity of left-hand side in A1 and A2
 					for (size_t a1index = 0; a1index < a1Lhss[arity].size(); ++a1index)
 					{	// for each left-hand side of given arity in A1
-						for (size_t a2index = 0; a2index < a2Lhss[arity].size(); ++a2index)
-						{	// for each left-hand side of given arity in A2
-							const LeftHandSideType& a1candidate = a1Lhss[arity][a1index].first;
-							const LeftHandSideType& a2candidate = a2Lhss[arity][a2index].first;
-							// Assertions
-							assert(a1candidate.size() == arity);
-							assert(a2candidate.size() == arity);
-
-							LeftHandSideType newLhs;
-							for (size_t arityIndex = 0; arityIndex < arity; ++arityIndex)
-							{	// check if respective states have product state
-								typename StatePairToStateTable::const_iterator itTable;
-								if ((itTable = productStatesTable.find(std::make_pair(
-									a1candidate[arityIndex], a2candidate[arityIndex]))) !=
-									productStatesTable.end())
-								{
-									newLhs.push_back(itTable->second);
-								}
-								else
-								{
-									break;
-								}
+						const LeftHandSideType& a1lhs = a1Lhss[arity][a1index].first;
+						// Assertions
+						assert(a1lhs.size() == arity);
+
+						bool hasPartners = true;
+						for (size_t i = 0; (i < arity) && hasPartners; ++i)
+						{	// find joined product states for every position
+							typename JoinIndexType::const_iterator itIndex;
+							if ((itIndex = joinIndex.find(a1lhs[i])) == joinIndex.end())
+							{	// in case there is no product state with the A1 state
+								hasPartners = false;
 							}
-
-							if (newLhs.size() == arity)
-							{	// in case all positions match
-								// get rules for leaves
-								lhsMtbdd = a1.getRoot(a1Lhss[arity][a1index].first);
-								rhsMtbdd = a2.getRoot(a2Lhss[arity][a2index].first);
-
-								// carry out the apply operation on leaves
-								resultRoot = result->GetTTWrapper()->GetMTBDD()->Apply(
-									lhsMtbdd, rhsMtbdd, &intersectionFunc);
-								result->setRoot(newLhs, resultRoot);
+							else
+							{
+								partners[i] = &(itIndex->second);
 							}
 						}
-					}
-				}
-			}
 
+						if (!hasPartners)
+						{
+							continue;
+						}
 
-			return result;
-		}
+						for (size_t pivot = 0; pivot < arity; ++pivot)
+						{	// for each position where the new product state may be
+							if (a1lhs[pivot] != productState.first)
+							{
+								continue;
+							}
+
+							const PartnerListType* pivotOriginal = partners[pivot];
+							partners[pivot] = &pivotPartners;
+							std::fill(indices.begin(), indices.end(), 0);
+
+							bool isDone = false;
+							while (!isDone)
+							{	// for each combination of joined product states
+								LeftHandSideType a2lhs;
+								LeftHandSideType newLhs;
+								bool isFirstPivot = true;
+								for (size_t i = 0; i < arity; ++i)
+								{
+									const PartnerType& partner = (*partners[i])[indices[i]];
+									if ((i < pivot) && (a1lhs[i] == productState.first) &&
+										(partner.first == productState.second))
+									{	// in case the combination is joined at a former pivot
+										isFirstPivot = false;
+									}
+
+									a2lhs.push_back(partner.first);
+									newLhs.push_back(partner.second);
+								}
+
+								if (isFirstPivot)
+								{	// in case the combination has not been joined yet
+									rhsMtbdd = a2.getRoot(a2lhs);
+									if (rhsMtbdd != a2.getSinkSuperState())
+									{	// in case A2 has the left-hand side
+										lhsMtbdd = a1.getRoot(a1lhs);
+
+										// carry out the apply operation on leaves
+										resultRoot = result->GetTTWrapper()->GetMTBDD()->Apply(
+											lhsMtbdd, rhsMtbdd, &intersectionFunc);
+										result->setRoot(newLhs, resultRoot);
+									}
+								}
+
+								size_t position = 0;
+								while ((position < arity) &&
+									(++indices[position] == partners[position]->size()))
+								{	// move to the next combination
+									indices[position] = 0;
+									++position;
+								}
+
+								isDone = (position == arity);
+							}
+
+							partners[pivot] = pivotOriginal;
+						}
+					}
+				}
+			}
+
+			if (this->IsPruningProducts())
+			{	// in case useless states of the product are to be removed
+				result->RemoveUselessStates();
+			}
+
+			return result;
+		}
 
 
 	public:   // Public methods
@@ -864,10 +1159,10 @@ public:   // Public data types
 				throw std::runtime_error(__func__ + std::string(": Invalid type"));
 			}
 
-			// the simulation relation
-			SimType* sim = new SimType();
-
 			StateSetType states = autSym->getStates();
+
+			// the simulation relation, its matrix starts at the least state
+			SimType* sim = new SimType(states.empty()? StateType() : *states.begin());
 			for (typename StateSetType::const_iterator itStates = states.begin();
 				itStates != states.end(); ++itStates)
 			{
@@ -877,12 +1172,181 @@ public:   // Public data types
 			return sim;
 		}
 
+		/**
+		 * @brief  Computes the downward simulation preorder
+		 *
+		 * Computes the downward simulation preorder of a bottom-up automaton by
+		 * partition refinement. The automaton is translated into a labelled
+		 * transition system whose states are states and left-hand sides of the
+		 * automaton: a state @p q has a transition over a class of symbols into
+		 * a left-hand side if the automaton has a transition from the left-hand
+		 * side into @p q over all symbols of the class, and a left-hand side has
+		 * a transition over @p i into its @p i -th state. Classes of symbols are
+		 * obtained from the leaves of a single MTBDD that joins transitions of
+		 * all left-hand sides, so that every MTBDD of the automaton is traversed
+		 * only once. The simulation of the system is then computed by
+		 * LTSSimulation.
+		 *
+		 * @param[in]  aut  The automaton
+		 *
+		 * @returns  The simulation preorder
+		 *
+		 * @see  ComputeSimulationPreorderByCounters()
+		 */
 		virtual typename HierarchyRoot::Operation::SimulationRelationType*
 			ComputeSimulationPreorder(const HierarchyRoot* aut) const
 		{
 			// Assertions
 			assert(aut != static_cast<Type*>(0));
 
+			typedef typename HierarchyRoot::Operation::SimulationRelationType SimType;
+			typedef std::set<LeafType> LeafSetType;
+			typedef std::tr1::unordered_map<StateType, size_t> StateToIndexType;
+
+			class CollectorMonadicApplyFunctor
+				: public SharedMTBDDType::AbstractMonadicApplyFunctorType
+			{
+			private:  // Private data members
+
+				LeafSetType& leaves_;
+
+			private:  // Private methods
+
+				CollectorMonadicApplyFunctor(const CollectorMonadicApplyFunctor& func);
+				CollectorMonadicApplyFunctor& operator=(
+					const CollectorMonadicApplyFunctor& func);
+
+			public:   // Public methods
+
+				explicit CollectorMonadicApplyFunctor(LeafSetType& leaves)
+					: leaves_(leaves)
+				{ }
+
+				virtual LeafType operator()(const LeafType& val)
+				{
+					if (!val.empty())
+					{	// in case there are some transitions
+						leaves_.insert(val);
+					}
+
+					return LeafType();
+				}
+			};
+
+			const Type* autSym = static_cast<Type*>(0);
+
+			if ((autSym = dynamic_cast<const Type*>(aut)) ==
+				static_cast<const Type*>(0))
+			{	// in case the type is not OK
+				throw std::runtime_error(__func__ + std::string(": Invalid type"));
+			}
+
+			SharedMTBDDType* mtbdd = autSym->GetTTWrapper()->GetMTBDD();
+
+			std::vector<StateType> states = autSym->GetVectorOfStates();
+			StateToIndexType stateIndices;
+			for (size_t i = 0; i < states.size(); ++i)
+			{
+				stateIndices.insert(std::make_pair(states[i], i));
+			}
+
+			std::vector<LeftHandSideType> lhss;
+			RootType joinedRoot = autSym->joinTransitions(lhss);
+
+			// every leaf corresponds to a class of symbols
+			LeafSetType leaves;
+			CollectorMonadicApplyFunctor collectorFunc(leaves);
+			mtbdd->EraseRoot(mtbdd->MonadicApply(joinedRoot, &collectorFunc));
+			mtbdd->EraseRoot(joinedRoot);
+
+			SFTA_LOGGER_DEBUG("Computing simulation over " +
+				Convert::ToString(leaves.size()) + " classes of symbols");
+
+			// states are followed by left-hand sides, symbols are followed by
+			// positions in left-hand sides
+			Private::LTSSimulation lts(states.size() + lhss.size());
+
+			typename StateToIndexType::const_iterator itIndex;
+
+			size_t label = 0;
+			for (typename LeafSetType::const_iterator itLeaves = leaves.begin();
+				itLeaves != leaves.end(); ++itLeaves, ++label)
+			{
+				for (typename LeafType::const_iterator itTrans = itLeaves->begin();
+					itTrans != itLeaves->end(); ++itTrans)
+				{
+					const SFTA::Vector<StateType>& transition = itTrans->GetVector();
+
+					// Assertions
+					assert(transition.size() == 2);
+
+					if ((itIndex = stateIndices.find(transition[0])) == stateIndices.end())
+					{	// in case the state is not known
+						throw std::runtime_error(__func__ + std::string(": unknown state ")
+							+ Convert::ToString(transition[0]));
+					}
+
+					lts.AddTransition(itIndex->second, label,
+						states.size() + transition[1]);
+				}
+			}
+
+			for (size_t i = 0; i < lhss.size(); ++i)
+			{
+				const LeftHandSideType& lhs = lhss[i];
+
+				// only left-hand sides of the same arity may simulate each other
+				lts.SetInitialClass(states.size() + i, lhs.size() + 1);
+
+				for (size_t j = 0; j < lhs.size(); ++j)
+				{
+					if ((itIndex = stateIndices.find(lhs[j])) == stateIndices.end())
+					{	// in case the state is not known
+						throw std::runtime_error(__func__ + std::string(": unknown state ")
+							+ Convert::ToString(lhs[j]));
+					}
+
+					lts.AddTransition(states.size() + i, label + j, itIndex->second);
+				}
+			}
+
+			lts.Compute();
+
+			// the matrix of the relation starts at the least state
+			SimType* sim = new SimType(states.empty()? StateType() : states.front());
+			for (size_t i = 0; i < states.size(); ++i)
+			{
+				for (size_t j = 0; j < states.size(); ++j)
+				{
+					if (lts.IsSimulated(i, j))
+					{	// in case the states are in the relation
+						sim->insert(std::make_pair(states[i], states[j]));
+					}
+				}
+			}
+
+			return sim;
+		}
+
+
+		/**
+		 * @brief  Computes the downward simulation preorder using counters
+		 *
+		 * The original algorithm for the downward simulation preorder that keeps
+		 * counters of the refinement in MTBDDs. Its initialization compares
+		 * MTBDDs of all pairs of states, so it is much slower than
+		 * ComputeSimulationPreorder(), and it is kept for differential testing.
+		 *
+		 * @param[in]  aut  The automaton
+		 *
+		 * @returns  The simulation preorder
+		 */
+		typename HierarchyRoot::Operation::SimulationRelationType*
+			ComputeSimulationPreorderByCounters(const HierarchyRoot* aut) const
+		{
+			// Assertions
+			assert(aut != static_cast<Type*>(0));
+
 			typedef typename HierarchyRoot::Operation::SimulationRelationType SimType;
 			typedef LeftHandSideType StateVector;
 			typedef std::pair<StateVector, StateVector> StateVectorPair;
@@ -915,8 +1379,6 @@ public:   // Public data types
 
 				virtual LeafType operator()(const LeafType& lhs, const LeafType& rhs)
 				{
-					//SFTA_LOGGER_INFO("Initializing simulation counter for state " + Convert::ToString(state_));
-
 					if (lhs.size() != 0)
 					{
 						LeafType newRhs = rhs;
@@ -960,7 +1422,6 @@ public:   // Public data types
 
 				virtual LeafType operator()(const LeafType& lhs, const LeafType& rhs)
 				{
-					//SFTA_LOGGER_INFO("Detecting simulation...");
 					if (!lhs.empty() && rhs.empty())
 					{
 						doesSimulationHold_ = false;
@@ -1062,8 +1523,6 @@ public:   // Public data types
 				virtual LeafType operator()(const LeafType& preR, const LeafType& preQ,
 					const LeafType& cntQ)
 				{
-					//SFTA_LOGGER_INFO("Performing simulation refinement...");
-
 					LeafType newCntQ;
 
 					for (typename LeafType::const_iterator itCntQ = cntQ.begin();
@@ -1123,10 +1582,7 @@ public:   // Public data types
 			//                         INITIALIZATION
 			// ********************************************************************
 
-			// the simulation relation
-			SimType* sim = new SimType();
-
-			//SFTA_LOGGER_INFO("Started computing top-down automaton");
+			SFTA_LOGGER_DEBUG("Started computing top-down automaton");
 
 			// corresponding TD automaton
 			std::auto_ptr<NDSymbolicTDTreeAutomatonType> topDown(
@@ -1144,6 +1600,9 @@ public:   // Public data types
 			// array of states
 			std::vector<StateType> states = autSym->GetVectorOfStates();
 
+			// the simulation relation, its matrix starts at the least state
+			SimType* sim = new SimType(states.empty()? StateType() : states.front());
+
 			// The map of all LHSs of the BU automaton
 			LHSRootContainerType buLHSs =	autSym->getRootMap();
 
@@ -1179,7 +1638,7 @@ public:   // Public data types
 			SimulationDetectorApplyFunctor simulationDetector;
 			SimulationRefinementApplyFunctor simulationRefineFunc(sim, &remove, &stateToLhss);
 
-			//SFTA_LOGGER_INFO("Started computing initial refinement");
+			SFTA_LOGGER_DEBUG("Started computing initial refinement");
 
 			// now we perform initial refinement
 			for (typename std::vector<StateType>::const_iterator itStates = states.begin();
@@ -1267,7 +1726,7 @@ public:   // Public data types
 				}
 			}
 
-			//SFTA_LOGGER_INFO("Finished computing initial refinement");
+			SFTA_LOGGER_DEBUG("Finished computing initial refinement");
 
 			CountersType cnt(autSym->getSinkSuperState());
 
@@ -1299,10 +1758,10 @@ public:   // Public data types
 			//                           COMPUTATION
 			// ********************************************************************
 
-			//SFTA_LOGGER_INFO("Size of remove set: " + Convert::ToString(remove.size()));
+			SFTA_LOGGER_DEBUG("Size of remove set: " + Convert::ToString(remove.size()));
 			size_t loopCounter = 0;
 
-			//SFTA_LOGGER_INFO("Started computation");
+			SFTA_LOGGER_DEBUG("Started computation");
 			while (!remove.empty())
 			{	// while there is a need for backwards propagation of cut simulations
 				StateVectorPair cutRel = *(remove.begin());
@@ -1311,7 +1770,7 @@ public:   // Public data types
 				if (++loopCounter == 1000)
 				{
 					loopCounter = 0;
-					//SFTA_LOGGER_INFO("Size of remove set: " + Convert::ToString(remove.size()));
+					SFTA_LOGGER_DEBUG("Size of remove set: " + Convert::ToString(remove.size()));
 				}
 
 				const StateVector& qVec = cutRel.first;
@@ -1372,13 +1831,387 @@ public:   // Public data types
 				throw std::runtime_error(__func__ + std::string(": Invalid type"));
 			}
 
-			InclusionCheckingFunctor inclFunc(a1Sym, a2Sym);
-			return inclFunc();
+			InclusionCheckingFunctor inclFunc(a1Sym, a2Sym,
+				this->GetWorklistStrategy());
+			bool result = inclFunc();
+			this->setNumberOfProcessedPairs(inclFunc.GetNumberOfProcessedPairs());
+			this->setWitness(inclFunc.GetWitness());
+
+			return result;
 		}
 
 	};
 
 
+private:  // Private data types
+
+	typedef typename ParentClass::StateSetType StateSetType;
+	typedef std::tr1::unordered_set<StateType> StateHashSetType;
+	typedef typename HierarchyRoot::Operation::SimulationRelationType
+		SimulationRelationType;
+
+private:  // Private methods
+
+
+	/**
+	 * @brief  Joins transitions of all left-hand sides
+	 *
+	 * Builds a single MTBDD whose leaf for a symbol contains a pair (stored as
+	 * a vector) of a state and the index of a left-hand side for every
+	 * transition from the left-hand side into the state over the symbol. The
+	 * pairs in a leaf are therefore sorted by states. The MTBDD of every
+	 * left-hand side is tagged with its index first and the tagged MTBDDs are
+	 * then merged pairwise in a balanced tree, so that every pair is copied
+	 * only logarithmically many times in the number of left-hand sides.
+	 *
+	 * @param[out]  lhss  The left-hand sides in the order of their indices
+	 *
+	 * @returns  The root of the MTBDD, it needs to be erased by the caller
+	 */
+	typename SharedMTBDDType::RootType joinTransitions(
+		std::vector<LeftHandSideType>& lhss) const
+	{
+		typedef typename SharedMTBDDType::RootType RootType;
+		typedef typename SharedMTBDDType::LeafType LeafType;
+
+		class TaggingMonadicApplyFunctor
+			: public SharedMTBDDType::AbstractMonadicApplyFunctorType
+		{
+		private:  // Private data members
+
+			StateType lhsIndex_;
+
+		public:   // Public methods
+
+			TaggingMonadicApplyFunctor()
+				: lhsIndex_()
+			{ }
+
+			inline void SetLeftHandSideIndex(const StateType& lhsIndex)
+			{
+				lhsIndex_ = lhsIndex;
+			}
+
+			virtual LeafType operator()(const LeafType& val)
+			{
+				LeafType result;
+				for (typename LeafType::const_iterator itVal = val.begin();
+					itVal != val.end(); ++itVal)
+				{	// the pair of the state and the left-hand side
+					SFTA::Vector<StateType> transition;
+					transition.push_back(itVal->GetElement());
+					transition.push_back(lhsIndex_);
+					result.insert(transition);
+				}
+
+				return result;
+			}
+		};
+
+		class UnionApplyFunctor
+			: public SharedMTBDDType::AbstractApplyFunctorType
+		{
+		public:
+			virtual LeafType operator()(const LeafType& lhs, const LeafType& rhs)
+			{
+				return lhs.Union(rhs);
+			}
+		};
+
+		SharedMTBDDType* mtbdd = this->GetTTWrapper()->GetMTBDD();
+		const LHSRootContainerType& rootMap = this->getRootMap();
+
+		TaggingMonadicApplyFunctor taggingFunc;
+		std::vector<RootType> level;
+		for (typename LHSRootContainerType::const_iterator itLhss = rootMap.begin();
+			itLhss != rootMap.end(); ++itLhss)
+		{
+			taggingFunc.SetLeftHandSideIndex(lhss.size());
+			lhss.push_back(itLhss->first);
+
+			level.push_back(mtbdd->MonadicApply(itLhss->second, &taggingFunc));
+		}
+
+		if (level.empty())
+		{	// in case there are no transitions
+			return mtbdd->CreateRoot();
+		}
+
+		UnionApplyFunctor unionFunc;
+		while (level.size() > 1)
+		{	// merge neighbouring MTBDDs until a single one is left
+			std::vector<RootType> nextLevel;
+			for (size_t i = 0; i + 1 < level.size(); i += 2)
+			{
+				nextLevel.push_back(mtbdd->Apply(level[i], level[i + 1], &unionFunc));
+			}
+
+			if (level.size() % 2 != 0)
+			{	// the odd MTBDD is moved to the next level
+				nextLevel.push_back(level.back());
+				level.pop_back();
+			}
+
+			mtbdd->ReleaseRoots(level);
+			level.swap(nextLevel);
+		}
+
+		return level.front();
+	}
+
+
+	/**
+	 * @brief  Counts transitions
+	 *
+	 * Counts transitions of the automaton as triples of a left-hand side,
+	 * a cube of symbols and a state.
+	 *
+	 * @returns  The number of transitions
+	 */
+	size_t countTransitions() const
+	{
+		typedef typename ParentClass::TransitionType TransitionType;
+
+		std::vector<TransitionType> transitions = this->GetVectorOfTransitions();
+
+		size_t result = 0;
+		for (typename std::vector<TransitionType>::const_iterator itTrans =
+			transitions.begin(); itTrans != transitions.end(); ++itTrans)
+		{
+			result += itTrans->rhs.size();
+		}
+
+		return result;
+	}
+
+
+	/**
+	 * @brief  Collects states of a root
+	 *
+	 * Collects states in all leaves of the MTBDD with given root.
+	 *
+	 * @param[in]   root    The root of the MTBDD
+	 * @param[out]  states  The vector the states are appended to
+	 */
+	void collectStatesOfRoot(const typename SharedMTBDDType::RootType& root,
+		std::vector<StateType>& states) const
+	{
+		typedef typename SharedMTBDDType::LeafType LeafType;
+
+		class CollectorMonadicApplyFunctor
+			: public SharedMTBDDType::AbstractMonadicApplyFunctorType
+		{
+		private:  // Private data members
+
+			std::vector<StateType>& states_;
+
+		private:  // Private methods
+
+			CollectorMonadicApplyFunctor(const CollectorMonadicApplyFunctor& func);
+			CollectorMonadicApplyFunctor& operator=(
+				const CollectorMonadicApplyFunctor& func);
+
+		public:   // Public methods
+
+			explicit CollectorMonadicApplyFunctor(std::vector<StateType>& states)
+				: states_(states)
+			{ }
+
+			virtual LeafType operator()(const LeafType& val)
+			{
+				for (typename LeafType::const_iterator itVal = val.begin();
+					itVal != val.end(); ++itVal)
+				{
+					states_.push_back(itVal->GetElement());
+				}
+
+				return LeafType();
+			}
+		};
+
+		CollectorMonadicApplyFunctor collectorFunc(states);
+
+		SharedMTBDDType* mtbdd = this->GetTTWrapper()->GetMTBDD();
+		mtbdd->EraseRoot(mtbdd->MonadicApply(root, &collectorFunc));
+	}
+
+
+	static bool containsOnly(const LeftHandSideType& lhs,
+		const StateHashSetType& states)
+	{
+		for (typename LeftHandSideType::const_iterator itLhs = lhs.begin();
+			itLhs != lhs.end(); ++itLhs)
+		{
+			if (states.find(*itLhs) == states.end())
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+
+	/**
+	 * @brief  Computes reachable states
+	 *
+	 * Computes the set of states reachable bottom-up. A left-hand side is
+	 * processed once all its states have been processed, so the root of every
+	 * left-hand side is traversed at most once.
+	 *
+	 * @param[out]  reachable    The set of reachable states
+	 * @param[in]   stopAtFinal  Whether the computation is to stop when
+	 *                            a final state is reached
+	 *
+	 * @returns  @p true if the computation stopped at a final state, @p false
+	 *           otherwise
+	 */
+	bool computeReachableStates(StateHashSetType& reachable, bool stopAtFinal) const
+	{
+		StateHashSetType processed;
+		std::queue<StateType> workset;
+
+		std::vector<StateType> newStates;
+		collectStatesOfRoot(this->getRoot(LeftHandSideType()), newStates);
+
+		while (true)
+		{
+			for (typename std::vector<StateType>::const_iterator itStates =
+				newStates.begin(); itStates != newStates.end(); ++itStates)
+			{	// enqueue states that have not been reached yet
+				if (reachable.insert(*itStates).second)
+				{	// in case the state is reached for the first time
+					if (stopAtFinal && this->IsStateFinal(*itStates))
+					{	// in case a final state is reachable
+						SFTA_LOGGER_DEBUG("Reached final state "
+							+ Convert::ToString(*itStates));
+						return true;
+					}
+
+					workset.push(*itStates);
+				}
+			}
+
+			newStates.clear();
+
+			if (workset.empty())
+			{	// in case there is nothing more to process
+				return false;
+			}
+
+			StateType state = workset.front();
+			workset.pop();
+			processed.insert(state);
+
+			typename LHSRootContainerType::IndexValueArray lhss =
+				this->getRootMap().GetItemsWith(state);
+
+			for (size_t arity = 1; arity < lhss.size(); ++arity)
+			{	// for each arity of left-hand sides with the state
+				for (size_t index = 0; index < lhss[arity].size(); ++index)
+				{	// for each left-hand side of given arity
+					const typename LHSRootContainerType::IndexValueType& lhsIV =
+						lhss[arity][index];
+
+					if (containsOnly(lhsIV.first, processed))
+					{	// in case the left-hand side has just become complete
+						collectStatesOfRoot(lhsIV.second, newStates);
+					}
+				}
+			}
+		}
+	}
+
+
+	/**
+	 * @brief  Evaluates a node of a tree
+	 *
+	 * Computes the set of states that the automaton may reach in given node
+	 * of a tree. Results for nodes that have already been evaluated are
+	 * taken from @p reached.
+	 *
+	 * @param[in]      tree         The tree
+	 * @param[in]      node         The index of the node
+	 * @param[in,out]  reached      Sets of states reached in nodes of the tree
+	 * @param[in,out]  isEvaluated  Flags of nodes that have been evaluated
+	 *
+	 * @returns  The set of states reached in the node
+	 */
+	const OrderedVector<StateType>& evaluateNode(const TreeType& tree,
+		size_t node, std::vector<OrderedVector<StateType> >& reached,
+		std::vector<bool>& isEvaluated) const
+	{
+		typedef OrderedVector<StateType> StateSetType;
+		typedef typename SharedMTBDDType::RootType RootType;
+		typedef typename SharedMTBDDType::LeafContainer LeafContainer;
+
+		if (isEvaluated[node])
+		{	// in case the node has already been evaluated
+			return reached[node];
+		}
+
+		isEvaluated[node] = true;
+		StateSetType& result = reached[node];
+
+		const typename TreeType::Node& nd = tree.GetNode(node);
+		size_t arity = nd.children.size();
+
+		std::vector<const StateSetType*> childStates;
+		for (size_t i = 0; i < arity; ++i)
+		{
+			const StateSetType& states =
+				evaluateNode(tree, nd.children[i], reached, isEvaluated);
+			if (states.empty())
+			{	// in case no state is reachable in the child, there is nothing to do
+				return result;
+			}
+
+			childStates.push_back(&states);
+		}
+
+		SharedMTBDDType* mtbdd = this->GetTTWrapper()->GetMTBDD();
+
+		std::vector<size_t> indices(arity, 0);
+		bool isDone = false;
+		while (!isDone)
+		{	// for each tuple of states of children
+			LeftHandSideType lhs;
+			for (size_t i = 0; i < arity; ++i)
+			{
+				lhs.push_back(childStates[i]->ToVector()[indices[i]]);
+			}
+
+			RootType root = this->getRoot(lhs);
+			if (root != this->getSinkSuperState())
+			{	// in case there are transitions from the left-hand side
+				LeafContainer leaves = mtbdd->GetValue(root, nd.symbol);
+				for (typename LeafContainer::const_iterator itLeaves = leaves.begin();
+					itLeaves != leaves.end(); ++itLeaves)
+				{
+					for (typename RightHandSideType::const_iterator itRhs =
+						(*itLeaves)->begin(); itRhs != (*itLeaves)->end(); ++itRhs)
+					{
+						result.insert(itRhs->GetElement());
+					}
+				}
+			}
+
+			// move to the next tuple
+			size_t position = 0;
+			while ((position < arity) &&
+				(++indices[position] == childStates[position]->size()))
+			{
+				indices[position] = 0;
+				++position;
+			}
+
+			isDone = (position == arity);
+		}
+
+		return result;
+	}
+
+
 protected:// Protected methods
 
 	virtual Operation* createOperation() const
@@ -1405,64 +2238,108 @@ public:   // Public methods
 	{ }
 
 
+	/**
+	 * @brief  Copies the automaton to another MTBDD manager
+	 *
+	 * Creates a copy of the automaton that uses given wrapper. The MTBDDs are
+	 * copied directly between the MTBDD managers, so the copy can be used
+	 * from a different thread than the original, but the copying itself
+	 * needs both managers.
+	 *
+	 * @param[in]  ttWrapper  The wrapper of the MTBDD manager of the copy
+	 *
+	 * @returns  The copy (owned by the caller)
+	 */
+	NDSymbolicBUTreeAutomaton* CopyToManager(TTWrapperPtrType ttWrapper) const
+	{
+		std::auto_ptr<NDSymbolicBUTreeAutomaton> result(
+			new NDSymbolicBUTreeAutomaton(ttWrapper));
+		this->copyToManager(*result);
+
+		return result.release();
+	}
+
+
+	/**
+	 * @brief  Creates the top-down automaton
+	 *
+	 * Creates a top-down automaton with the same language that shares the
+	 * MTBDD manager with this automaton. Transitions of all left-hand sides
+	 * are joined into a single MTBDD first, and the MTBDD of each state is
+	 * then extracted from its leaves, so that the conversion needs a single
+	 * traversal per left-hand side and per state.
+	 *
+	 * @returns  The top-down automaton
+	 */
 	NDSymbolicTDTreeAutomatonType* GetTopDownAutomaton() const
 	{
 		typedef typename SharedMTBDDType::RootType RootType;
+		typedef typename SharedMTBDDType::LeafType LeafType;
 
-		class CollectorApplyFunctor
-			: public SharedMTBDDType::AbstractApplyFunctorType
+		class ExtractorMonadicApplyFunctor
+			: public SharedMTBDDType::AbstractMonadicApplyFunctorType
 		{
-		private:  // Private data types
+		private:  // Private data members
+
+			const std::vector<LeftHandSideType>& lhss_;
 
-			StateType wantedState_;
-			LeftHandSideType addedSuperState_;
+			StateType state_;
 
-		public:   // Public data types
+		private:  // Private methods
 
-			typedef typename SharedMTBDDType::LeafType LeafType;
+			ExtractorMonadicApplyFunctor(const ExtractorMonadicApplyFunctor& func);
+			ExtractorMonadicApplyFunctor& operator=(
+				const ExtractorMonadicApplyFunctor& func);
 
 		public:   // Public methods
 
-			CollectorApplyFunctor()
-				: wantedState_(),
-					addedSuperState_()
+			explicit ExtractorMonadicApplyFunctor(
+				const std::vector<LeftHandSideType>& lhss)
+				: lhss_(lhss),
+					state_()
 			{ }
 
-			void SetWantedState(const StateType& wantedState)
-			{
-				wantedState_ = wantedState;
-			}
-
-			void SetAddedSuperState(const LeftHandSideType& addedSuperState)
+			inline void SetState(const StateType& state)
 			{
-				addedSuperState_ = addedSuperState;
+				state_ = state;
 			}
 
-			virtual LeafType operator()(const LeafType& lhs, const LeafType& rhs)
+			virtual LeafType operator()(const LeafType& val)
 			{
-				if (lhs.find(wantedState_) != lhs.end())
-				{	// in case the state we are looking for is in the leaf
-					LeafType result = rhs;
-					result.insert(addedSuperState_);
-					return result;
-				}
-				else
+				// the pairs are sorted by states, so the pairs of the state form
+				// a contiguous range
+				SFTA::Vector<StateType> first;
+				first.push_back(state_);
+
+				LeafType result;
+				for (typename LeafType::const_iterator itVal = std::lower_bound(
+					val.begin(), val.end(), SFTA::Private::ElemOrVector<StateType>(first));
+					itVal != val.end(); ++itVal)
 				{
-					return rhs;
+					const SFTA::Vector<StateType>& transition = itVal->GetVector();
+					if (transition[0] != state_)
+					{	// in case the range of the state has been left
+						break;
+					}
+
+					result.insert(lhss_[transition[1]]);
 				}
+
+				return result;
 			}
 		};
 
-		CollectorApplyFunctor collectorFunc;
-
 		NDSymbolicTDTreeAutomatonType* tdAut =
 			new NDSymbolicTDTreeAutomatonType(this->GetTTWrapper());
 
-		std::vector<StateType> states = this->GetVectorOfStates();
+		SharedMTBDDType* mtbdd = this->GetTTWrapper()->GetMTBDD();
 
-		const LHSRootContainerType& rootMap = this->getRootMap();
+		std::vector<LeftHandSideType> lhss;
+		RootType joinedRoot = joinTransitions(lhss);
 
+		ExtractorMonadicApplyFunctor extractorFunc(lhss);
 
+		std::vector<StateType> states = this->GetVectorOfStates();
 		for (typename std::vector<StateType>::const_iterator itStates = states.begin();
 			itStates != states.end(); ++itStates)
 		{
@@ -1474,24 +2351,463 @@ public:   // Public methods
 				tdAut->SetStateInitial(newState);
 			}
 
-			RootType tdRoot = tdAut->getRoot(newState);
+			extractorFunc.SetState(newState);
+			tdAut->setRoot(newState, mtbdd->MonadicApply(joinedRoot, &extractorFunc));
+		}
 
-			collectorFunc.SetWantedState(newState);
+		mtbdd->EraseRoot(joinedRoot);
 
-			for (typename LHSRootContainerType::const_iterator itSuperStates = rootMap.begin();
-				itSuperStates != rootMap.end(); ++itSuperStates)
+		return tdAut;
+	}
+
+
+	/**
+	 * @brief  Checks whether the language is empty
+	 *
+	 * Computes the set of reachable states bottom-up and stops as soon as
+	 * a final state is reached.
+	 *
+	 * @returns  @p true if the language of the automaton is empty, @p false
+	 *           otherwise
+	 */
+	bool IsEmpty() const
+	{
+		StateHashSetType reachable;
+
+		return !computeReachableStates(reachable, true);
+	}
+
+
+	/**
+	 * @brief  Removes useless states
+	 *
+	 * Removes states that are not reachable bottom-up and states from which no
+	 * final state can be reached, together with left-hand sides that contain
+	 * them. The automaton drops its references to roots of removed left-hand
+	 * sides and the remaining roots are replaced by roots without the removed
+	 * states. Roots shared with another automaton (as they are, e.g., in the
+	 * result of the union of automata) are kept for their other owners.
+	 *
+	 * @returns  The number of removed states
+	 */
+	size_t RemoveUselessStates()
+	{
+		typedef typename SharedMTBDDType::LeafType LeafType;
+		typedef std::vector<LeftHandSideType> LeftHandSideListType;
+		typedef std::tr1::unordered_map<StateType, LeftHandSideListType>
+			PredecessorMapType;
+
+		class RemoverMonadicApplyFunctor
+			: public SharedMTBDDType::AbstractMonadicApplyFunctorType
+		{
+		private:  // Private data members
+
+			const StateHashSetType& keptStates_;
+
+		private:  // Private methods
+
+			RemoverMonadicApplyFunctor(const RemoverMonadicApplyFunctor& func);
+			RemoverMonadicApplyFunctor& operator=(const RemoverMonadicApplyFunctor& func);
+
+		public:   // Public methods
+
+			explicit RemoverMonadicApplyFunctor(const StateHashSetType& keptStates)
+				: keptStates_(keptStates)
+			{ }
+
+			virtual LeafType operator()(const LeafType& val)
 			{
-				collectorFunc.SetAddedSuperState(itSuperStates->first);
-				RootType newRoot = tdAut->GetTTWrapper()->GetMTBDD()->Apply(
-					itSuperStates->second, tdRoot, &collectorFunc);
-				tdAut->GetTTWrapper()->GetMTBDD()->EraseRoot(tdRoot);
-				tdRoot = newRoot;
+				LeafType result;
+				for (typename LeafType::const_iterator itVal = val.begin();
+					itVal != val.end(); ++itVal)
+				{
+					if (keptStates_.find(itVal->GetElement()) != keptStates_.end())
+					{	// in case the state is kept
+						result.insert(*itVal);
+					}
+				}
+
+				return result;
+			}
+		};
+
+		StateHashSetType reachable;
+		computeReachableStates(reachable, false);
+
+		// collect left-hand sides of reachable states that lead to each state
+		PredecessorMapType predecessors;
+		const LHSRootContainerType& rootMap = this->getRootMap();
+		for (typename LHSRootContainerType::const_iterator itLhss = rootMap.begin();
+			itLhss != rootMap.end(); ++itLhss)
+		{
+			if (!containsOnly(itLhss->first, reachable))
+			{	// in case the left-hand side is never used
+				continue;
 			}
 
-			tdAut->setRoot(newState, tdRoot);
+			std::vector<StateType> targets;
+			collectStatesOfRoot(itLhss->second, targets);
+			for (typename std::vector<StateType>::const_iterator itTargets =
+				targets.begin(); itTargets != targets.end(); ++itTargets)
+			{
+				predecessors[*itTargets].push_back(itLhss->first);
+			}
 		}
 
-		return tdAut;
+		// go back from reachable final states
+		StateHashSetType useful;
+		std::queue<StateType> workset;
+		for (typename StateHashSetType::const_iterator itStates = reachable.begin();
+			itStates != reachable.end(); ++itStates)
+		{
+			if (this->IsStateFinal(*itStates))
+			{	// in case the state is final
+				useful.insert(*itStates);
+				workset.push(*itStates);
+			}
+		}
+
+		while (!workset.empty())
+		{	// until all useful states are processed
+			StateType state = workset.front();
+			workset.pop();
+
+			typename PredecessorMapType::const_iterator itPred;
+			if ((itPred = predecessors.find(state)) == predecessors.end())
+			{	// in case no left-hand side leads to the state
+				continue;
+			}
+
+			for (typename LeftHandSideListType::const_iterator itLhss =
+				itPred->second.begin(); itLhss != itPred->second.end(); ++itLhss)
+			{
+				for (typename LeftHandSideType::const_iterator itStates = itLhss->begin();
+					itStates != itLhss->end(); ++itStates)
+				{
+					if (useful.insert(*itStates).second)
+					{	// in case the state is found to be useful
+						workset.push(*itStates);
+					}
+				}
+			}
+		}
+
+		size_t removedStates = this->getStates().size() - useful.size();
+		SFTA_LOGGER_DEBUG("Removing " + Convert::ToString(removedStates)
+			+ " useless states");
+
+		if (removedStates == 0)
+		{	// in case all states are useful
+			return 0;
+		}
+
+		SharedMTBDDType* mtbdd = this->GetTTWrapper()->GetMTBDD();
+		RemoverMonadicApplyFunctor removerFunc(useful);
+
+		LHSRootContainerType newRootMap(this->getSinkSuperState());
+		for (typename LHSRootContainerType::const_iterator itLhss = rootMap.begin();
+			itLhss != rootMap.end(); ++itLhss)
+		{
+			if (containsOnly(itLhss->first, useful))
+			{	// in case the left-hand side is kept
+				newRootMap.SetValue(itLhss->first,
+					mtbdd->MonadicApply(itLhss->second, &removerFunc));
+			}
+
+			mtbdd->EraseRoot(itLhss->second);
+		}
+
+		this->setRootMap(newRootMap);
+		this->restrictStates(StateSetType(std::vector<StateType>(useful.begin(),
+			useful.end())));
+
+		return removedStates;
+	}
+
+
+	/**
+	 * @brief  Reduces the automaton using a simulation
+	 *
+	 * Merges states that simulate each other into the least state of their
+	 * class and then removes a transition over a left-hand side if the same
+	 * transition exists over a different left-hand side that simulates it
+	 * component-wise, i.e. @p f(p1, ..., pn) -> q is removed in case there is
+	 * @p f(r1, ..., rn) -> q with @p pi simulated by @p ri for all @p i. The
+	 * relation needs to be a downward simulation of the automaton, such as
+	 * the one computed by Operation::ComputeSimulationPreorder(), so that the
+	 * language of the automaton is preserved. Roots are replaced in the same
+	 * way as by RemoveUselessStates(), so roots shared with another automaton
+	 * are not affected.
+	 *
+	 * @param[in]  sim  The simulation preorder on states of the automaton
+	 *
+	 * @returns  Statistics of the reduction
+	 */
+	ReductionStatistics ReduceBySimulation(const SimulationRelationType& sim)
+	{
+		typedef typename SharedMTBDDType::RootType RootType;
+		typedef typename SharedMTBDDType::LeafType LeafType;
+		typedef std::tr1::unordered_map<StateType, StateType> RepresentativeMapType;
+		typedef typename LHSRootContainerType::IndexValueArray IndexValueArray;
+		typedef typename LHSRootContainerType::SameLengthIndexValueVector
+			SameLengthIndexValueVector;
+
+		class RenamingMonadicApplyFunctor
+			: public SharedMTBDDType::AbstractMonadicApplyFunctorType
+		{
+		private:  // Private data members
+
+			const RepresentativeMapType& representatives_;
+
+		private:  // Private methods
+
+			RenamingMonadicApplyFunctor(const RenamingMonadicApplyFunctor& func);
+			RenamingMonadicApplyFunctor& operator=(const RenamingMonadicApplyFunctor& func);
+
+		public:   // Public methods
+
+			explicit RenamingMonadicApplyFunctor(
+				const RepresentativeMapType& representatives)
+				: representatives_(representatives)
+			{ }
+
+			virtual LeafType operator()(const LeafType& val)
+			{
+				LeafType result;
+				for (typename LeafType::const_iterator itVal = val.begin();
+					itVal != val.end(); ++itVal)
+				{
+					typename RepresentativeMapType::const_iterator itRep;
+					if ((itRep = representatives_.find(itVal->GetElement())) ==
+						representatives_.end())
+					{	// in case the state is not known
+						throw std::runtime_error(__func__ + std::string(": unknown state ")
+							+ Convert::ToString(itVal->GetElement()));
+					}
+
+					result.insert(itRep->second);
+				}
+
+				return result;
+			}
+		};
+
+		class UnionApplyFunctor
+			: public SharedMTBDDType::AbstractApplyFunctorType
+		{
+		public:
+			virtual LeafType operator()(const LeafType& lhs, const LeafType& rhs)
+			{
+				return lhs.Union(rhs);
+			}
+		};
+
+		class DifferenceApplyFunctor
+			: public SharedMTBDDType::AbstractApplyFunctorType
+		{
+		public:
+			virtual LeafType operator()(const LeafType& lhs, const LeafType& rhs)
+			{
+				LeafType result;
+				for (typename LeafType::const_iterator itLhs = lhs.begin();
+					itLhs != lhs.end(); ++itLhs)
+				{
+					if (rhs.find(*itLhs) == rhs.end())
+					{	// in case the state is not reached by the bigger left-hand side
+						result.insert(*itLhs);
+					}
+				}
+
+				return result;
+			}
+		};
+
+		SharedMTBDDType* mtbdd = this->GetTTWrapper()->GetMTBDD();
+
+		ReductionStatistics stats;
+		size_t transitionsBefore = countTransitions();
+		unsigned long nodesBefore = mtbdd->GetNodeCount();
+
+		// the least state of the class of simulation equivalence represents
+		// the class
+		std::vector<StateType> states = this->GetVectorOfStates();
+		RepresentativeMapType representatives;
+		StateHashSetType representativeSet;
+		for (typename std::vector<StateType>::const_iterator itStates = states.begin();
+			itStates != states.end(); ++itStates)
+		{
+			const StateType& state = *itStates;
+			StateType representative = state;
+
+			std::vector<StateType> simulators = sim.GetSimulators(state);
+			for (typename std::vector<StateType>::const_iterator itSim =
+				simulators.begin(); itSim != simulators.end(); ++itSim)
+			{	// the simulators are sorted, so the first equivalent one is the least
+				if ((*itSim < representative) && this->isStateLocal(*itSim) &&
+					sim.is_in(std::make_pair(*itSim, state)))
+				{	// in case the states simulate each other
+					representative = *itSim;
+					break;
+				}
+			}
+
+			representatives.insert(std::make_pair(state, representative));
+			representativeSet.insert(representative);
+		}
+
+		stats.removedStates = states.size() - representativeSet.size();
+		SFTA_LOGGER_DEBUG("Merging " + Convert::ToString(stats.removedStates)
+			+ " simulation equivalent states");
+
+		RenamingMonadicApplyFunctor renamingFunc(representatives);
+		UnionApplyFunctor unionFunc;
+		DifferenceApplyFunctor differenceFunc;
+
+		// merge the left-hand sides with the same representatives
+		const LHSRootContainerType& rootMap = this->getRootMap();
+		LHSRootContainerType newRootMap(this->getSinkSuperState());
+		std::vector<LeftHandSideType> newLhss;
+		for (typename LHSRootContainerType::const_iterator itLhss = rootMap.begin();
+			itLhss != rootMap.end(); ++itLhss)
+		{
+			LeftHandSideType lhs = itLhss->first;
+			for (size_t i = 0; i < lhs.size(); ++i)
+			{
+				lhs[i] = representatives[lhs[i]];
+			}
+
+			RootType renamedRoot = mtbdd->MonadicApply(itLhss->second, &renamingFunc);
+			mtbdd->EraseRoot(itLhss->second);
+
+			RootType oldRoot = newRootMap.GetValue(lhs);
+			if (oldRoot == this->getSinkSuperState())
+			{	// in case the left-hand side is new
+				newRootMap.SetValue(lhs, renamedRoot);
+				newLhss.push_back(lhs);
+			}
+			else
+			{
+				newRootMap.SetValue(lhs, mtbdd->Apply(oldRoot, renamedRoot, &unionFunc));
+				mtbdd->EraseRoot(oldRoot);
+				mtbdd->EraseRoot(renamedRoot);
+			}
+		}
+
+		// remove transitions over left-hand sides that are simulated by
+		// a different left-hand side
+		for (typename std::vector<LeftHandSideType>::const_iterator itLhss =
+			newLhss.begin(); itLhss != newLhss.end(); ++itLhss)
+		{
+			const LeftHandSideType& lhs = *itLhss;
+			if (lhs.empty())
+			{	// in case there is nothing to be simulated
+				continue;
+			}
+
+			std::vector<StateType> simulators = sim.GetSimulators(lhs[0]);
+			for (typename std::vector<StateType>::const_iterator itSim =
+				simulators.begin(); itSim != simulators.end(); ++itSim)
+			{
+				if (representativeSet.find(*itSim) == representativeSet.end())
+				{	// in case the state has been merged
+					continue;
+				}
+
+				IndexValueArray biggerLhss = newRootMap.GetItemsWith(*itSim);
+				if (biggerLhss.size() <= lhs.size())
+				{	// in case there is no left-hand side of the same arity
+					continue;
+				}
+
+				const SameLengthIndexValueVector& candidates = biggerLhss[lhs.size()];
+				for (typename SameLengthIndexValueVector::const_iterator itCand =
+					candidates.begin(); itCand != candidates.end(); ++itCand)
+				{
+					const LeftHandSideType& bigger = itCand->first;
+					if ((bigger[0] != *itSim) || (bigger == lhs))
+					{	// in case the candidate is not to be considered at this place
+						continue;
+					}
+
+					bool isSimulated = true;
+					for (size_t i = 1; i < lhs.size(); ++i)
+					{
+						if (!sim.is_in(std::make_pair(lhs[i], bigger[i])))
+						{	// in case a component is not simulated
+							isSimulated = false;
+							break;
+						}
+					}
+
+					if (isSimulated)
+					{	// in case the left-hand side is simulated by the candidate
+						RootType oldRoot = newRootMap.GetValue(lhs);
+						newRootMap.SetValue(lhs,
+							mtbdd->Apply(oldRoot, itCand->second, &differenceFunc));
+						mtbdd->EraseRoot(oldRoot);
+					}
+				}
+			}
+		}
+
+		// a class is final in case any of its states is final
+		for (typename std::vector<StateType>::const_iterator itStates = states.begin();
+			itStates != states.end(); ++itStates)
+		{
+			if (this->IsStateFinal(*itStates))
+			{
+				this->SetStateFinal(representatives[*itStates]);
+			}
+		}
+
+		this->setRootMap(newRootMap);
+		this->restrictStates(StateSetType(std::vector<StateType>(
+			representativeSet.begin(), representativeSet.end())));
+
+		stats.removedTransitions = transitionsBefore - countTransitions();
+		stats.removedNodes = static_cast<long>(nodesBefore) -
+			static_cast<long>(mtbdd->GetNodeCount());
+
+		return stats;
+	}
+
+
+	/**
+	 * @brief  Checks whether a tree is accepted
+	 *
+	 * Evaluates the tree bottom-up by reading transitions from the MTBDDs.
+	 * The evaluation of a node stops as soon as no state is reachable in some
+	 * of its children. Shared subtrees are evaluated only once.
+	 *
+	 * @param[in]  tree  The tree
+	 *
+	 * @returns  @p true if the automaton accepts the tree, @p false otherwise
+	 */
+	bool Accepts(const TreeType& tree) const
+	{
+		typedef OrderedVector<StateType> StateSetType;
+
+		if (tree.IsEmpty())
+		{
+			throw std::runtime_error(__func__ + std::string(": empty tree"));
+		}
+
+		std::vector<StateSetType> reached(tree.Size());
+		std::vector<bool> isEvaluated(tree.Size(), false);
+
+		const StateSetType& rootStates =
+			evaluateNode(tree, tree.GetRoot(), reached, isEvaluated);
+
+		for (typename StateSetType::const_iterator itStates = rootStates.begin();
+			itStates != rootStates.end(); ++itStates)
+		{
+			if (this->IsStateFinal(*itStates))
+			{	// in case a final state is reached in the root
+				return true;
+			}
+		}
+
+		return false;
 	}
 
 };
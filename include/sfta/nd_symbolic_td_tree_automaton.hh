@@ -12,12 +12,20 @@
 #define _ND_SYMBOLIC_TD_TREE_AUTOMATON_HH_
 
 // SFTA headers
+#include <sfta/antichain.hh>
+#include <sfta/memory_arena.hh>
+#include <sfta/root_arena.hh>
 #include <sfta/symbolic_td_tree_automaton.hh>
 #include <sfta/vector.hh>
+#include <sfta/worklist.hh>
 
 // Standard library headers
+#include <algorithm>
+#include <limits>
 #include <queue>
+#include <set>
 #include <tr1/unordered_map>
+#include <tr1/unordered_set>
 
 // Boost libraries
 #include <boost/functional/hash.hpp>
@@ -244,6 +252,8 @@ public:   // Public data types
 
 		typedef typename SharedMTBDDType::RootType RootType;
 		typedef typename SharedMTBDDType::LeafType LeafType;
+		typedef typename SharedMTBDDType::OperationIdType OperationIdType;
+		typedef SFTA::Private::RootArena<SharedMTBDDType> RootArenaType;
 
 		typedef Type* (Operation::*BinaryOperation)(const Type&, const Type&) const;
 
@@ -255,43 +265,124 @@ public:   // Public data types
 
 			//typedef std::vector<StateType> StateSetType;
 			typedef OrderedVector<StateType> StateSetType;
-			typedef std::list<StateSetType> StateSetListType;
 			typedef std::pair<StateType, StateSetType> DisjunctType;
 			typedef std::queue<DisjunctType> DisjunctQueueType;
 			typedef std::list<DisjunctType> DisjunctListType;
 			typedef std::vector<DisjunctType> SetOfDisjunctsType;
 			typedef std::queue<SetOfDisjunctsType> SetOfDisjunctsQueueType;
-			typedef std::tr1::unordered_map<StateType, StateSetListType>
-				StateToStateSetListHashTableType;
+			typedef SFTA::Private::Antichain<StateType, StateSetType> AntichainType;
+
+			typedef typename SFTA::Private::ElemOrVector<StateType>::VectorType
+				TupleType;
+			typedef std::vector<size_t> FailureNumberVectorType;
+
+			typedef typename HierarchyRoot::Operation::WitnessTreeType
+				WitnessTreeType;
+
+
+			/**
+			 * @brief  Record of a noninclusion
+			 *
+			 * The disjunct (state, set of states) whose inclusion does not hold
+			 * together with the tuple of children of the state and the tuples of
+			 * the set of states it was refuted for, and with the numbers of the
+			 * records of the children of the state.
+			 */
+			struct FailureRecord
+			{
+				DisjunctType disjunct;
+				TupleType tuple;
+				LeafType biggerTuples;
+				FailureNumberVectorType children;
+
+				FailureRecord(const DisjunctType& disj, const TupleType& tpl,
+					const LeafType& bigger, const FailureNumberVectorType& chld)
+					: disjunct(disj),
+						tuple(tpl),
+						biggerTuples(bigger),
+						children(chld)
+				{ }
+			};
+
+			typedef std::vector<FailureRecord> FailureRecordVectorType;
+
+
+			class UnionApplyFunctor
+				: public SharedMTBDDType::AbstractApplyFunctorType
+			{
+			public:
+
+				virtual LeafType operator()(const LeafType& lhs, const LeafType& rhs)
+				{
+					LeafType result = lhs;
+					result.insert(rhs);
+
+					return result;
+				}
+			};
+
+
+			/**
+			 * @brief  Apply functor that finds symbols of a noninclusion
+			 *
+			 * The functor returns a nonempty leaf for symbols under which the state
+			 * of the record has the tuple of the record and the set of states of
+			 * the record has exactly the tuples of the record.
+			 */
+			class WitnessApplyFunctor
+				: public SharedMTBDDType::AbstractApplyFunctorType
+			{
+			private:  // Private data members
+
+				const FailureRecord& record_;
+
+			private:  // Private methods
+
+				WitnessApplyFunctor(const WitnessApplyFunctor&);
+				WitnessApplyFunctor& operator=(const WitnessApplyFunctor&);
+
+			public:   // Public methods
+
+				explicit WitnessApplyFunctor(const FailureRecord& record)
+					: record_(record)
+				{ }
+
+				virtual LeafType operator()(const LeafType& lhs, const LeafType& rhs)
+				{
+					if ((rhs == record_.biggerTuples) &&
+						(lhs.find(record_.tuple) != lhs.end()))
+					{	// in case the symbol has the tuples of the record
+						return lhs;
+					}
+
+					return LeafType();
+				}
+			};
 
 		private:  // Private data types
 
 				struct AndNode;
 
+				/**
+				 * Or node of the tree, all arrays of the node are stored in the arena
+				 * of the inclusion checking functor
+				 */
 				struct OrNode
 				{
-					std::vector<AndNode*> parents_;
-					std::vector<AndNode*> disjuncts_;
+					AndNode** parents_;
+					size_t numParents_;
+					size_t parentsCapacity_;
 
-					OrNode()
-						: parents_(),
-							disjuncts_()
-					{ }
-
-					OrNode(AndNode* parent)
-						: parents_(1, parent),
-							disjuncts_()
-					{ }
+					AndNode** disjuncts_;
+					size_t numDisjuncts_;
 
 					friend std::ostream& operator<<(std::ostream& os, const OrNode& node)
 					{
 						os << "(Or";
 
-						for (typename std::vector<AndNode*>::const_iterator itDisjuncts
-							= node.disjuncts_.begin(); itDisjuncts != node.disjuncts_.end();
-							++itDisjuncts)
+						for (size_t i = 0; i < node.numDisjuncts_; ++i)
 						{
-							os << " " << Convert::ToString(*itDisjuncts);
+							os << " " << Convert::ToString(node.disjuncts_[i]);
 						}
 
 						os << ")";
@@ -302,56 +393,80 @@ public:   // Public data types
 
 				typedef unsigned char ArityType;
 
-				typedef std::vector<ArityType> ChoiceFunctionType; // serves as choiceFunction: rhs -> {1...arity}
-																													 // a |-> 0 means that a is not assigned position
+				typedef ArityType* ChoiceFunctionType; // serves as choiceFunction: rhs -> {1...arity}
+																							 // a |-> 0 means that a is not assigned position
+																							 // (an array in the arena of the length of rhs)
 
-				typedef std::pair<ChoiceFunctionType, OrNode*> ChoiceFunctionNodeType;
+				struct ChoiceFunctionNodeType
+				{
+					ChoiceFunctionType first;
+					OrNode* second;
+				};
 
+				/**
+				 * And node of the tree, all arrays of the node are stored in the arena
+				 * of the inclusion checking functor
+				 */
 				struct AndNode
 				{
-				private:
-
-					AndNode(const AndNode&);
-					AndNode& operator=(const AndNode&);
-
-				public:
 					OrNode* parent_;
-					std::vector<ChoiceFunctionNodeType> choiceFunctions_;
-
-					AndNode(OrNode* parent, ArityType arity, size_t size)
-						: parent_(parent),
-							choiceFunctions_(arity, ChoiceFunctionNodeType(ChoiceFunctionType(size, 0), static_cast<OrNode*>(0)))
-					{ }
-
-					AndNode(OrNode* parent, ArityType arity, const ChoiceFunctionType& cf)
-						: parent_(parent),
-							choiceFunctions_(arity, ChoiceFunctionNodeType(cf, static_cast<OrNode*>(0)))
-					{ }
+					ChoiceFunctionNodeType* choiceFunctions_;
+					size_t numChoiceFunctions_;
 
 					friend std::ostream& operator<<(std::ostream& os, const AndNode& node)
 					{
 						os << "(And";
 
-						for (typename std::vector<ChoiceFunctionNodeType>::const_iterator itCfs
-							= node.choiceFunctions_.begin(); itCfs != node.choiceFunctions_.end();
-							++itCfs)
+						for (size_t i = 0; i < node.numChoiceFunctions_; ++i)
 						{
-							os << " " << ((itCfs->second == static_cast<OrNode*>(0))? "_|_" : Convert::ToString(itCfs->second));
+							const OrNode* orNode = node.choiceFunctions_[i].second;
+							os << " " << ((orNode == static_cast<OrNode*>(0))? "_|_" : Convert::ToString(orNode));
 						}
 
 						os << ")";
 
-						os << ")";
-
 						return os;
 					}
 				};
 
-				struct HasherNnary
+				// Or nodes with fewer disjuncts (i.e. with fewer tuples of the bigger
+				// states left to be assigned) go first
+				struct OrNodePriority
+				{
+					size_t operator()(const OrNode* orNode) const
+					{
+						return orNode->numDisjuncts_;
+					}
+				};
+
+				typedef SFTA::Private::Worklist<OrNode*, OrNodePriority> OrNodeWorklistType;
+
+				struct HasherChoiceFunction
 				{
+					size_t size_;
+
+					explicit HasherChoiceFunction(size_t size)
+						: size_(size)
+					{ }
+
 					size_t operator()(const ChoiceFunctionType& key) const
 					{
-						return boost::hash_range(key.begin(), key.end());
+						return boost::hash_range(key, key + size_);
+					}
+				};
+
+				struct EqualChoiceFunction
+				{
+					size_t size_;
+
+					explicit EqualChoiceFunction(size_t size)
+						: size_(size)
+					{ }
+
+					bool operator()(const ChoiceFunctionType& lhs,
+						const ChoiceFunctionType& rhs) const
+					{
+						return std::equal(lhs, lhs + size_, rhs);
 					}
 				};
 
@@ -360,135 +475,265 @@ public:   // Public data types
 			const Type* smallerAut_;
 			const Type* biggerAut_;
 
-			StateToStateSetListHashTableType workset_;
-			StateToStateSetListHashTableType includedNodes_;
-			StateToStateSetListHashTableType nonincludedNodes_;
+			AntichainType workset_;
+			AntichainType includedNodes_;
+
+			// for each noninclusion cached for a set of states, the set of all
+			// states simulated by the set is stored
+			AntichainType nonincludedNodes_;
 
 			const SimulationRelationType* simSmaller_;
 			const SimulationRelationType* simBigger_;
 
+			// cached operation for union of right-hand sides
+			OperationIdType unionOperation_;
+
+			// unions of right-hand sides are kept until the end of the check, so
+			// that the results of the cached operation stay valid
+			RootArenaType unionRoots_;
+
+			// the arena for nodes of And/Or trees of the children checks
+			SFTA::Private::MemoryArena nodeArena_;
+
+			// the order of processing of nodes of And/Or trees
+			WorklistStrategy strategy_;
+
+			// the number of expanded pairs
+			size_t processedPairs_;
+
+			// records of noninclusions, the numbers of the records are stored in
+			// the elements of 'nonincludedNodes_'
+			FailureRecordVectorType failures_;
+
+			// the record of the last disjunct refuted by expandSubset()
+			size_t lastFailure_;
+
+			// the tree witnessing that the inclusion does not hold
+			WitnessTreeType witness_;
+
 		private:  // Private methods
 
 			InclusionCheckingFunctor(const InclusionCheckingFunctor&);
 			InclusionCheckingFunctor& operator=(const InclusionCheckingFunctor&);
 
-			template <class T>
-			bool forallExists(const T& smaller, const T& bigger,
-				const SimulationRelationType& sim) const
+
+			/**
+			 * the number meaning that there is no record of a noninclusion (e.g.
+			 * because a subtree could not be found)
+			 */
+			static inline size_t noFailure()
 			{
-				// ASSUME that elements of smaller and bigger are sorted
+				return std::numeric_limits<size_t>::max();
+			}
 
-				// pro kazdy prvek ze smaller si nactu sim(smaller) a divam se, jestli
-				// prunik s bigger je neprazdny
 
-				for (typename T::const_iterator itSmaller = smaller.begin();
-					itSmaller != smaller.end(); ++itSmaller)
-				{
-					const std::set<StateType>& smallerSims = sim.GetSimulators(*itSmaller);
+			/**
+			 * @brief  Adds a record of a noninclusion
+			 *
+			 * @param[in]  disjunct      The refuted disjunct
+			 * @param[in]  tuple         The tuple of children of the state
+			 * @param[in]  biggerTuples  The tuples of the set of states
+			 * @param[in]  children      The records of the children
+			 *
+			 * @returns  The number of the record, or noFailure() if the record of
+			 *           some child is missing
+			 */
+			size_t addFailure(const DisjunctType& disjunct, const TupleType& tuple,
+				const LeafType& biggerTuples, const FailureNumberVectorType& children)
+			{
+				if (std::find(children.begin(), children.end(), noFailure()) !=
+					children.end())
+				{	// in case some subtree is missing
+					return noFailure();
+				}
 
-					typename std::set<StateType>::const_iterator itSmallerSim = smallerSims.begin();
-					typename T::const_iterator itBigger = bigger.begin();
+				failures_.push_back(FailureRecord(disjunct, tuple, biggerTuples, children));
+				return failures_.size() - 1;
+			}
 
-					while (true)
-					{
-						if ((itBigger == bigger.end()) || itSmallerSim == smallerSims.end())
-						{
-							return false;
-						}
-						else if (*itSmallerSim == *itBigger)
-						{
-							break;
-						}
-						else if (*itSmallerSim < *itBigger)
-						{
-							++itSmallerSim;
-						}
-						else
-						{
-							++itBigger;
-						}
-					}
+
+			/**
+			 * @brief  Finds a record of a noninclusion
+			 *
+			 * Finds the record of a cached noninclusion that implies the
+			 * noninclusion of given disjunct. A disjunct with the empty set of
+			 * states need not have been checked, so it is expanded if nothing is
+			 * cached for its state.
+			 *
+			 * @param[in]  disjunct  The disjunct
+			 *
+			 * @returns  The number of the record, or noFailure() if there is none
+			 */
+			size_t findFailure(const DisjunctType& disjunct)
+			{
+				const typename AntichainType::Element* element =
+					nonincludedNodes_.FindSupersetOf(disjunct.first, disjunct.second);
+
+				if ((element == static_cast<const typename AntichainType::Element*>(0))
+					&& disjunct.second.empty() && !expandDisjunct(disjunct))
+				{	// in case the language of the state was not needed before
+					element = nonincludedNodes_.FindSupersetOf(disjunct.first,
+						disjunct.second);
 				}
 
-				return true;
+				if (element == static_cast<const typename AntichainType::Element*>(0))
+				{
+					return noFailure();
+				}
+
+				return element->number;
 			}
 
 
-			bool isInclusionCached(const DisjunctType& disjunct) const
+			/**
+			 * @brief  Unites roots of the bigger automaton
+			 *
+			 * The roots of the union and of its intermediate results are owned by
+			 * the functor and released when it is destroyed.
+			 *
+			 * @param[in]  states  The set of states of the bigger automaton
+			 *
+			 * @returns  The union of the roots of the states
+			 */
+			RootType uniteBiggerRoots(const StateSetType& states)
 			{
-				// check whether there exists some state in disjunct.second that
-				// simulates disjunct.first
-				for (typename StateSetType::const_iterator itDis = disjunct.second.begin();
-					itDis != disjunct.second.end(); ++itDis)
+				SharedMTBDDType* mtbdd = smallerAut_->GetTTWrapper()->GetMTBDD();
+
+				RootType unionBigger = unionRoots_.Add(mtbdd->CreateRoot());
+				UnionApplyFunctor unionFunc;
+
+				for (typename StateSetType::const_iterator itBiggerStates =
+					states.begin(); itBiggerStates != states.end(); ++itBiggerStates)
 				{
-					if (simSmaller_->is_in(std::make_pair(disjunct.first, *itDis)))
-					{
-						if (biggerAut_->getStates().find(*itDis) != biggerAut_->getStates().end())
-						{
-							return true;
-						}
-					}
+					RootType biggerRoot = biggerAut_->getRoot(*itBiggerStates);
+					unionBigger = unionRoots_.Add(mtbdd->Apply(unionBigger,
+						biggerRoot, &unionFunc, unionOperation_));
 				}
 
-				// TODO: search for smaller sets
-				typename StateToStateSetListHashTableType::const_iterator itHashTable;
-				if ((itHashTable = includedNodes_.find(disjunct.first)) != includedNodes_.end())
+				return unionBigger;
+			}
+
+
+			/**
+			 * @brief  Adds a noninclusion to the witness tree
+			 *
+			 * Adds the subtree refuting the disjunct of given record to the witness
+			 * tree. The symbol of the root of the subtree is found by a single
+			 * Apply on the roots of the disjunct.
+			 *
+			 * @param[in]  failure  The number of the record
+			 * @param[in]  nodes    Nodes of already added records
+			 *
+			 * @returns  The index of the node of the record in the witness tree
+			 */
+			size_t addWitnessNode(size_t failure, FailureNumberVectorType& nodes)
+			{
+				assert(failure < failures_.size());
+
+				if (nodes[failure] != noFailure())
+				{	// in case the subtree has already been added
+					return nodes[failure];
+				}
+
+				const FailureRecord& record = failures_[failure];
+
+				typename WitnessTreeType::ChildrenType children;
+				for (typename FailureNumberVectorType::const_iterator itChildren =
+					record.children.begin(); itChildren != record.children.end();
+					++itChildren)
 				{
-					const StateSetListType& listOfStateSets = itHashTable->second;
+					children.push_back(addWitnessNode(*itChildren, nodes));
+				}
 
-					for (typename StateSetListType::const_iterator itInclNodes = listOfStateSets.begin();
-						itInclNodes != listOfStateSets.end(); ++itInclNodes)
-					{
-						if (forallExists(*itInclNodes, disjunct.second, *simBigger_))
-						{
-							return true;
-						}
+				SharedMTBDDType* mtbdd = smallerAut_->GetTTWrapper()->GetMTBDD();
+
+				WitnessApplyFunctor witnessFunc(record);
+				RootType witnessRoot = mtbdd->Apply(
+					smallerAut_->getRoot(record.disjunct.first),
+					uniteBiggerRoots(record.disjunct.second), &witnessFunc);
+
+				typedef typename SharedMTBDDType::DescriptionType DescriptionType;
+				DescriptionType description = mtbdd->GetMinimumDescription(witnessRoot);
+				mtbdd->EraseRoot(witnessRoot);
+
+				for (typename DescriptionType::const_iterator itDesc = description.begin();
+					itDesc != description.end(); ++itDesc)
+				{
+					if (!itDesc->second.empty())
+					{	// in case the symbol refutes the disjunct
+						nodes[failure] = witness_.AddNode(itDesc->first, children);
+						return nodes[failure];
 					}
 				}
 
-				return false;
+				throw std::runtime_error(__func__ +
+					std::string(": cannot find a symbol of disjunct ") +
+					Convert::ToString(record.disjunct));
 			}
 
-			bool isNoninclusionCached(const DisjunctType& disjunct) const
+
+			/**
+			 * @brief  Builds the witness tree
+			 *
+			 * Builds the tree refuting the disjunct of given record. The tree stays
+			 * empty if there is no record.
+			 *
+			 * @param[in]  failure  The number of the record
+			 */
+			void buildWitness(size_t failure)
 			{
-				// TODO: search for bigger sets
-				typename StateToStateSetListHashTableType::const_iterator itHashTable;
-				if ((itHashTable = nonincludedNodes_.find(disjunct.first)) != nonincludedNodes_.end())
-				{
-					const StateSetListType& listOfStateSets = itHashTable->second;
+				witness_.Clear();
 
-					for (typename StateSetListType::const_iterator itNoninclNodes = listOfStateSets.begin();
-						itNoninclNodes != listOfStateSets.end(); ++itNoninclNodes)
-					{
-						if (forallExists(disjunct.second, *itNoninclNodes, *simBigger_))
-						{
-							return true;
-						}
-					}
+				if (failure == noFailure())
+				{	// in case some subtree could not be found
+					SFTA_LOGGER_WARN("Witness of noninclusion is not available");
+					return;
 				}
 
-				return false;
+				FailureNumberVectorType nodes(failures_.size(), noFailure());
+				witness_.SetRoot(addWitnessNode(failure, nodes));
 			}
 
-			bool isImpliedByWorkset(const DisjunctType& disjunct) const
+			template <class T>
+			bool forallExists(const T& smaller, const T& bigger,
+				const SimulationRelationType& sim) const
 			{
-				// TODO: search for smaller sets
-				typename StateToStateSetListHashTableType::const_iterator itHashTable;
-				if ((itHashTable = workset_.find(disjunct.first)) != workset_.end())
-				{
-					const StateSetListType& listOfStateSets = itHashTable->second;
+				return sim.IsEachSimulatedByAny(smaller, sim.CreateBitSet(bigger));
+			}
+
 
-					for (typename StateSetListType::const_iterator itWorkset = listOfStateSets.begin();
-						itWorkset != listOfStateSets.end(); ++itWorkset)
+			bool isInclusionCached(const DisjunctType& disjunct) const
+			{
+				// check whether there exists some state in disjunct.second that
+				// simulates disjunct.first
+				for (typename StateSetType::const_iterator itDis = disjunct.second.begin();
+					itDis != disjunct.second.end(); ++itDis)
+				{
+					if (simSmaller_->is_in(std::make_pair(disjunct.first, *itDis)))
 					{
-						if (forallExists(*itWorkset, disjunct.second, *simBigger_))
+						if (biggerAut_->getStates().find(*itDis) != biggerAut_->getStates().end())
 						{
 							return true;
 						}
 					}
 				}
 
-				return false;
+				// a cached set is simulated by 'disjunct.second' iff it is a subset of
+				// the states simulated by 'disjunct.second'
+				return includedNodes_.ContainsSubsetOf(disjunct.first,
+					simBigger_->GetSimulatedByAny(disjunct.second));
+			}
+
+			bool isNoninclusionCached(const DisjunctType& disjunct) const
+			{
+				return nonincludedNodes_.ContainsSupersetOf(disjunct.first,
+					disjunct.second);
+			}
+
+			bool isImpliedByWorkset(const DisjunctType& disjunct) const
+			{
+				return workset_.ContainsSubsetOf(disjunct.first,
+					simBigger_->GetSimulatedByAny(disjunct.second));
 			}
 
 			bool isImpliedByChildren(const DisjunctListType& children,
@@ -512,36 +757,16 @@ public:   // Public data types
 
 			void addToWorkset(const DisjunctType& disjunct)
 			{
-				typename StateToStateSetListHashTableType::iterator itHashTable;
-				if ((itHashTable = workset_.find(disjunct.first)) == workset_.end())
-				{
-					StateSetListType newList;
-					itHashTable = workset_.insert(workset_.end(),
-						std::make_pair(disjunct.first, newList));
-				}
-
-				itHashTable->second.push_back(disjunct.second);
+				workset_.Insert(disjunct.first, 0, disjunct.second);
 			}
 
 			void removeFromWorkset(const DisjunctType& disjunct)
 			{
-				typename StateToStateSetListHashTableType::iterator itHashTable;
-				if ((itHashTable = workset_.find(disjunct.first)) == workset_.end())
-				{
-					throw std::runtime_error(__func__ +
-						std::string(": an attempt to remove non-existing state"));
-				}
-
-				StateSetListType& stateSetList = itHashTable->second;
-				typename StateSetListType::iterator itStateSetList;
-				if ((itStateSetList = std::find(stateSetList.begin(), stateSetList.end(),
-					disjunct.second)) == stateSetList.end())
+				if (!workset_.Erase(disjunct.first, disjunct.second))
 				{
 					throw std::runtime_error(__func__ +
 						std::string(": an attempt to remove non-existing state set"));
 				}
-
-				stateSetList.erase(itStateSetList);
 			}
 
 			void addToChildren(DisjunctListType& children,
@@ -553,30 +778,23 @@ public:   // Public data types
 
 			void cacheInclusion(const DisjunctType& disjunct)
 			{
-				// TODO: remove bigger sets??
-				typename StateToStateSetListHashTableType::iterator itHashTable;
-				if ((itHashTable = includedNodes_.find(disjunct.first)) == includedNodes_.end())
-				{
-					StateSetListType newList;
-					itHashTable = includedNodes_.insert(includedNodes_.end(),
-						std::make_pair(disjunct.first, newList));
+				if (!includedNodes_.ContainsSubsetOf(disjunct.first, disjunct.second))
+				{	// in case the inclusion is not implied by a cached one
+					std::vector<size_t> erased;
+					includedNodes_.EraseSupersetsOf(disjunct.first, disjunct.second, erased);
+					includedNodes_.Insert(disjunct.first, 0, disjunct.second);
 				}
-
-				itHashTable->second.push_back(disjunct.second);
 			}
 
-			void cacheNoninclusion(const DisjunctType& disjunct)
+			void cacheNoninclusion(const DisjunctType& disjunct, size_t failure)
 			{
-				// TODO: remove smaller sets??
-				typename StateToStateSetListHashTableType::iterator itHashTable;
-				if ((itHashTable = nonincludedNodes_.find(disjunct.first)) == nonincludedNodes_.end())
-				{
-					StateSetListType newList;
-					itHashTable = nonincludedNodes_.insert(nonincludedNodes_.end(),
-						std::make_pair(disjunct.first, newList));
-				}
+				StateSetType simulated(simBigger_->GetSimulatedByAny(disjunct.second));
 
-				itHashTable->second.push_back(disjunct.second);
+				if (!nonincludedNodes_.ContainsSupersetOf(disjunct.first, simulated))
+				{	// in case the noninclusion is not implied by a cached one
+					nonincludedNodes_.EraseSubsetsOf(disjunct.first, simulated);
+					nonincludedNodes_.Insert(disjunct.first, failure, simulated);
+				}
 			}
 
 			bool expandDisjunct(const DisjunctType& disjunct)
@@ -600,27 +818,13 @@ public:   // Public data types
 				}
 				else
 				{
-					cacheNoninclusion(disjunct);
+					cacheNoninclusion(disjunct, lastFailure_);
 					return false;
 				}
 			}
 
 			bool expandSubset(const DisjunctType& disjunct)
 			{
-				class UnionApplyFunctor
-					: public SharedMTBDDType::AbstractApplyFunctorType
-				{
-				public:
-
-					virtual LeafType operator()(const LeafType& lhs, const LeafType& rhs)
-					{
-						LeafType result = lhs;
-						result.insert(rhs);
-
-						return result;
-					}
-				};
-
 				class ChildrenCollectorFunctor
 					: public SharedMTBDDType::AbstractApplyFunctorType
 				{
@@ -630,6 +834,18 @@ public:   // Public data types
 
 					InclusionCheckingFunctor* inclFunc_;
 
+					// the disjunct whose children are collected
+					const DisjunctType& disjunct_;
+
+					// the record of the noninclusion of the disjunct
+					size_t failure_;
+
+					// the arena the nodes of the And/Or tree are allocated in
+					SFTA::Private::MemoryArena& arena_;
+
+					// the length of choice functions in the current tree
+					size_t cfSize_;
+
 				private:
 
 					ChildrenCollectorFunctor(const ChildrenCollectorFunctor&);
@@ -637,9 +853,14 @@ public:   // Public data types
 
 				public:
 
-					ChildrenCollectorFunctor(InclusionCheckingFunctor* inclFunc)
+					ChildrenCollectorFunctor(InclusionCheckingFunctor* inclFunc,
+						const DisjunctType& disjunct)
 						: doesInclusionHold_(true),
-							inclFunc_(inclFunc)
+							inclFunc_(inclFunc),
+							disjunct_(disjunct),
+							failure_(noFailure()),
+							arena_(inclFunc->nodeArena_),
+							cfSize_(0)
 					{ }
 
 					inline bool DoesInclusionHold()
@@ -647,86 +868,128 @@ public:   // Public data types
 						return doesInclusionHold_;
 					}
 
+					inline size_t GetFailure() const
+					{
+						return failure_;
+					}
+
 
 					/**
-					 * removes 'orNode', 'callerParent' is the parent AndNode that
-					 * deallocates 'orNode'
+					 * creates a copy of the choice function 'cf' in the arena
 					 */
-					void recursivelyDeallocate(OrNode* orNode, AndNode* callerParent)
+					ChoiceFunctionType copyChoiceFunction(const ChoiceFunctionType& cf)
 					{
-						if (orNode != static_cast<OrNode*>(0))
+						ChoiceFunctionType result = arena_.AllocateArray<ArityType>(cfSize_);
+						std::copy(cf, cf + cfSize_, result);
+
+						return result;
+					}
+
+
+					/**
+					 * creates an OrNode with room for 'numDisjuncts' AndNodes
+					 */
+					OrNode* createOrNode(AndNode* parent, size_t numDisjuncts)
+					{
+						OrNode* orNode = arena_.Create<OrNode>();
+						orNode->disjuncts_ = arena_.AllocateArray<AndNode*>(numDisjuncts);
+
+						if (parent != static_cast<AndNode*>(0))
 						{
-							if (callerParent != static_cast<AndNode*>(0))
-							{	// in case 'orNode' is not the root, remove 'orNode' reference from
-								// all its parents other than 'callerParent'
-								assert(!callerParent->choiceFunctions_.empty());
-
-								bool foundParent = false;
-								for (typename std::vector<AndNode*>::iterator itPar
-									= orNode->parents_.begin();
-									itPar != orNode->parents_.end(); ++itPar)
-								{
-									AndNode* parentAnd = *itPar;
-									assert(parentAnd != static_cast<AndNode*>(0));
+							addParent(orNode, parent);
+						}
 
-									if (parentAnd == callerParent)
-									{	// do not remove from this one
-										foundParent = true;
-									}
-									else
-									{
-										bool foundOrNode = false;
-										for (typename std::vector<ChoiceFunctionNodeType>::iterator itCf
-											= parentAnd->choiceFunctions_.begin();
-											itCf != parentAnd->choiceFunctions_.end(); ++itCf)
-										{
-											OrNode* tmpOrNode = itCf->second;
-											assert(tmpOrNode != static_cast<OrNode*>(0));
-
-											if (orNode == tmpOrNode)
-											{
-												foundOrNode = true;
-												parentAnd->choiceFunctions_.erase(itCf);
-												break;
-											}
-										}
+						return orNode;
+					}
 
-										assert(foundOrNode);
-									}
-								}
 
-								assert(foundParent);
-							}
+					/**
+					 * creates an AndNode with 'arity' copies of the choice function 'cf'
+					 */
+					AndNode* createAndNode(OrNode* parent, ArityType arity,
+						const ChoiceFunctionType& cf)
+					{
+						AndNode* andNode = arena_.Create<AndNode>();
+						andNode->parent_ = parent;
+						andNode->choiceFunctions_ =
+							arena_.AllocateArray<ChoiceFunctionNodeType>(arity);
+						andNode->numChoiceFunctions_ = arity;
 
-							for (typename std::vector<AndNode*>::iterator itDis
-								= orNode->disjuncts_.begin();
-								itDis != orNode->disjuncts_.end(); ++itDis)
-							{
-								AndNode* andNode = *itDis;
-								assert(andNode != static_cast<AndNode*>(0));
+						for (size_t i = 0; i < arity; ++i)
+						{
+							andNode->choiceFunctions_[i].first = copyChoiceFunction(cf);
+							andNode->choiceFunctions_[i].second = static_cast<OrNode*>(0);
+						}
 
-								for (typename std::vector<ChoiceFunctionNodeType>::iterator itCfs
-									= andNode->choiceFunctions_.begin();
-									itCfs != andNode->choiceFunctions_.end(); ++itCfs)
-								{	// deallocate children of the AndNode
-									recursivelyDeallocate(itCfs->second, andNode);
-								}
+						return andNode;
+					}
+
+					void addParent(OrNode* orNode, AndNode* parent)
+					{
+						if (orNode->numParents_ == orNode->parentsCapacity_)
+						{	// in case the array is full, move the parents to a bigger one (the
+							// old array is released together with the tree)
+							size_t capacity = (orNode->parentsCapacity_ == 0)?
+								2 : 2 * orNode->parentsCapacity_;
+							AndNode** parents = arena_.AllocateArray<AndNode*>(capacity);
+							std::copy(orNode->parents_, orNode->parents_ + orNode->numParents_,
+								parents);
+
+							orNode->parents_ = parents;
+							orNode->parentsCapacity_ = capacity;
+						}
+
+						orNode->parents_[orNode->numParents_++] = parent;
+					}
 
-								delete andNode;
+					void removeParent(OrNode* orNode, AndNode* parent)
+					{
+						for (size_t i = 0; i < orNode->numParents_; ++i)
+						{
+							if (orNode->parents_[i] == parent)
+							{
+								std::copy(orNode->parents_ + i + 1,
+									orNode->parents_ + orNode->numParents_, orNode->parents_ + i);
+								--orNode->numParents_;
+								return;
 							}
+						}
 
-							delete orNode;
+						assert(false);
+					}
+
+					void removeChoiceFunction(AndNode* andNode, size_t index)
+					{
+						assert(index < andNode->numChoiceFunctions_);
+
+						std::copy(andNode->choiceFunctions_ + index + 1,
+							andNode->choiceFunctions_ + andNode->numChoiceFunctions_,
+							andNode->choiceFunctions_ + index);
+						--andNode->numChoiceFunctions_;
+					}
+
+					void removeChoiceFunction(AndNode* andNode, const OrNode* orNode)
+					{
+						for (size_t i = 0; i < andNode->numChoiceFunctions_; ++i)
+						{
+							if (andNode->choiceFunctions_[i].second == orNode)
+							{
+								removeChoiceFunction(andNode, i);
+								return;
+							}
 						}
+
+						assert(false);
 					}
 
 					bool isOrNodeLeaf(const OrNode* orNode)
 					{
 						assert(orNode != static_cast<OrNode*>(0));
 
-						if (!orNode->disjuncts_.empty())
+						if (orNode->numDisjuncts_ != 0)
 						{
 							assert(orNode->disjuncts_[0] != static_cast<AndNode*>(0));
-							assert(!orNode->disjuncts_[0]->choiceFunctions_.empty());
+							assert(orNode->disjuncts_[0]->numChoiceFunctions_ != 0);
 
 							return (orNode->disjuncts_[0]->choiceFunctions_[0].second
 								== static_cast<OrNode*>(0));
@@ -737,51 +1000,33 @@ public:   // Public data types
 						}
 					}
 
+					/**
+					 * disconnects the subtree of 'orNode' if 'orNode' has no parents, the
+					 * nodes of the subtree stay in the arena until the tree is released
+					 */
 					void markForNotProcessing(OrNode* orNode)
 					{
 						assert(orNode != static_cast<OrNode*>(0));
-						if (orNode->parents_.empty())
+						if (orNode->numParents_ == 0)
 						{
 							if (!isOrNodeLeaf(orNode))
-							{	// leaf nodes cannot be deleted (as they are in the queue)
-								for (typename std::vector<AndNode*>::iterator itDis
-									= orNode->disjuncts_.begin();
-									itDis != orNode->disjuncts_.end(); ++itDis)
+							{	// leaf nodes are left alone (as they are in the queue)
+								for (size_t i = 0; i < orNode->numDisjuncts_; ++i)
 								{
-									AndNode* andNode = *itDis;
+									AndNode* andNode = orNode->disjuncts_[i];
 									assert(andNode != static_cast<AndNode*>(0));
 
-									for (typename std::vector<ChoiceFunctionNodeType>::iterator itCf
-										= andNode->choiceFunctions_.begin();
-										itCf != andNode->choiceFunctions_.end(); ++itCf)
+									for (size_t j = 0; j < andNode->numChoiceFunctions_; ++j)
 									{
-										OrNode* lowerOrNode = itCf->second;
+										OrNode* lowerOrNode = andNode->choiceFunctions_[j].second;
 										assert(lowerOrNode != static_cast<OrNode*>(0));
 
 										// remove 'andNode' from parents of 'lowerOrNode'
-										bool found = false;
-										for (typename std::vector<AndNode*>::iterator itPar
-											= lowerOrNode->parents_.begin();
-											itPar != lowerOrNode->parents_.end(); ++itPar)
-										{
-											assert(*itPar != static_cast<AndNode*>(0));
-											if (*itPar == andNode)
-											{
-												found = true;
-												lowerOrNode->parents_.erase(itPar);
-												break;
-											}
-										}
-
-										assert(found);
+										removeParent(lowerOrNode, andNode);
 
 										markForNotProcessing(lowerOrNode);
 									}
-
-									delete andNode;
 								}
-
-								delete orNode;
 							}
 						}
 					}
@@ -801,238 +1046,286 @@ public:   // Public data types
 						//
 						// downwards processing 
 						//
-						for (typename std::vector<AndNode*>::iterator itDis
-							= orNode->disjuncts_.begin(); itDis != orNode->disjuncts_.end();
-							++itDis)
+						for (size_t i = 0; i < orNode->numDisjuncts_; ++i)
 						{	// for every child AndNode 'andNode'
-							AndNode* andNode = *itDis;
+							AndNode* andNode = orNode->disjuncts_[i];
 							assert(andNode != static_cast<AndNode*>(0));
 
-							for (typename std::vector<ChoiceFunctionNodeType>::iterator itCf
-								= andNode->choiceFunctions_.begin();
-								itCf != andNode->choiceFunctions_.end(); ++itCf)
+							for (size_t j = 0; j < andNode->numChoiceFunctions_; ++j)
 							{
 								// for every child OrNode 'tmpOrNode' of 'andNode'
-								OrNode* tmpOrNode = itCf->second;
+								OrNode* tmpOrNode = andNode->choiceFunctions_[j].second;
 
 								if (tmpOrNode != static_cast<OrNode*>(0))
 								{
 									// remove 'andNode' from parents of 'tmpOrNode'
-									bool found = false;
-									for (typename std::vector<AndNode*>::iterator itPar
-										= tmpOrNode->parents_.begin();
-										itPar != tmpOrNode->parents_.end(); ++itPar)
-									{
-										if (*itPar == andNode)
-										{
-											found = true;
-											tmpOrNode->parents_.erase(itPar);
-											break;
-										}
-									}
+									removeParent(tmpOrNode, andNode);
+									markForNotProcessing(tmpOrNode);
+								}
+							}
+						}
+
+						//
+						// upwards processing 
+						//
+						if (orNode->numParents_ == 0)
+						{	// this should be the root node
+							return true;
+						}
+
+						for (size_t i = 0; i < orNode->numParents_; ++i)
+						{	// traverse the set of parents 'parAndNode' of 'orNode'
+							AndNode* parAndNode = orNode->parents_[i];
+							assert(parAndNode != static_cast<AndNode*>(0));
+							assert(parAndNode->parent_ != static_cast<OrNode*>(0));
+
+							// remove 'orNode' from children of 'parAndNode'
+							removeChoiceFunction(parAndNode, orNode);
+
+							if (parAndNode->numChoiceFunctions_ == 0)
+							{	// in case we also satisfied the abovelying layer
+								result = satisfyNode(parAndNode->parent_);
+							}
+						}
+
+						return result;
+					}
+
+
+					/**
+					 * collects records of noninclusions of the children at all positions
+					 * of the choice function 'cf', fails if 'cf' is not total or if some
+					 * record is missing
+					 */
+					bool collectFailures(const ChoiceFunctionType& cf,
+						const std::vector<StateType>& sm,
+						const std::vector<SFTA::Private::ElemOrVector<StateType> >& bigger,
+						FailureNumberVectorType& failures)
+					{
+						if (std::find(cf, cf + cfSize_, 0) != cf + cfSize_)
+						{	// in case some tuple is not assigned a position
+							return false;
+						}
+
+						failures.clear();
+						for (size_t position = 0; position < sm.size(); ++position)
+						{
+							StateSetType subset;
+							for (size_t i = 0; i < cfSize_; ++i)
+							{	// collect items in the choice function assigned to 'position'
+								if (cf[i] == position + 1)
+								{
+									subset.insert(bigger[i].GetVector()[position]);
+								}
+							}
+
+							size_t failure = inclFunc_->findFailure(
+								std::make_pair(sm[position], subset));
+							if (failure == noFailure())
+							{
+								return false;
+							}
+
+							failures.push_back(failure);
+						}
+
+						return true;
+					}
+
 
-									assert(found);
-									markForNotProcessing(tmpOrNode);
-								}
-							}
+					/**
+					 * searches the unsatisfied part of the tree for a total choice
+					 * function such that the inclusion fails at all positions and collects
+					 * the records of the noninclusions, i.e. the children of the witness
+					 */
+					bool findFailingChoiceFunction(const OrNode* orNode,
+						const std::vector<StateType>& sm,
+						const std::vector<SFTA::Private::ElemOrVector<StateType> >& bigger,
+						std::set<const OrNode*>& visited, FailureNumberVectorType& failures)
+					{
+						assert(orNode != static_cast<OrNode*>(0));
 
-							delete andNode;
+						if (!visited.insert(orNode).second)
+						{	// in case the Or node has already been searched
+							return false;
 						}
 
-						//
-						// upwards processing 
-						//
-						if (orNode->parents_.empty())
-						{	// this should be the root node
-							delete orNode;
-							return true;
-						}
+						for (size_t i = 0; i < orNode->numDisjuncts_; ++i)
+						{	// for every child AndNode 'andNode'
+							const AndNode* andNode = orNode->disjuncts_[i];
+							assert(andNode != static_cast<AndNode*>(0));
 
-						for (typename std::vector<AndNode*>::iterator itParAnds
-							= orNode->parents_.begin(); itParAnds != orNode->parents_.end();
-							++itParAnds)
-						{	// traverse the set of parents 'parAndNode' of 'orNode'
-							AndNode* parAndNode = *itParAnds;
-							assert(parAndNode != static_cast<AndNode*>(0));
-							assert(parAndNode->parent_ != static_cast<OrNode*>(0));
+							for (size_t j = 0; j < andNode->numChoiceFunctions_; ++j)
+							{	// for every position where the inclusion does not hold
+								const ChoiceFunctionNodeType& cfNode = andNode->choiceFunctions_[j];
 
-							// remove 'orNode' from children of 'parAndNode'
-							bool found = false;
-							for (typename std::vector<ChoiceFunctionNodeType>::iterator itParChild
-								= parAndNode->choiceFunctions_.begin();
-								itParChild != parAndNode->choiceFunctions_.end(); ++itParChild)
-							{
-								if (itParChild->second == orNode)
+								if (cfNode.second == static_cast<OrNode*>(0))
+								{	// in case there is no Or node below
+									if (collectFailures(cfNode.first, sm, bigger, failures))
+									{
+										return true;
+									}
+								}
+								else if (findFailingChoiceFunction(cfNode.second, sm, bigger,
+									visited, failures))
 								{
-									found = true;
-									parAndNode->choiceFunctions_.erase(itParChild);
-									break;
+									return true;
 								}
 							}
-
-							assert(found);
-
-							if (parAndNode->choiceFunctions_.empty())
-							{	// in case we also satisfied the abovelying layer
-								result = satisfyNode(parAndNode->parent_);
-							}
 						}
 
-						delete orNode;
-
-						return result;
+						return false;
 					}
 
 
 					bool checkInclusion(const std::vector<StateType>& sm,
-						const std::vector<SFTA::Private::ElemOrVector<StateType> >& bigger)
+						const std::vector<SFTA::Private::ElemOrVector<StateType> >& bigger,
+						FailureNumberVectorType& failures)
 					{
 						unsigned arity = sm.size();
 
-						// the workqueue
-						std::queue<OrNode*> nodeQueue;
+						// all nodes of the tree are allocated in the arena and released at
+						// once when the check is over
+						SFTA::Private::MemoryArena::MarkType arenaMark = arena_.GetMark();
+						cfSize_ = bigger.size();
+
+						// the worklist
+						OrNodeWorklistType nodeQueue(inclFunc_->strategy_);
 
 						// create the root nodes
-						OrNode* root = new OrNode();
-						root->disjuncts_.push_back(new AndNode(root, 1, bigger.size()));
+						ChoiceFunctionType emptyCf = arena_.AllocateArray<ArityType>(cfSize_);
+						std::fill(emptyCf, emptyCf + cfSize_, 0);
 
-						typedef std::tr1::unordered_map<ChoiceFunctionType, OrNode*, HasherNnary>
-						 	CFOrHashTableType;
-						CFOrHashTableType orNodeCache;
+						OrNode* root = createOrNode(static_cast<AndNode*>(0), 1);
+						root->disjuncts_[root->numDisjuncts_++] = createAndNode(root, 1, emptyCf);
 
-						nodeQueue.push(root);
+						typedef std::tr1::unordered_map<ChoiceFunctionType, OrNode*,
+							HasherChoiceFunction, EqualChoiceFunction> CFOrHashTableType;
+						CFOrHashTableType orNodeCache(0, HasherChoiceFunction(cfSize_),
+							EqualChoiceFunction(cfSize_));
+
+						nodeQueue.Push(root);
 
 						bool inclusionHolds = false;
-						while (!nodeQueue.empty())
+						while (!nodeQueue.IsEmpty())
 						{
-							OrNode* orNode = nodeQueue.front();
+							OrNode* orNode = nodeQueue.Pop();
 							assert(orNode != static_cast<OrNode*>(0));
 							assert(isOrNodeLeaf(orNode));
-							nodeQueue.pop();
 
-							if (orNode->parents_.empty() && orNode != root)
+							if ((orNode->numParents_ == 0) && (orNode != root))
 							{	// in case the Or node does not need processing
-								assert(isOrNodeLeaf(orNode));
-								for (typename std::vector<AndNode*>::iterator itDis
-									= orNode->disjuncts_.begin(); itDis != orNode->disjuncts_.end();
-									++itDis)
-								{
-									AndNode* andNode = *itDis;
-									assert(andNode != static_cast<AndNode*>(0));
+								continue;
+							}
 
-									delete andNode;
-								}
+							// in case the Or node needs processing
+							assert(!inclusionHolds);
 
-								delete orNode;
-							}
-							else
-							{	// in case the Or node needs processing
-								assert(!inclusionHolds);
-
-								for (typename std::vector<AndNode*>::const_iterator itDisjuncts
-									= orNode->disjuncts_.begin(); itDisjuncts != orNode->disjuncts_.end();
-									++itDisjuncts)
-								{	// for each disjunct in the Or
-									AndNode* andNode = *itDisjuncts;
-									assert(andNode != static_cast<AndNode*>(0));
-									assert(andNode->choiceFunctions_.size() > 0);
-
-									bool incrementIndex = true;
-									for (size_t index = 0, realPosition = 0;
-										index < andNode->choiceFunctions_.size();
-										index = incrementIndex? index+1 : index, ++realPosition)
-									{ // Note: 'index' is the pointer into the array
-										// andNode->choiceFunctions_ and 'realPosition' is the
-										// absolute position of the AndNode
-										incrementIndex = true;
-
-										const ChoiceFunctionType& cf = andNode->choiceFunctions_[index].first;
-										assert(andNode->choiceFunctions_[index].second == static_cast<OrNode*>(0));
-
-										StateSetType subset;
-										for (size_t i = 0; i < cf.size(); ++i)
-										{	// collect items in the choice function assigned to 'index'-th position
-											if (cf[i] == realPosition + 1)
-											{
-												subset.insert(bigger[i].GetVector()[realPosition]);
-											}
+							for (size_t disjunct = 0; disjunct < orNode->numDisjuncts_; ++disjunct)
+							{	// for each disjunct in the Or
+								AndNode* andNode = orNode->disjuncts_[disjunct];
+								assert(andNode != static_cast<AndNode*>(0));
+								assert(andNode->numChoiceFunctions_ > 0);
+
+								bool incrementIndex = true;
+								for (size_t index = 0, realPosition = 0;
+									index < andNode->numChoiceFunctions_;
+									index = incrementIndex? index+1 : index, ++realPosition)
+								{ // Note: 'index' is the pointer into the array
+									// andNode->choiceFunctions_ and 'realPosition' is the
+									// absolute position of the AndNode
+									incrementIndex = true;
+
+									ChoiceFunctionType cf = andNode->choiceFunctions_[index].first;
+									assert(andNode->choiceFunctions_[index].second == static_cast<OrNode*>(0));
+
+									StateSetType subset;
+									for (size_t i = 0; i < cfSize_; ++i)
+									{	// collect items in the choice function assigned to 'index'-th position
+										if (cf[i] == realPosition + 1)
+										{
+											subset.insert(bigger[i].GetVector()[realPosition]);
 										}
+									}
 
-										if (inclFunc_->expandDisjunct(std::make_pair(sm[realPosition], subset)))
-										{	// in case the inclusion holds
-											incrementIndex = false;
-											andNode->choiceFunctions_.erase(andNode->choiceFunctions_.begin() + index);
+									if (inclFunc_->expandDisjunct(std::make_pair(sm[realPosition], subset)))
+									{	// in case the inclusion holds
+										incrementIndex = false;
+										removeChoiceFunction(andNode, index);
+									}
+									else
+									{	// in case the inclusion doesn't hold
+										typename CFOrHashTableType::const_iterator itCache;
+										if ((itCache = orNodeCache.find(cf)) != orNodeCache.end())
+										{	// in case the OrNode is already cached
+											OrNode* cachedOrNode = itCache->second;
+
+											if (cachedOrNode != static_cast<OrNode*>(0))
+											{	// in case we are not at leaves
+												andNode->choiceFunctions_[index].second = cachedOrNode;
+												addParent(cachedOrNode, andNode);
+											}
 										}
 										else
-										{	// in case the inclusion doesn't hold
-											typename CFOrHashTableType::const_iterator itCache;
-											if ((itCache = orNodeCache.find(andNode->choiceFunctions_[index].first))
-												!= orNodeCache.end())
-											{	// in case the OrNode is already cached
-												OrNode* cachedOrNode = itCache->second;
-
-												if (cachedOrNode != static_cast<OrNode*>(0))
-												{	// in case we are not at leaves
-													andNode->choiceFunctions_[index].second = cachedOrNode;
-													cachedOrNode->parents_.push_back(andNode);
-												}
-											}
-											else
-											{	// in case we haven't seen the OrNode yet
-												OrNode* newOrNode = new OrNode(andNode);
-												andNode->choiceFunctions_[index].second = newOrNode;
+										{	// in case we haven't seen the OrNode yet
+											size_t numNew = static_cast<size_t>(
+												std::count(cf, cf + cfSize_, 0));
+
+											OrNode* newOrNode = static_cast<OrNode*>(0);
+											if (numNew != 0)
+											{	// in case there are positions to be assigned
+												newOrNode = createOrNode(andNode, numNew);
 
-												bool foundNew = false;
-												for (size_t i = 0; i < cf.size(); ++i)
+												for (size_t i = 0; i < cfSize_; ++i)
 												{
 													if (cf[i] == 0)
 													{
-														foundNew = true;
-														AndNode* newAnd = new AndNode(newOrNode, arity, cf);
+														AndNode* newAnd = createAndNode(newOrNode, arity, cf);
 														for (size_t ind = 0; ind < arity; ++ind)
 														{
 															newAnd->choiceFunctions_[ind].first[i] = ind + 1;
 														}
 
-														assert(!newAnd->choiceFunctions_.empty());
-														newOrNode->disjuncts_.push_back(newAnd);
+														assert(newAnd->numChoiceFunctions_ != 0);
+														newOrNode->disjuncts_[newOrNode->numDisjuncts_++] = newAnd;
 													}
 												}
 
-												if (foundNew)
-												{
-													assert(!newOrNode->disjuncts_.empty());
-													nodeQueue.push(newOrNode);
-												}
-												else
-												{
-													assert(newOrNode->disjuncts_.empty());
-													delete newOrNode;
-													newOrNode = static_cast<OrNode*>(0);
-													andNode->choiceFunctions_[index].second = newOrNode;
-												}
-
-												orNodeCache.insert(std::make_pair(andNode->choiceFunctions_[index].first, newOrNode));
+												nodeQueue.Push(newOrNode);
 											}
-										}
-									}
 
-									if (andNode->choiceFunctions_.empty())
-									{	// in case the OrNode 'orNode' is satisfied by one AndNode
-										// (in this case 'andNode')
-										if (satisfyNode(orNode))
-										{
-											inclusionHolds = true;
-											root = static_cast<OrNode*>(0);
+											andNode->choiceFunctions_[index].second = newOrNode;
+											orNodeCache.insert(std::make_pair(cf, newOrNode));
 										}
+									}
+								}
 
-										break;
+								if (andNode->numChoiceFunctions_ == 0)
+								{	// in case the OrNode 'orNode' is satisfied by one AndNode
+									// (in this case 'andNode')
+									if (satisfyNode(orNode))
+									{
+										inclusionHolds = true;
+										root = static_cast<OrNode*>(0);
 									}
+
+									break;
 								}
 							}
 						}
 
-						recursivelyDeallocate(root, static_cast<AndNode*>(0));
+						if (!inclusionHolds)
+						{	// in case the inclusion does not hold, the children of the witness
+							// are found in the tree before it is released
+							std::set<const OrNode*> visited;
+							if (!findFailingChoiceFunction(root, sm, bigger, visited, failures))
+							{
+								failures.assign(1, noFailure());
+							}
+						}
+
+						// release the whole tree
+						arena_.Rewind(arenaMark);
 						return inclusionHolds;
 					}
 
@@ -1049,10 +1342,11 @@ public:   // Public data types
 
 						if (arity == 0)
 						{	// the ``smaller'' state can make a nullary transition
-							if (rhs.find(typename SFTA::Private::ElemOrVector<StateType>::VectorType())
-								== rhs.end())
+							if (rhs.find(TupleType()) == rhs.end())
 							{	// in case the ``bigger'' state cannot make such a transition
 								doesInclusionHold_ = false;
+								failure_ = inclFunc_->addFailure(disjunct_, TupleType(), rhs,
+									FailureNumberVectorType());
 								return result;
 							}
 							else
@@ -1067,9 +1361,12 @@ public:   // Public data types
 						for (typename LeafType::const_iterator itLhs = lhs.begin();
 							itLhs != lhs.end(); ++itLhs)
 						{
-							if (!checkInclusion(itLhs->GetVector(), rhsVector))
+							FailureNumberVectorType failures;
+							if (!checkInclusion(itLhs->GetVector(), rhsVector, failures))
 							{
 								doesInclusionHold_ = false;
+								failure_ = inclFunc_->addFailure(disjunct_, itLhs->GetVector(),
+									rhs, failures);
 								break;
 							}
 						}
@@ -1080,54 +1377,72 @@ public:   // Public data types
 				const StateType& smallerState = disjunct.first;
 				const StateSetType& biggerSetOfStates = disjunct.second;
 
-				SharedMTBDDType* mtbdd = smallerAut_->GetTTWrapper()->GetMTBDD();
-
-				RootType unionBigger = mtbdd->CreateRoot();
-				UnionApplyFunctor unionFunc;
-
-				for (typename StateVector::const_iterator itBiggerStates =
-					biggerSetOfStates.begin(); itBiggerStates != biggerSetOfStates.end();
-					++itBiggerStates)
-				{
-					RootType biggerRoot = biggerAut_->getRoot(*itBiggerStates);
-					RootType tmp = mtbdd->Apply(unionBigger,
-						biggerRoot, &unionFunc);
+				++processedPairs_;
 
-					// Erase the following line for better performance ;-)
-					//mtbdd->EraseRoot(unionBigger);
+				SharedMTBDDType* mtbdd = smallerAut_->GetTTWrapper()->GetMTBDD();
 
-					unionBigger = tmp;
-				}
+				RootType unionBigger = uniteBiggerRoots(biggerSetOfStates);
 
 				SetOfDisjunctsQueueType childrenQueue;
 
 				addToWorkset(disjunct);
-				ChildrenCollectorFunctor childColFunc(this);
+				ChildrenCollectorFunctor childColFunc(this, disjunct);
 
 				RootType tmp = mtbdd->Apply(smallerAut_->getRoot(smallerState),
 					unionBigger, &childColFunc);
 				mtbdd->EraseRoot(tmp);
 				removeFromWorkset(disjunct);
 
+				lastFailure_ = childColFunc.GetFailure();
+
 				return childColFunc.DoesInclusionHold();
 			}
 
 		public:   // Public methods
 
-			InclusionCheckingFunctor(const Type* smallerAut, const Type* biggerAut, const SimulationRelationType* simSmaller, const SimulationRelationType* simBigger)
+			InclusionCheckingFunctor(const Type* smallerAut, const Type* biggerAut,
+				const SimulationRelationType* simSmaller,
+				const SimulationRelationType* simBigger, WorklistStrategy strategy)
 				: smallerAut_(smallerAut),
 					biggerAut_(biggerAut),
 					workset_(),
 					includedNodes_(),
 					nonincludedNodes_(),
 					simSmaller_(simSmaller),
-					simBigger_(simBigger)
+					simBigger_(simBigger),
+					unionOperation_(),
+					unionRoots_(smallerAut->GetTTWrapper()->GetMTBDD()),
+					nodeArena_(),
+					strategy_(strategy),
+					processedPairs_(0),
+					failures_(),
+					lastFailure_(noFailure()),
+					witness_()
 			{
 				// Assertions
 				assert(smallerAut_ != static_cast<Type*>(0));
 				assert(biggerAut_ != static_cast<Type*>(0));
 				assert(simSmaller_ != static_cast<SimulationRelationType*>(0));
 				assert(simBigger_ != static_cast<SimulationRelationType*>(0));
+
+				unionOperation_ =
+					smallerAut_->GetTTWrapper()->GetMTBDD()->CreateCachedOperation();
+			}
+
+			~InclusionCheckingFunctor()
+			{
+				smallerAut_->GetTTWrapper()->GetMTBDD()->EraseCachedOperation(
+					unionOperation_);
+			}
+
+			inline size_t GetNumberOfProcessedPairs() const
+			{
+				return processedPairs_;
+			}
+
+			inline const WitnessTreeType& GetWitness() const
+			{
+				return witness_;
 			}
 
 			bool operator ()()
@@ -1142,6 +1457,7 @@ public:   // Public data types
 				{
 					if (!expandSubset(std::make_pair(*itSmallerInitStates, biggerInitStates)))
 					{
+						buildWitness(lastFailure_);
 						return false;
 					}
 				}
@@ -1192,9 +1508,144 @@ public:   // Public data types
 
 		Type* langIntersection(const Type& a1, const Type& a2) const
 		{
-			assert(&a1 != 0);
-			assert(&a2 != 0);
-			assert(false);
+			typedef std::pair<StateType, StateType> StatePair;
+			typedef std::pair<StatePair, StateType> StatePairToState;
+			typedef std::queue<StatePairToState> NewStatesQueueType;
+
+			typedef std::tr1::unordered_map<StatePair, StateType,
+				boost::hash<StatePair> > StatePairToStateTable;
+
+			typedef SFTA::Private::ElemOrVector<StateType> ElemOrVectorType;
+			typedef typename ElemOrVectorType::VectorType StateVectorType;
+
+			class IntersectionApplyFunctor
+				: public SharedMTBDDType::AbstractApplyFunctorType
+			{
+			private:  // Private data members
+
+				Type* resultAutomaton_;
+				NewStatesQueueType* newStates_;
+				StatePairToStateTable* productStatesTable_;
+
+			private:  // Private methods
+
+				IntersectionApplyFunctor(const IntersectionApplyFunctor&);
+				IntersectionApplyFunctor& operator=(const IntersectionApplyFunctor&);
+
+			public:   // Public methods
+
+				IntersectionApplyFunctor(Type* resultAutomaton,
+					NewStatesQueueType* newStates,
+					StatePairToStateTable* productStatesTable)
+					: resultAutomaton_(resultAutomaton),
+						newStates_(newStates),
+						productStatesTable_(productStatesTable)
+				{
+					// Assertions
+					assert(resultAutomaton_ != static_cast<Type*>(0));
+					assert(newStates_ != static_cast<NewStatesQueueType*>(0));
+					assert(productStatesTable_ != static_cast<StatePairToStateTable*>(0));
+				}
+
+				StateType GetProductState(const StatePair& productState)
+				{
+					// Assertions
+					assert(resultAutomaton_ != static_cast<Type*>(0));
+					assert(newStates_ != static_cast<NewStatesQueueType*>(0));
+					assert(productStatesTable_ != static_cast<StatePairToStateTable*>(0));
+
+					typename StatePairToStateTable::const_iterator itPairs;
+					if ((itPairs = productStatesTable_->find(productState))
+						!= productStatesTable_->end())
+					{	// in case the product state is already known
+						return itPairs->second;
+					}
+
+					StateType resultState = resultAutomaton_->AddState();
+					productStatesTable_->insert(std::make_pair(productState, resultState));
+					newStates_->push(std::make_pair(productState, resultState));
+
+					return resultState;
+				}
+
+				virtual LeafType operator()(const LeafType& lhs, const LeafType& rhs)
+				{
+					LeafType result;
+
+					for (typename LeafType::const_iterator itLhs = lhs.begin();
+						itLhs != lhs.end(); ++itLhs)
+					{	// for each tuple of children in A1
+						const StateVectorType& lhsVector = itLhs->GetVector();
+
+						for (typename LeafType::const_iterator itRhs = rhs.begin();
+							itRhs != rhs.end(); ++itRhs)
+						{	// for each tuple of children in A2
+							const StateVectorType& rhsVector = itRhs->GetVector();
+							if (lhsVector.size() != rhsVector.size())
+							{	// in case the arities differ
+								continue;
+							}
+
+							StateVectorType productVector;
+							for (size_t i = 0; i < lhsVector.size(); ++i)
+							{	// pair the children at every position
+								productVector.push_back(GetProductState(
+									std::make_pair(lhsVector[i], rhsVector[i])));
+							}
+
+							result.insert(ElemOrVectorType(productVector));
+						}
+					}
+
+					return result;
+				}
+			};
+
+
+			// create structure for output automaton
+			Type* result = new Type(a1.GetTTWrapper());
+
+			// create used data structures
+			NewStatesQueueType newStates;
+			StatePairToStateTable productStatesTable;
+			IntersectionApplyFunctor intersectionFunc(result, &newStates,
+				&productStatesTable);
+
+			std::vector<StateType> a1InitStates = a1.GetVectorOfInitialStates();
+			std::vector<StateType> a2InitStates = a2.GetVectorOfInitialStates();
+
+			for (typename std::vector<StateType>::const_iterator itA1 =
+				a1InitStates.begin(); itA1 != a1InitStates.end(); ++itA1)
+			{	// start from pairs of initial states
+				for (typename std::vector<StateType>::const_iterator itA2 =
+					a2InitStates.begin(); itA2 != a2InitStates.end(); ++itA2)
+				{
+					result->SetStateInitial(intersectionFunc.GetProductState(
+						std::make_pair(*itA1, *itA2)));
+				}
+			}
+
+			SharedMTBDDType* mtbdd = result->GetTTWrapper()->GetMTBDD();
+
+			while (!newStates.empty())
+			{	// until we process all reachable pairs of states
+				StatePair productState = newStates.front().first;
+				StateType resultState = newStates.front().second;
+				newStates.pop();
+
+				// carry out the apply operation on transitions of both states, which
+				// discovers the pairs of children
+				RootType resultRoot = mtbdd->Apply(a1.getRoot(productState.first),
+					a2.getRoot(productState.second), &intersectionFunc);
+				result->setRoot(resultState, resultRoot);
+			}
+
+			if (this->IsPruningProducts())
+			{	// in case useless states of the product are to be removed
+				result->RemoveUselessStates();
+			}
+
+			return result;
 		}
 
 	public:   // Public methods
@@ -1226,10 +1677,10 @@ public:   // Public data types
 				throw std::runtime_error(__func__ + std::string(": Invalid type"));
 			}
 
-			// the simulation relation
-			SimType* sim = new SimType();
-
 			StateSetType states = autSym->getStates();
+
+			// the simulation relation, its matrix starts at the least state
+			SimType* sim = new SimType(states.empty()? StateType() : *states.begin());
 			for (typename StateSetType::const_iterator itStates = states.begin();
 				itStates != states.end(); ++itStates)
 			{
@@ -1266,11 +1717,93 @@ public:   // Public data types
 				throw std::runtime_error(__func__ + std::string(": Invalid type"));
 			}
 
-			InclusionCheckingFunctor inclFunc(a1Sym, a2Sym, simA1, simA2);
-			return inclFunc();
+			InclusionCheckingFunctor inclFunc(a1Sym, a2Sym, simA1, simA2,
+				this->GetWorklistStrategy());
+			bool result = inclFunc();
+			this->setNumberOfProcessedPairs(inclFunc.GetNumberOfProcessedPairs());
+			this->setWitness(inclFunc.GetWitness());
+
+			return result;
 		}
 	};
 
+private:  // Private data types
+
+	typedef typename ParentClass::StateSetType StateSetType;
+	typedef std::tr1::unordered_set<StateType> StateHashSetType;
+	typedef typename SFTA::Private::ElemOrVector<StateType>::VectorType
+		StateVectorType;
+	typedef std::set<StateVectorType> StateVectorSetType;
+
+private:  // Private methods
+
+
+	/**
+	 * @brief  Collects tuples of a root
+	 *
+	 * Collects tuples of states in all leaves of the MTBDD with given root.
+	 *
+	 * @param[in]   root    The root of the MTBDD
+	 * @param[out]  tuples  The set the tuples are inserted into
+	 */
+	void collectTuplesOfRoot(const typename SharedMTBDDType::RootType& root,
+		StateVectorSetType& tuples) const
+	{
+		typedef typename SharedMTBDDType::LeafType LeafType;
+
+		class CollectorMonadicApplyFunctor
+			: public SharedMTBDDType::AbstractMonadicApplyFunctorType
+		{
+		private:  // Private data members
+
+			StateVectorSetType& tuples_;
+
+		private:  // Private methods
+
+			CollectorMonadicApplyFunctor(const CollectorMonadicApplyFunctor& func);
+			CollectorMonadicApplyFunctor& operator=(
+				const CollectorMonadicApplyFunctor& func);
+
+		public:   // Public methods
+
+			explicit CollectorMonadicApplyFunctor(StateVectorSetType& tuples)
+				: tuples_(tuples)
+			{ }
+
+			virtual LeafType operator()(const LeafType& val)
+			{
+				for (typename LeafType::const_iterator itVal = val.begin();
+					itVal != val.end(); ++itVal)
+				{
+					tuples_.insert(itVal->GetVector());
+				}
+
+				return LeafType();
+			}
+		};
+
+		CollectorMonadicApplyFunctor collectorFunc(tuples);
+
+		SharedMTBDDType* mtbdd = this->GetTTWrapper()->GetMTBDD();
+		mtbdd->EraseRoot(mtbdd->MonadicApply(root, &collectorFunc));
+	}
+
+	static bool containsOnly(const StateVectorType& tuple,
+		const StateHashSetType& states)
+	{
+		for (typename StateVectorType::const_iterator itTuple = tuple.begin();
+			itTuple != tuple.end(); ++itTuple)
+		{
+			if (states.find(*itTuple) == states.end())
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+
 protected:// Protected methods
 
 	virtual Operation* createOperation() const
@@ -1296,6 +1829,201 @@ public:   // Public methods
 		: ParentClass(ttWrapper)
 	{ }
 
+
+	/**
+	 * @brief  Removes useless states
+	 *
+	 * Removes states from which no tree can be accepted and states that are
+	 * not reachable from initial states through tuples of the remaining
+	 * states. The automaton drops its references to roots of removed states
+	 * and the remaining roots are replaced by roots without tuples with the
+	 * removed states. Roots shared with another automaton (as they are, e.g.,
+	 * in the result of the union of automata) are kept for their other owners.
+	 *
+	 * @returns  The number of removed states
+	 */
+	size_t RemoveUselessStates()
+	{
+		typedef typename SharedMTBDDType::LeafType LeafType;
+		typedef std::tr1::unordered_map<StateType, StateVectorSetType> TupleMapType;
+
+		// a tuple of a state together with the number of its positions with
+		// states that are not known to be productive yet
+		typedef std::pair<StateType, size_t> OccurrenceType;
+		typedef std::vector<OccurrenceType> OccurrenceVectorType;
+		typedef std::tr1::unordered_map<StateType, std::vector<size_t> >
+			OccurrenceIndexType;
+
+		class RemoverMonadicApplyFunctor
+			: public SharedMTBDDType::AbstractMonadicApplyFunctorType
+		{
+		private:  // Private data members
+
+			const StateHashSetType& keptStates_;
+
+		private:  // Private methods
+
+			RemoverMonadicApplyFunctor(const RemoverMonadicApplyFunctor& func);
+			RemoverMonadicApplyFunctor& operator=(const RemoverMonadicApplyFunctor& func);
+
+		public:   // Public methods
+
+			explicit RemoverMonadicApplyFunctor(const StateHashSetType& keptStates)
+				: keptStates_(keptStates)
+			{ }
+
+			virtual LeafType operator()(const LeafType& val)
+			{
+				LeafType result;
+				for (typename LeafType::const_iterator itVal = val.begin();
+					itVal != val.end(); ++itVal)
+				{
+					if (containsOnly(itVal->GetVector(), keptStates_))
+					{	// in case all states of the tuple are kept
+						result.insert(*itVal);
+					}
+				}
+
+				return result;
+			}
+		};
+
+		const LHSRootContainerType& rootMap = this->getRootMap();
+		const StateSetType& states = this->getStates();
+
+		// collect tuples of all states and index their occurrences
+		TupleMapType tuples;
+		OccurrenceVectorType occurrences;
+		OccurrenceIndexType occurrenceIndex;
+		StateHashSetType productive;
+		std::queue<StateType> workset;
+		for (typename LHSRootContainerType::const_iterator itRoots = rootMap.begin();
+			itRoots != rootMap.end(); ++itRoots)
+		{
+			if (states.find(itRoots->first) == states.end())
+			{	// in case the root does not belong to a state of the automaton
+				continue;
+			}
+
+			StateVectorSetType& stateTuples = tuples[itRoots->first];
+			collectTuplesOfRoot(itRoots->second, stateTuples);
+
+			for (typename StateVectorSetType::const_iterator itTuples =
+				stateTuples.begin(); itTuples != stateTuples.end(); ++itTuples)
+			{
+				if (itTuples->empty())
+				{	// in case the state accepts a leaf
+					if (productive.insert(itRoots->first).second)
+					{
+						workset.push(itRoots->first);
+					}
+
+					continue;
+				}
+
+				for (typename StateVectorType::const_iterator itStates =
+					itTuples->begin(); itStates != itTuples->end(); ++itStates)
+				{
+					occurrenceIndex[*itStates].push_back(occurrences.size());
+				}
+
+				occurrences.push_back(OccurrenceType(itRoots->first, itTuples->size()));
+			}
+		}
+
+		while (!workset.empty())
+		{	// until all productive states are processed
+			StateType state = workset.front();
+			workset.pop();
+
+			typename OccurrenceIndexType::const_iterator itIndex;
+			if ((itIndex = occurrenceIndex.find(state)) == occurrenceIndex.end())
+			{	// in case the state is in no tuple
+				continue;
+			}
+
+			for (std::vector<size_t>::const_iterator itOccur = itIndex->second.begin();
+				itOccur != itIndex->second.end(); ++itOccur)
+			{
+				OccurrenceType& occurrence = occurrences[*itOccur];
+				if ((--occurrence.second == 0) &&
+					productive.insert(occurrence.first).second)
+				{	// in case the whole tuple has become productive
+					workset.push(occurrence.first);
+				}
+			}
+		}
+
+		// go down from productive initial states
+		StateHashSetType useful;
+		std::vector<StateType> initialStates = this->GetVectorOfInitialStates();
+		for (typename std::vector<StateType>::const_iterator itStates =
+			initialStates.begin(); itStates != initialStates.end(); ++itStates)
+		{
+			if ((productive.find(*itStates) != productive.end()) &&
+				useful.insert(*itStates).second)
+			{	// in case the initial state is productive
+				workset.push(*itStates);
+			}
+		}
+
+		while (!workset.empty())
+		{	// until all useful states are processed
+			StateType state = workset.front();
+			workset.pop();
+
+			const StateVectorSetType& stateTuples = tuples[state];
+			for (typename StateVectorSetType::const_iterator itTuples =
+				stateTuples.begin(); itTuples != stateTuples.end(); ++itTuples)
+			{
+				if (!containsOnly(*itTuples, productive))
+				{	// in case the tuple accepts no tree
+					continue;
+				}
+
+				for (typename StateVectorType::const_iterator itStates =
+					itTuples->begin(); itStates != itTuples->end(); ++itStates)
+				{
+					if (useful.insert(*itStates).second)
+					{	// in case the state is found to be useful
+						workset.push(*itStates);
+					}
+				}
+			}
+		}
+
+		size_t removedStates = states.size() - useful.size();
+		SFTA_LOGGER_DEBUG("Removing " + Convert::ToString(removedStates)
+			+ " useless states");
+
+		if (removedStates == 0)
+		{	// in case all states are useful
+			return 0;
+		}
+
+		SharedMTBDDType* mtbdd = this->GetTTWrapper()->GetMTBDD();
+		RemoverMonadicApplyFunctor removerFunc(useful);
+
+		LHSRootContainerType newRootMap;
+		for (typename LHSRootContainerType::const_iterator itRoots = rootMap.begin();
+			itRoots != rootMap.end(); ++itRoots)
+		{
+			if (useful.find(itRoots->first) != useful.end())
+			{	// in case the state is kept
+				newRootMap.insert(std::make_pair(itRoots->first,
+					mtbdd->MonadicApply(itRoots->second, &removerFunc)));
+			}
+
+			mtbdd->EraseRoot(itRoots->second);
+		}
+
+		this->setRootMap(newRootMap);
+		this->restrictStates(StateSetType(std::vector<StateType>(useful.begin(),
+			useful.end())));
+
+		return removedStates;
+	}
+
 };
 
 #endif
@@ -0,0 +1,142 @@
+/*****************************************************************************
+ *  Symbolic Finite Tree Automata Library
+ *
+ *  Copyright (c) 2010  Ondra Lengal <ondra@lengal.net>
+ *
+ *  Description:
+ *    File with RootArena class for temporary roots of a shared MTBDD.
+ *
+ *****************************************************************************/
+
+#ifndef _SFTA_ROOT_ARENA_HH_
+#define _SFTA_ROOT_ARENA_HH_
+
+// Standard library headers
+#include <cassert>
+#include <vector>
+
+
+// insert the class into proper namespace
+namespace SFTA
+{
+	namespace Private
+	{
+		template
+		<
+			class SharedMTBDD
+		>
+		class RootArena;
+	}
+}
+
+
+/**
+ * @brief   Arena of temporary roots of a shared MTBDD
+ * @author  Ondra Lengal <ondra@lengal.net>
+ * @date    2010
+ *
+ * This class collects roots of intermediate results of MTBDD operations and
+ * releases all of them at once, either on demand or when the arena goes out
+ * of scope. Roots added to the arena must not be erased by other means.
+ *
+ * @tparam  SharedMTBDD  The type of the shared MTBDD the roots belong to.
+ */
+template
+<
+	class SharedMTBDD
+>
+class SFTA::Private::RootArena
+{
+public:   // Public data types
+
+	typedef SharedMTBDD SharedMTBDDType;
+	typedef typename SharedMTBDDType::RootType RootType;
+
+private:  // Private data types
+
+	typedef std::vector<RootType> RootContainer;
+
+private:  // Private data members
+
+	/**
+	 * @brief  The shared MTBDD
+	 *
+	 * The shared MTBDD the roots of the arena belong to.
+	 */
+	SharedMTBDDType* mtbdd_;
+
+
+	/**
+	 * @brief  Roots in the arena
+	 *
+	 * Roots that are to be released with the arena.
+	 */
+	RootContainer roots_;
+
+private:  // Private methods
+
+	RootArena(const RootArena&);
+	RootArena& operator=(const RootArena&);
+
+public:   // Public methods
+
+	/**
+	 * @brief  Constructor
+	 *
+	 * Creates an empty arena for roots of given shared MTBDD.
+	 *
+	 * @param[in]  mtbdd  The shared MTBDD
+	 */
+	explicit RootArena(SharedMTBDDType* mtbdd)
+		: mtbdd_(mtbdd),
+			roots_()
+	{
+		// Assertions
+		assert(mtbdd_ != static_cast<SharedMTBDDType*>(0));
+	}
+
+
+	/**
+	 * @brief  Adds a root to the arena
+	 *
+	 * Passes the ownership of given root to the arena.
+	 *
+	 * @param[in]  root  The root to be added
+	 *
+	 * @returns  The root
+	 */
+	inline RootType Add(const RootType& root)
+	{
+		roots_.push_back(root);
+		return root;
+	}
+
+
+	/**
+	 * @brief  Releases all roots
+	 *
+	 * Releases all roots in the arena at once. The arena may be used again
+	 * afterwards.
+	 */
+	void Release()
+	{
+		if (!roots_.empty())
+		{	// in case there is something to be released
+			mtbdd_->ReleaseRoots(roots_);
+			roots_.clear();
+		}
+	}
+
+
+	/**
+	 * @brief  Destructor
+	 *
+	 * The destructor releases all roots that are left in the arena.
+	 */
+	~RootArena()
+	{
+		Release();
+	}
+};
+
+#endif
@@ -5,10 +5,13 @@
  *
  *  Description:
  *    Header file with global declarations. It contains:
- *      * macros for easy logging
+ *      * macros for easy logging (messages are evaluated lazily)
  *
  *****************************************************************************/
 
+#ifndef _SFTA_SFTA_HH_
+#define _SFTA_SFTA_HH_
+
 // Log4cpp headers
 #include <log4cpp/Category.hh>
 
@@ -19,16 +22,41 @@
 
 #define SFTA_LOGGER_PREFIX (std::string(__FILE__ ":" + SFTA::Private::Convert::ToString(__LINE__) + ": "))
 
-#define SFTA_LOGGER_LOG_MESSAGE(severity, msg) (log4cpp::Category::getInstance(SFTA_LOG_CATEGORY_NAME).severity((SFTA_LOGGER_PREFIX) + (msg)))
+// the category is looked up only once, not at every message
+#define SFTA_LOGGER_CATEGORY (SFTA::Private::GetLoggerCategory())
+
+namespace SFTA
+{
+	namespace Private
+	{
+		inline log4cpp::Category& GetLoggerCategory()
+		{
+			static log4cpp::Category& category =
+				log4cpp::Category::getInstance(SFTA_LOG_CATEGORY_NAME);
+
+			return category;
+		}
+	}
+}
 
-#define SFTA_LOGGER_DEBUG(msg)  (SFTA_LOGGER_LOG_MESSAGE(debug, msg))
-#define SFTA_LOGGER_INFO(msg)   (SFTA_LOGGER_LOG_MESSAGE(info, msg))
-#define SFTA_LOGGER_NOTICE(msg) (SFTA_LOGGER_LOG_MESSAGE(notice, msg))
-#define SFTA_LOGGER_WARN(msg)   (SFTA_LOGGER_LOG_MESSAGE(warn, msg))
-#define SFTA_LOGGER_ERROR(msg)  (SFTA_LOGGER_LOG_MESSAGE(error, msg))
-#define SFTA_LOGGER_CRIT(msg)   (SFTA_LOGGER_LOG_MESSAGE(crit, msg))
-#define SFTA_LOGGER_ALERT(msg)  (SFTA_LOGGER_LOG_MESSAGE(alert, msg))
-#define SFTA_LOGGER_FATAL(msg)  (SFTA_LOGGER_LOG_MESSAGE(fatal, msg))
+// the message is evaluated only in case the severity is enabled
+#define SFTA_LOGGER_LOG_MESSAGE(severity, isEnabled, msg) (SFTA_LOGGER_CATEGORY.isEnabled() ? SFTA_LOGGER_CATEGORY.severity((SFTA_LOGGER_PREFIX) + (msg)) : static_cast<void>(0))
+
+// debugging messages are compiled out completely if requested by the build
+#ifdef SFTA_DISABLE_DEBUG_LOG
+#define SFTA_LOGGER_DEBUG(msg)  (static_cast<void>(0))
+#define SFTA_LOGGER_INFO(msg)   (static_cast<void>(0))
+#else
+#define SFTA_LOGGER_DEBUG(msg)  (SFTA_LOGGER_LOG_MESSAGE(debug, isDebugEnabled, msg))
+#define SFTA_LOGGER_INFO(msg)   (SFTA_LOGGER_LOG_MESSAGE(info, isInfoEnabled, msg))
+#endif
+
+#define SFTA_LOGGER_NOTICE(msg) (SFTA_LOGGER_LOG_MESSAGE(notice, isNoticeEnabled, msg))
+#define SFTA_LOGGER_WARN(msg)   (SFTA_LOGGER_LOG_MESSAGE(warn, isWarnEnabled, msg))
+#define SFTA_LOGGER_ERROR(msg)  (SFTA_LOGGER_LOG_MESSAGE(error, isErrorEnabled, msg))
+#define SFTA_LOGGER_CRIT(msg)   (SFTA_LOGGER_LOG_MESSAGE(crit, isCritEnabled, msg))
+#define SFTA_LOGGER_ALERT(msg)  (SFTA_LOGGER_LOG_MESSAGE(alert, isAlertEnabled, msg))
+#define SFTA_LOGGER_FATAL(msg)  (SFTA_LOGGER_LOG_MESSAGE(fatal, isFatalEnabled, msg))
 
 #if ((__GNUC__ * 100) + __GNUC_MINOR__) >= 402
 #define GCC_DIAG_STR(s) #s
@@ -47,3 +75,5 @@
 # define GCC_DIAG_OFF(x)
 # define GCC_DIAG_ON(x)
 #endif
+
+#endif
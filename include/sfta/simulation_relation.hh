@@ -12,8 +12,11 @@
 #define _SIMULATION_RELATION_HH_
 
 // Standard library headers
-#include <set>
-#include <tr1/unordered_map>
+#include <cassert>
+#include <climits>
+#include <stdexcept>
+#include <string>
+#include <vector>
 
 
 
@@ -29,6 +32,24 @@ namespace SFTA
 }
 
 
+/**
+ * @brief   Simulation relation
+ * @author  Ondra Lengal <ondra@lengal.net>
+ * @date    2010
+ *
+ * Binary relation on states stored as a bit matrix. A row of the matrix
+ * contains simulators of a state, i.e. the pair @f$(p, q)@f$ is in the
+ * relation iff the bit of @f$q@f$ in the row of @f$p@f$ is set. States are
+ * expected to be dense unsigned values, because their distances from the
+ * first state of the relation are used as indices into the matrix.
+ *
+ * Sets of states may be converted into bit sets using CreateBitSet(), so
+ * that queries whether a state is simulated by some state of a set are
+ * carried out word by word. The transposed matrix is kept as well, so that
+ * states simulated by a set of states can be collected quickly.
+ *
+ * @tparam  State  The type of states.
+ */
 template
 <
 	typename State
@@ -44,74 +65,353 @@ private:  // Private data types
 	typedef State StateType;
 
 
+	/**
+	 * Data type of words of the bit matrix.
+	 */
+	typedef unsigned long WordType;
+
+public:   // Public data types
+
+	typedef SimulationRelation<StateType> Type;
+
+	typedef std::pair<const StateType, StateType> value_type;
+
+
+	/**
+	 * Data type of a set of states represented as a bit vector.
+	 */
+	typedef std::vector<WordType> BitSetType;
+
+private:  // Private data types
+
+
 	/**
 	 * Data type for a row of the relation matrix.
 	 */
-	typedef std::set<StateType> RowType;
+	typedef BitSetType RowType;
 
 
 	/**
 	 * Data type for the relation matrix.
 	 */
-	typedef std::tr1::unordered_map<StateType, RowType> MatrixType;
+	typedef std::vector<RowType> MatrixType;
 
-public:   // Public data types
 
-	typedef SimulationRelation<StateType> Type;
+private:  // Private data members
 
-	typedef std::pair<const StateType, StateType> value_type;
 
+	/**
+	 * The number of bits in a word of the matrix.
+	 */
+	static const size_t WORD_BITS = sizeof(WordType) * CHAR_BIT;
 
-private:  // Private data members
+
+	/**
+	 * The least state of the relation, it corresponds to the first row and
+	 * column of the matrix.
+	 */
+	StateType firstState_;
 
 
 	MatrixType matrix_;
 
 
+	/**
+	 * The transposed relation matrix, a row contains states simulated by a
+	 * state.
+	 */
+	MatrixType transposed_;
+
+
 private:  // Private methods
 
-	RowType& getRow(const StateType& column)
+	static inline size_t wordIndex(size_t index)
+	{
+		return index / WORD_BITS;
+	}
+
+	static inline WordType bitMask(size_t index)
+	{
+		return static_cast<WordType>(1) << (index % WORD_BITS);
+	}
+
+	static inline bool isBitSet(const BitSetType& bits, size_t index)
+	{
+		return (wordIndex(index) < bits.size()) &&
+			((bits[wordIndex(index)] & bitMask(index)) != 0);
+	}
+
+	static inline void setBit(BitSetType& bits, size_t index)
+	{
+		if (wordIndex(index) >= bits.size())
+		{	// in case the bit vector is too short
+			bits.resize(wordIndex(index) + 1, 0);
+		}
+
+		bits[wordIndex(index)] |= bitMask(index);
+	}
+
+	static RowType& getRow(MatrixType& matrix, size_t index)
+	{
+		if (index >= matrix.size())
+		{	// in case the row for given state has not been initialized yet
+			matrix.resize(index + 1);
+		}
+
+		return matrix[index];
+	}
+
+	static void clearBit(MatrixType& matrix, size_t row, size_t index)
+	{
+		if (row < matrix.size())
+		{	// in case the row exists
+			RowType& bits = matrix[row];
+			if (wordIndex(index) < bits.size())
+			{	// in case the bit is in the row
+				bits[wordIndex(index)] &= ~bitMask(index);
+			}
+		}
+	}
+
+	inline bool hasIndex(const StateType& state) const
 	{
-		typename MatrixType::iterator itMatrix;
-		if ((itMatrix = matrix_.find(column)) == matrix_.end())
-		{	// in case the value for given state has not been initialized yet
-			itMatrix = matrix_.insert(matrix_.begin(),
-				std::make_pair(column, RowType()));
+		return !(state < firstState_);
+	}
+
+	inline size_t getIndex(const StateType& state) const
+	{
+		// Assertions
+		assert(hasIndex(state));
+
+		return static_cast<size_t>(state - firstState_);
+	}
+
+	inline const RowType* findRow(const MatrixType& matrix,
+		const StateType& state) const
+	{
+		if (!hasIndex(state) || (getIndex(state) >= matrix.size()))
+		{	// in case there is no row for the state
+			return static_cast<const RowType*>(0);
 		}
 
-		return itMatrix->second;
+		return &matrix[getIndex(state)];
+	}
+
+	std::vector<StateType> bitsToStates(const BitSetType& bits) const
+	{
+		std::vector<StateType> result;
+		for (size_t i = 0; i < bits.size(); ++i)
+		{	// for each word of the bit set
+			for (WordType word = bits[i]; word != 0; word &= word - 1)
+			{	// for each set bit of the word
+				size_t bit = 0;
+				while ((word & (static_cast<WordType>(1) << bit)) == 0)
+				{	// find the lowest set bit
+					++bit;
+				}
+
+				result.push_back(firstState_ +
+					static_cast<StateType>(i * WORD_BITS + bit));
+			}
+		}
+
+		return result;
 	}
 
 public:   // Public methods
 
-	SimulationRelation()
-		: matrix_()
+
+	/**
+	 * @brief  Constructor
+	 *
+	 * Creates an empty relation whose matrix starts at given state. The
+	 * states of an automaton are usually allocated consecutively, so starting
+	 * the matrix at the least state of the automaton keeps the matrix
+	 * quadratic in the number of its states, even if other automata share
+	 * the same allocator of states.
+	 *
+	 * @param[in]  firstState  The least state that may occur in the relation
+	 */
+	explicit SimulationRelation(const StateType& firstState = StateType())
+		: firstState_(firstState),
+			matrix_(),
+			transposed_()
 	{ }
 
 	inline void insert(const value_type& value)
 	{
-		getRow(value.first).insert(value.second);
+		if (!hasIndex(value.first) || !hasIndex(value.second))
+		{	// in case the pair is out of the matrix
+			throw std::runtime_error(__func__ +
+				std::string(": state precedes the first state of the relation"));
+		}
+
+		setBit(getRow(matrix_, getIndex(value.first)), getIndex(value.second));
+		setBit(getRow(transposed_, getIndex(value.second)), getIndex(value.first));
 	}
 
 	inline void erase(const value_type& value)
 	{
-		getRow(value.first).erase(value.second);
+		if (hasIndex(value.first) && hasIndex(value.second))
+		{	// in case the pair may be in the matrix
+			clearBit(matrix_, getIndex(value.first), getIndex(value.second));
+			clearBit(transposed_, getIndex(value.second), getIndex(value.first));
+		}
+	}
+
+	inline bool is_in(const value_type& value) const
+	{
+		const RowType* row = findRow(matrix_, value.first);
+
+		return (row != static_cast<const RowType*>(0)) &&
+			hasIndex(value.second) && isBitSet(*row, getIndex(value.second));
+	}
+
+
+	/**
+	 * @brief  Returns simulators of a state
+	 *
+	 * Returns the sorted array of all states that simulate given state.
+	 *
+	 * @param[in]  state  The state
+	 *
+	 * @returns  Simulators of the state
+	 */
+	std::vector<StateType> GetSimulators(const StateType& state) const
+	{
+		const RowType* row = findRow(matrix_, state);
+		if (row == static_cast<const RowType*>(0))
+		{	// in case there is no row for the state
+			return std::vector<StateType>();
+		}
+
+		return bitsToStates(*row);
+	}
+
+
+	/**
+	 * @brief  Returns states simulated by a set
+	 *
+	 * Returns the sorted array of all states that are simulated by some state
+	 * of given set. A set @f$A@f$ is then simulated by a set @f$B@f$ (i.e.
+	 * each state of @f$A@f$ is simulated by some state of @f$B@f$) iff
+	 * @f$A@f$ is a subset of the result for @f$B@f$.
+	 *
+	 * @param[in]  states  The container of states
+	 *
+	 * @returns  States simulated by some state of @p states
+	 */
+	template <class T>
+	std::vector<StateType> GetSimulatedByAny(const T& states) const
+	{
+		BitSetType result;
+		for (typename T::const_iterator itStates = states.begin();
+			itStates != states.end(); ++itStates)
+		{	// unite the rows of the transposed matrix
+			const RowType* row = findRow(transposed_, *itStates);
+			if (row != static_cast<const RowType*>(0))
+			{	// in case the state simulates something
+				if (row->size() > result.size())
+				{	// in case the result is too short
+					result.resize(row->size(), 0);
+				}
+
+				for (size_t i = 0; i < row->size(); ++i)
+				{
+					result[i] |= (*row)[i];
+				}
+			}
+		}
+
+		return bitsToStates(result);
+	}
+
+
+	/**
+	 * @brief  Converts a set of states into a bit set
+	 *
+	 * Creates the bit set representation of given set of states that can be
+	 * used in queries of the relation.
+	 *
+	 * @param[in]  states  The container of states
+	 *
+	 * @returns  The bit set of the states
+	 */
+	template <class T>
+	BitSetType CreateBitSet(const T& states) const
+	{
+		BitSetType result;
+		for (typename T::const_iterator itStates = states.begin();
+			itStates != states.end(); ++itStates)
+		{	// set the bit of every state, the others cannot simulate anything
+			if (hasIndex(*itStates))
+			{
+				setBit(result, getIndex(*itStates));
+			}
+		}
+
+		return result;
 	}
 
-	bool is_in(const value_type& value) const
+
+	/**
+	 * @brief  Checks whether a state is simulated by a state of a set
+	 *
+	 * Checks whether there is a state in given set that simulates given
+	 * state. The check is performed word by word.
+	 *
+	 * @param[in]  state   The simulated state
+	 * @param[in]  states  The bit set of candidate simulators
+	 *
+	 * @returns  @p true if some state of @p states simulates @p state,
+	 *           @p false otherwise
+	 */
+	bool IsSimulatedByAny(const StateType& state, const BitSetType& states) const
 	{
-		typename MatrixType::const_iterator itMatrix;
-		if ((itMatrix = matrix_.find(value.first)) == matrix_.end())
-		{
+		const RowType* row = findRow(matrix_, state);
+		if (row == static_cast<const RowType*>(0))
+		{	// in case there is no row for the state
 			return false;
 		}
 
-		return (itMatrix->second).find(value.second) != (itMatrix->second).end();
+		size_t size = (row->size() < states.size())? row->size() : states.size();
+		for (size_t i = 0; i < size; ++i)
+		{	// intersect the row with the set
+			if (((*row)[i] & states[i]) != 0)
+			{
+				return true;
+			}
+		}
+
+		return false;
 	}
 
-	const std::set<StateType>& GetSimulators(const StateType& state) const
+
+	/**
+	 * @brief  Checks whether all states are simulated by a set
+	 *
+	 * Checks whether every state of @p smaller is simulated by some state of
+	 * given bit set.
+	 *
+	 * @param[in]  smaller  The container of simulated states
+	 * @param[in]  bigger   The bit set of candidate simulators
+	 *
+	 * @returns  @p true if each state of @p smaller is simulated by a state of
+	 *           @p bigger, @p false otherwise
+	 */
+	template <class T>
+	bool IsEachSimulatedByAny(const T& smaller, const BitSetType& bigger) const
 	{
-		return const_cast<Type*>(this)->getRow(state);
+		for (typename T::const_iterator itSmaller = smaller.begin();
+			itSmaller != smaller.end(); ++itSmaller)
+		{	// check every state of the smaller set
+			if (!IsSimulatedByAny(*itSmaller, bigger))
+			{
+				return false;
+			}
+		}
+
+		return true;
 	}
 };
 
@@ -11,6 +11,10 @@
 #ifndef _SFTA_SYMBOL_DICTIONARY_HH_
 #define _SFTA_SYMBOL_DICTIONARY_HH_
 
+// Standard library headers
+#include <limits>
+#include <map>
+
 // SFTA header files
 #include <sfta/convert.hh>
 
@@ -33,9 +37,15 @@ namespace SFTA
  * @date    2010
  *
  * This class can be used as a two-way dictionary for two different types.
+ * Output symbols are binary encodings of input symbols, the number of
+ * variables of the encoding is kept at @f$\lceil \log_2 n \rceil@f$ for
+ * @f$n@f$ translated symbols and grows on demand. When a variable is added,
+ * the encodings of all symbols translated before get value 0 of the
+ * variable.
  *
  * @tparam  InputSymbol    Input symbol type.
- * @tparam  OutputSymbol   Output symbol type.
+ * @tparam  OutputSymbol   Output symbol type (an assignment to Boolean
+ *                         variables).
  */
 template
 <
@@ -63,21 +73,98 @@ private:  // Private data members
 
 	OutputSymbolType nextSymbol_;
 
+private:  // Private methods
+
+
+	/**
+	 * @brief  Are all encodings used?
+	 *
+	 * Determines whether all encodings of symbols with the current number of
+	 * variables have been assigned.
+	 *
+	 * @returns  True iff there is no free encoding
+	 */
+	bool isEncodingFull() const
+	{
+		size_t width = nextSymbol_.VariablesCount();
+
+		return (width < static_cast<size_t>(std::numeric_limits<size_t>::digits))
+			&& (i2o_.size() >= (static_cast<size_t>(1) << width));
+	}
+
+
+	/**
+	 * @brief  Adds a variable to the encoding
+	 *
+	 * Adds a new variable to the encoding of symbols. All symbols translated
+	 * so far get value 0 of the variable and the next symbol is the first one
+	 * with value 1 of the variable.
+	 */
+	void extendEncoding()
+	{
+		size_t newVariable = nextSymbol_.VariablesCount();
+
+		I2OMapType i2o;
+		O2IMapType o2i;
+		for (typename I2OMapType::const_iterator itSymbols = i2o_.begin();
+			itSymbols != i2o_.end(); ++itSymbols)
+		{	// extend all symbols by the new variable
+			OutputSymbolType extendedSymbol = itSymbols->second;
+			extendedSymbol.AddVariablesUpTo(newVariable);
+			extendedSymbol.SetIthVariableValue(newVariable, OutputSymbolType::ZERO);
+
+			i2o.insert(std::make_pair(itSymbols->first, extendedSymbol));
+			o2i.insert(std::make_pair(extendedSymbol, itSymbols->first));
+		}
+
+		i2o_.swap(i2o);
+		o2i_.swap(o2i);
+
+		// all encodings have been used, so the next symbol has wrapped to zeros
+		nextSymbol_.AddVariablesUpTo(newVariable);
+		nextSymbol_.SetIthVariableValue(newVariable, OutputSymbolType::ONE);
+	}
+
+
 public:   // Public methods
 
 
-	SymbolDictionary(const OutputSymbolType& initialSymbol)
+	/**
+	 * @brief  Constructor
+	 *
+	 * Creates an empty dictionary, the encoding of symbols has no variables
+	 * until the second symbol is translated.
+	 */
+	SymbolDictionary()
 		: i2o_(),
 			o2i_(),
-			nextSymbol_(initialSymbol)
+			nextSymbol_(0, 0)
 	{ }
 
 
+	/**
+	 * @brief  Translates a symbol
+	 *
+	 * Returns the encoding of given symbol. In case the symbol has not been
+	 * translated before, a new encoding is assigned to it, possibly adding
+	 * a variable to the encoding.
+	 *
+	 * @see  GetEncodingWidth()
+	 *
+	 * @param[in]  symbol  The input symbol
+	 *
+	 * @returns  The encoding of the symbol
+	 */
 	OutputSymbolType Translate(const InputSymbolType& symbol)
 	{
 		typename I2OMapType::const_iterator itSymbol;
 		if ((itSymbol = i2o_.find(symbol)) == i2o_.end())
 		{	// in case a new symbol appeared
+			if (isEncodingFull())
+			{	// in case a variable needs to be added to the encoding
+				extendEncoding();
+			}
+
 			OutputSymbolType newSymbol = nextSymbol_;
 			++nextSymbol_;
 
@@ -116,6 +203,35 @@ public:   // Public methods
 	}
 
 
+	/**
+	 * @brief  Checks whether a symbol has a translation
+	 *
+	 * Checks whether given symbol has already been translated, so that
+	 * Translate() does not create a new encoding for it.
+	 *
+	 * @param[in]  symbol  The symbol
+	 *
+	 * @returns  @p true if the symbol has a translation, @p false otherwise
+	 */
+	inline bool HasTranslation(const InputSymbolType& symbol) const
+	{
+		return i2o_.find(symbol) != i2o_.end();
+	}
+
+
+	/**
+	 * @brief  Gets the number of variables of the encoding
+	 *
+	 * Returns the number of variables of encodings of symbols.
+	 *
+	 * @returns  The number of variables of the encoding
+	 */
+	inline size_t GetEncodingWidth() const
+	{
+		return nextSymbol_.VariablesCount();
+	}
+
+
 	InputSymbolType TranslateInverse(const OutputSymbolType& symbol)
 	{
 		typename O2IMapType::const_iterator itSymbol;
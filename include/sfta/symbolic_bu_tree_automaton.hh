@@ -121,6 +121,16 @@ public:   // Public data types
 	typedef Transition TransitionType;
 
 
+	/**
+	 * @brief  Data type for transitions with the same left-hand side
+	 *
+	 * This type is used to pass pairs of symbols and right-hand sides of
+	 * several transitions with the same left-hand side at once.
+	 */
+	typedef typename MTBDDTTWrapperType::SharedMTBDDType::AssignmentListType
+		SymbolRightHandSideListType;
+
+
 	/**
 	 * @brief  @copybrief SFTA::AbstractBUTreeAutomaton::Operation
 	 *
@@ -169,13 +179,47 @@ protected:// Protected methods
 		rootMap_.SetValue(lhs, root);
 	}
 
+	/**
+	 * @brief  Becomes an owner of roots of given left-hand sides
+	 *
+	 * References the roots of all left-hand sides in @p rootMap, so that
+	 * erasing them in one automaton does not release them in another one.
+	 *
+	 * @param[in]  rootMap  The left-hand sides whose roots are shared
+	 */
+	void referenceRoots(const LHSRootContainerType& rootMap)
+	{
+		SharedMTBDDType* mtbdd = ttWrapper_->GetMTBDD();
+		for (typename LHSRootContainerType::const_iterator itRoots = rootMap.begin();
+			itRoots != rootMap.end(); ++itRoots)
+		{
+			if (itRoots->second != sinkSuperState_)
+			{	// in case there is a real root
+				mtbdd->ReferenceRoot(itRoots->second);
+			}
+		}
+	}
+
 	void copyStates(const Type& aut)
 	{
 		states_.insert(aut.states_);
 		finalStates_.insert(aut.finalStates_);
 
-		// also copy superstates
-		rootMap_.insert(aut.rootMap_);
+		// also copy superstates, the nullary one and those already present
+		// are skipped
+		LHSRootContainerType newRoots(aut.sinkSuperState_);
+		for (typename LHSRootContainerType::const_iterator itRoots =
+			aut.rootMap_.begin(); itRoots != aut.rootMap_.end(); ++itRoots)
+		{
+			if (!itRoots->first.empty() &&
+				(rootMap_.GetValue(itRoots->first) == sinkSuperState_))
+			{	// in case the left-hand side is new
+				newRoots.SetValue(itRoots->first, itRoots->second);
+			}
+		}
+
+		referenceRoots(newRoots);
+		rootMap_.insert(newRoots);
 	}
 
 	void copyStates(const HierarchyRoot& aut)
@@ -206,11 +250,103 @@ protected:// Protected methods
 		return states_;
 	}
 
+
+	/**
+	 * @brief  Restricts the automaton to given states
+	 *
+	 * Removes all states that are not in given set from the states and final
+	 * states of the automaton. Left-hand sides are not affected.
+	 *
+	 * @param[in]  states  The states that are kept
+	 */
+	void restrictStates(const StateSetType& states)
+	{
+		StateSetType newStates;
+		for (typename StateSetType::const_iterator itStates = states_.begin();
+			itStates != states_.end(); ++itStates)
+		{
+			if (states.find(*itStates) != states.end())
+			{	// in case the state is kept
+				newStates.insert(*itStates);
+			}
+		}
+
+		StateSetType newFinalStates;
+		for (typename StateSetType::const_iterator itStates = finalStates_.begin();
+			itStates != finalStates_.end(); ++itStates)
+		{
+			if (states.find(*itStates) != states.end())
+			{	// in case the state is kept
+				newFinalStates.insert(*itStates);
+			}
+		}
+
+		states_ = newStates;
+		finalStates_ = newFinalStates;
+	}
+
+	inline void setRootMap(const LHSRootContainerType& rootMap)
+	{
+		rootMap_ = rootMap;
+	}
+
 	inline bool isStateLocal(const StateType& state) const
 	{
 		return (states_.find(state) != states_.end());
 	}
 
+	/**
+	 * @brief  Copies the automaton to another MTBDD manager
+	 *
+	 * Copies the states, final states and transitions of the automaton to
+	 * given automaton with a different MTBDD wrapper. The MTBDDs of
+	 * left-hand sides are copied directly between the MTBDD managers, states
+	 * keep their numbers and are reserved in the wrapper of @p aut.
+	 *
+	 * @param[out]  aut  Empty automaton the copy is stored to
+	 */
+	void copyToManager(Type& aut) const
+	{
+		// Assertions
+		assert(aut.states_.empty());
+
+		SharedMTBDDType* mtbdd = ttWrapper_->GetMTBDD();
+
+		std::vector<RootType> roots;
+		for (typename LHSRootContainerType::const_iterator itRoots = rootMap_.begin();
+			itRoots != rootMap_.end(); ++itRoots)
+		{
+			if (itRoots->second != sinkSuperState_)
+			{	// in case there is a real root
+				roots.push_back(itRoots->second);
+			}
+		}
+
+		std::vector<RootType> copies =
+			mtbdd->CopyTo(*aut.ttWrapper_->GetMTBDD(), roots);
+
+		// the copies are in the order of the roots
+		typename std::vector<RootType>::const_iterator itCopies = copies.begin();
+		for (typename LHSRootContainerType::const_iterator itRoots = rootMap_.begin();
+			itRoots != rootMap_.end(); ++itRoots)
+		{
+			if (itRoots->second != sinkSuperState_)
+			{	// in case there is a real root
+				aut.rootMap_.SetValue(itRoots->first, *itCopies);
+				++itCopies;
+			}
+		}
+
+		aut.states_ = states_;
+		aut.finalStates_ = finalStates_;
+
+		for (typename StateSetType::const_iterator itStates = states_.begin();
+			itStates != states_.end(); ++itStates)
+		{	// new states of the wrapper must not collide with the copied ones
+			aut.ttWrapper_->ReserveState(*itStates);
+		}
+	}
+
 	bool vectorContainsLocalStates(const LeftHandSideType& vec) const
 	{
 		for (typename LeftHandSideType::const_iterator it = vec.begin();
@@ -262,6 +398,9 @@ public:   // Public methods
 	{
 		// Assertions
 		assert(ttWrapper_ != static_cast<TTWrapperPtrType>(0));
+
+		GetTTWrapper()->GetMTBDD()->ReferenceRoot(sinkSuperState_);
+		referenceRoots(rootMap_);
 	}
 
 	explicit SymbolicBUTreeAutomaton(TTWrapperPtrType ttWrapper)
@@ -275,6 +414,30 @@ public:   // Public methods
 		assert(ttWrapper_ != static_cast<TTWrapperPtrType>(0));
 	}
 
+
+	/**
+	 * @brief  Destructor
+	 *
+	 * Drops the references of the automaton to the roots of its left-hand
+	 * sides and to its sink root, so that automata sharing an MTBDD manager
+	 * with a long-lived automaton do not stay in the manager. Roots shared
+	 * with another automaton are kept for the other owners.
+	 */
+	virtual ~SymbolicBUTreeAutomaton()
+	{
+		SharedMTBDDType* mtbdd = ttWrapper_->GetMTBDD();
+		for (typename LHSRootContainerType::const_iterator itRoots = rootMap_.begin();
+			itRoots != rootMap_.end(); ++itRoots)
+		{
+			if (itRoots->second != sinkSuperState_)
+			{	// in case there is a real root
+				mtbdd->EraseRoot(itRoots->second);
+			}
+		}
+
+		mtbdd->EraseRoot(sinkSuperState_);
+	}
+
 	virtual void CopyStates(const HierarchyRoot& aut)
 	{
 		copyStates(aut);
@@ -328,6 +491,34 @@ public:   // Public methods
 	}
 
 
+	/**
+	 * @brief  Adds several transitions with the same left-hand side
+	 *
+	 * Adds transitions from given left-hand side over all symbols in given
+	 * list. The transition function of the left-hand side is updated in
+	 * a single pass, which is much faster than calling AddTransition() for
+	 * each of the transitions. As with AddTransition(), right-hand sides of
+	 * already present transitions are overwritten.
+	 *
+	 * @param[in]  lhs          Left-hand side of the transitions
+	 * @param[in]  transitions  List of pairs of symbols and right-hand sides
+	 */
+	virtual void AddTransitions(const LeftHandSideType& lhs,
+		const SymbolRightHandSideListType& transitions)
+	{
+		// Assertions
+		assert(vectorContainsLocalStates(lhs));
+
+		RootType root = rootMap_.GetValue(lhs);
+		if (root == sinkSuperState_)
+		{	// in case there is not any transition from this super-state
+			root = GetTTWrapper()->GetMTBDD()->CreateRoot();
+			rootMap_.SetValue(lhs, root);
+		}
+
+		GetTTWrapper()->GetMTBDD()->SetValues(root, transitions);
+	}
+
 	virtual RightHandSideType GetTransition(const LeftHandSideType& lhs,
 		const SymbolType& symbol)
 	{
@@ -123,6 +123,16 @@ public:   // Public data types
 
 	typedef Transition TransitionType;
 
+
+	/**
+	 * @brief  Data type for transitions with the same left-hand side
+	 *
+	 * This type is used to pass pairs of symbols and right-hand sides of
+	 * several transitions with the same left-hand side at once.
+	 */
+	typedef typename MTBDDTTWrapperType::SharedMTBDDType::AssignmentListType
+		SymbolRightHandSideListType;
+
 	/**
 	 * @brief  @copybrief SFTA::AbstractTDTreeAutomaton::Operation
 	 *
@@ -179,13 +189,87 @@ protected:// Protected methods
 		return states_;
 	}
 
+	inline const LHSRootContainerType& getRootMap() const
+	{
+		return rootMap_;
+	}
+
+	inline void setRootMap(const LHSRootContainerType& rootMap)
+	{
+		rootMap_ = rootMap;
+	}
+
+
+	/**
+	 * @brief  Restricts the automaton to given states
+	 *
+	 * Removes all states that are not in given set from the states and initial
+	 * states of the automaton. Roots of the states are not affected.
+	 *
+	 * @param[in]  states  The states that are kept
+	 */
+	void restrictStates(const StateSetType& states)
+	{
+		StateSetType newStates;
+		for (typename StateSetType::const_iterator itStates = states_.begin();
+			itStates != states_.end(); ++itStates)
+		{
+			if (states.find(*itStates) != states.end())
+			{	// in case the state is kept
+				newStates.insert(*itStates);
+			}
+		}
+
+		StateSetType newInitialStates;
+		for (typename StateSetType::const_iterator itStates = initialStates_.begin();
+			itStates != initialStates_.end(); ++itStates)
+		{
+			if (states.find(*itStates) != states.end())
+			{	// in case the state is kept
+				newInitialStates.insert(*itStates);
+			}
+		}
+
+		states_ = newStates;
+		initialStates_ = newInitialStates;
+	}
+
+	/**
+	 * @brief  Becomes an owner of roots of given states
+	 *
+	 * References the roots of all states in @p rootMap, so that erasing them
+	 * in one automaton does not release them in another one.
+	 *
+	 * @param[in]  rootMap  The states whose roots are shared
+	 */
+	void referenceRoots(const LHSRootContainerType& rootMap)
+	{
+		SharedMTBDDType* mtbdd = ttWrapper_->GetMTBDD();
+		for (typename LHSRootContainerType::const_iterator itRoots = rootMap.begin();
+			itRoots != rootMap.end(); ++itRoots)
+		{
+			mtbdd->ReferenceRoot(itRoots->second);
+		}
+	}
+
 	void copyStates(const Type& aut)
 	{
 		states_.insert(aut.states_);
 		initialStates_.insert(aut.initialStates_);
 
-		// also copy MTBDD root nodes
-		rootMap_.insert(aut.rootMap_.begin(), aut.rootMap_.end());
+		// also copy MTBDD root nodes of states that are not present yet
+		LHSRootContainerType newRoots;
+		for (typename LHSRootContainerType::const_iterator itRoots =
+			aut.rootMap_.begin(); itRoots != aut.rootMap_.end(); ++itRoots)
+		{
+			if (rootMap_.find(itRoots->first) == rootMap_.end())
+			{	// in case the state is new
+				newRoots.insert(*itRoots);
+			}
+		}
+
+		referenceRoots(newRoots);
+		rootMap_.insert(newRoots.begin(), newRoots.end());
 	}
 
 	void copyStates(const HierarchyRoot& aut)
@@ -266,6 +350,9 @@ public:   // Public methods
 	{
 		// Assertions
 		assert(ttWrapper_ != static_cast<TTWrapperPtrType>(0));
+
+		GetTTWrapper()->GetMTBDD()->ReferenceRoot(sinkState_);
+		referenceRoots(rootMap_);
 	}
 
 	explicit SymbolicTDTreeAutomaton(TTWrapperPtrType ttWrapper)
@@ -280,6 +367,26 @@ public:   // Public methods
 	}
 
 
+	/**
+	 * @brief  Destructor
+	 *
+	 * Drops the references of the automaton to the roots of its states and to
+	 * its sink root. Roots shared with another automaton are kept for the
+	 * other owners.
+	 */
+	virtual ~SymbolicTDTreeAutomaton()
+	{
+		SharedMTBDDType* mtbdd = ttWrapper_->GetMTBDD();
+		for (typename LHSRootContainerType::const_iterator itRoots = rootMap_.begin();
+			itRoots != rootMap_.end(); ++itRoots)
+		{
+			mtbdd->EraseRoot(itRoots->second);
+		}
+
+		mtbdd->EraseRoot(sinkState_);
+	}
+
+
 	virtual void CopyStates(const HierarchyRoot& aut)
 	{
 		copyStates(aut);
@@ -342,6 +449,40 @@ public:   // Public methods
 		GetTTWrapper()->GetMTBDD()->SetValue(root, symbol, rhs);
 	}
 
+	/**
+	 * @brief  Adds several transitions with the same left-hand side
+	 *
+	 * Adds transitions from given left-hand side over all symbols in given
+	 * list. The transition function of the left-hand side is updated in
+	 * a single pass, which is much faster than calling AddTransition() for
+	 * each of the transitions. As with AddTransition(), right-hand sides of
+	 * already present transitions are overwritten.
+	 *
+	 * @param[in]  lhs          Left-hand side of the transitions
+	 * @param[in]  transitions  List of pairs of symbols and right-hand sides
+	 */
+	virtual void AddTransitions(const LeftHandSideType& lhs,
+		const SymbolRightHandSideListType& transitions)
+	{
+		// Assertions
+		assert(isStateLocal(lhs));
+
+		RootType root = sinkState_;
+
+		typename LHSRootContainerType::const_iterator it;
+		if ((it = rootMap_.find(lhs)) == rootMap_.end())
+		{	// in case the value is not in the hash table
+			root = GetTTWrapper()->GetMTBDD()->CreateRoot();
+			rootMap_.insert(std::make_pair(lhs, root));
+		}
+		else
+		{
+			root = it->second;
+		}
+
+		GetTTWrapper()->GetMTBDD()->SetValues(root, transitions);
+	}
+
 	virtual RightHandSideType GetTransition(const LeftHandSideType& lhs,
 		const SymbolType& symbol)
 	{
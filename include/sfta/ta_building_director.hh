@@ -12,6 +12,10 @@
 #define _SFTA_TA_BUILDING_DIRECTOR_HH_
 
 
+// Standard library headers
+#include <stdexcept>
+#include <string>
+
 // SFTA header files
 #include <sfta/abstract_ta_builder.hh>
 
@@ -51,6 +55,9 @@ public:   // Public data types
 
 	typedef SFTA::AbstractTABuilder<TreeAutomatonType> AbstractTABuilderType;
 
+	typedef typename TreeAutomatonType::ManagerConfigurationType
+		ManagerConfigurationType;
+
 private:  // Private data types
 
 	typedef typename TreeAutomatonType::SymbolDictionaryType
@@ -77,23 +84,67 @@ public:   // Public methods
 
 
 	explicit TABuildingDirector(AbstractTABuilderType* builder)
-		: defaultTa_(64 /* TODO: horrible constant */),
+		: defaultTa_(),
+			builder_(builder),
+			symbolDic_(new SymbolDictionaryType())
+	{ }
+
+
+	/**
+	 * @brief  Constructor with configuration of the MTBDD manager
+	 *
+	 * Creates the director such that all automata constructed by it share an
+	 * MTBDD manager created with given configuration.
+	 *
+	 * @param[in]  builder  The builder of automata
+	 * @param[in]  config   Configuration of the MTBDD manager
+	 */
+	TABuildingDirector(AbstractTABuilderType* builder,
+		const ManagerConfigurationType& config)
+		: defaultTa_(config),
 			builder_(builder),
-			symbolDic_(new SymbolDictionaryType(
-				typename SymbolDictionaryType::OutputSymbolType(64 /* TODO: also change to something nice */, 0)))
+			symbolDic_(new SymbolDictionaryType())
 	{ }
 
 
 	TreeAutomatonType* Construct(std::istream& is)
 	{
-		TreeAutomatonType* result = new TreeAutomatonType(defaultTa_.GetBDDSize(),
-			defaultTa_.GetTTWrapper(), symbolDic_);
+		TreeAutomatonType* result = new TreeAutomatonType(defaultTa_.GetTTWrapper(),
+			symbolDic_);
 
-		builder_->Build(is, result);
+		// transitions are inserted all at once after the input is read
+		builder_->BuildInBatch(is, result);
 
 		return result;
 	}
 
+
+	/**
+	 * @brief  Copies an automaton of another director
+	 *
+	 * Copies given automaton, which may have been constructed by another
+	 * director, to the MTBDD manager of this director. The symbol dictionary
+	 * of this director becomes a copy of the dictionary of the automaton, so
+	 * that automata constructed later translate symbols the same way; the
+	 * director therefore must not have translated any symbol yet.
+	 *
+	 * @param[in]  aut  The automaton to be copied
+	 *
+	 * @returns  The copy (owned by the caller)
+	 */
+	TreeAutomatonType* Copy(const TreeAutomatonType& aut)
+	{
+		if (!symbolDic_->GetVectorOfInputSymbols().empty())
+		{	// in case the dictionaries could disagree
+			throw std::runtime_error(__func__ +
+				std::string(": the director has already translated symbols"));
+		}
+
+		*symbolDic_ = *aut.GetSymbolDictionary();
+
+		return aut.CopyToManager(defaultTa_.GetTTWrapper(), symbolDic_);
+	}
+
 };
 
 
@@ -96,11 +96,21 @@ private:  // Private data types
 	typedef typename NDSymbolicTDTreeAutomaton::TransitionType
 		InternalTransitionType;
 
+	typedef std::map<SymbolType, InternalRightHandSideType>
+		SymbolToInternalRightHandSideMap;
+
+	typedef std::map<InternalLeftHandSideType, SymbolToInternalRightHandSideMap>
+		PendingTransitionMap;
+
 
 public:   // Public data types
 
 	typedef typename NDSymbolicTDTreeAutomaton::TTWrapperPtrType TTWrapperPtr;
 
+	typedef typename NDSymbolicTDTreeAutomaton::MTBDDTTWrapperType TTWrapperType;
+
+	typedef typename TTWrapperType::ConfigurationType ManagerConfigurationType;
+
 	typedef SFTA::SymbolDictionary
 		<
 			SymbolType,
@@ -118,8 +128,30 @@ public:   // Public data types
 	 */
 	class Operation
 	{
+	private:  // Private data members
+
+		bool isPruningProducts_;
+
 	public:   // Public methods
 
+		Operation()
+			: isPruningProducts_(false)
+		{ }
+
+
+		/**
+		 * @brief  Sets pruning of products
+		 *
+		 * Sets whether useless states are removed from the result of
+		 * Intersection().
+		 *
+		 * @param[in]  isPruning  @p true if products are to be pruned
+		 */
+		inline void SetPruningProducts(bool isPruning)
+		{
+			isPruningProducts_ = isPruning;
+		}
+
 		Type* Union(Type* lhs, Type* rhs) const;
 
 		Type* Intersection(Type* lhs, Type* rhs) const;
@@ -133,9 +165,9 @@ private:  // Private data members
 
 	SymbolDictionaryPtrType symbolDict_;
 
-	size_t bddSize_;
+	bool isBatchOpen_;
 
-	InternalSymbolType nextSymbol_;
+	PendingTransitionMap pendingTransitions_;
 
 
 private:  // Private methods
@@ -151,6 +183,8 @@ private:  // Private methods
 		return "q" + Convert::ToString(internalState);
 	}
 
+	InternalSymbolType translateSymbol(const SymbolType& symbol);
+
 	std::vector<SymbolType> translateInternalSymbolToSymbols(
 		const InternalSymbolType& internalSymbol) const;
 
@@ -162,28 +196,36 @@ private:  // Private methods
 
 public:   // Public methods
 
-	TDTreeAutomatonCover(size_t bddSize)
+	TDTreeAutomatonCover()
 		: automaton_(new NDSymbolicTDTreeAutomaton()),
 			state2internalStateMap_(),
 			symbolDict_(),
-			bddSize_(bddSize),
-			nextSymbol_(bddSize, 0)
+			isBatchOpen_(false),
+			pendingTransitions_()
 	{ }
 
-	TDTreeAutomatonCover(size_t bddSize, TTWrapperPtr wrapper, SymbolDictionaryPtrType symbolDict)
+	explicit TDTreeAutomatonCover(const ManagerConfigurationType& config)
+		: automaton_(new NDSymbolicTDTreeAutomaton(TTWrapperPtr(new TTWrapperType(config)))),
+			state2internalStateMap_(),
+			symbolDict_(),
+			isBatchOpen_(false),
+			pendingTransitions_()
+	{ }
+
+	TDTreeAutomatonCover(TTWrapperPtr wrapper, SymbolDictionaryPtrType symbolDict)
 		: automaton_(new NDSymbolicTDTreeAutomaton(wrapper)),
 			state2internalStateMap_(),
 			symbolDict_(symbolDict),
-			bddSize_(bddSize),
-			nextSymbol_(bddSize, 0)
+			isBatchOpen_(false),
+			pendingTransitions_()
 	{ }
 
-	TDTreeAutomatonCover(size_t bddSize, NDSymbolicTDTreeAutomaton* automaton, SymbolDictionaryPtrType symbolDict)
+	TDTreeAutomatonCover(NDSymbolicTDTreeAutomaton* automaton, SymbolDictionaryPtrType symbolDict)
 		: automaton_(automaton),
 			state2internalStateMap_(),
 			symbolDict_(symbolDict),
-			bddSize_(bddSize),
-			nextSymbol_(bddSize, 0)
+			isBatchOpen_(false),
+			pendingTransitions_()
 	{ }
 
 
@@ -194,11 +236,45 @@ public:   // Public methods
 	void AddTransition(const LeftHandSideType& lhs, const SymbolType& symbol,
 		const RightHandSideType& rhs);
 
+	/**
+	 * @brief  Starts a batch of transitions
+	 *
+	 * Starts a batch of transitions. Transitions added by AddTransition() are
+	 * collected until CommitTransitionBatch() is called.
+	 *
+	 * @see  CommitTransitionBatch()
+	 */
+	void BeginTransitionBatch();
+
+	/**
+	 * @brief  Commits a batch of transitions
+	 *
+	 * Inserts all transitions collected since the last call of
+	 * BeginTransitionBatch() into the automaton, building the transition
+	 * function of each state in a single pass.
+	 *
+	 * @see  BeginTransitionBatch()
+	 */
+	void CommitTransitionBatch();
+
 	void SetStateInitial(const StateType& state);
 
+
+	/**
+	 * @brief  Removes useless states
+	 *
+	 * Removes states of the automaton that do not occur in any accepting run,
+	 * together with their transitions, and forgets their names. Automata that
+	 * share transitions with this one, such as operands of a union, are not
+	 * affected.
+	 *
+	 * @returns  The number of removed states
+	 */
+	size_t RemoveUselessStates();
+
 	inline size_t GetBDDSize() const
 	{
-		return bddSize_;
+		return symbolDict_->GetEncodingWidth();
 	}
 
 	inline TTWrapperPtr GetTTWrapper()
@@ -14,6 +14,7 @@
 
 // Standard library headers
 #include <tr1/unordered_map>
+#include <vector>
 
 
 // Boost library headers
@@ -38,7 +39,9 @@ namespace SFTA
  * @date    2010
  *
  * This class implements map that projects vectors of elements to arbitrary
- * elements.
+ * elements. The map also maintains a reverse index from elements to vectors
+ * that contain them, so that all vectors with given element can be retrieved
+ * without traversing the whole map.
  *
  * @tparam  KeyElement   Data type that is used as contained type of the vector.
  * @tparam  Value        Data type that is used as the image of the function.
@@ -130,6 +133,12 @@ private:  // Private data types
 		HashTableNnary;
 
 
+	typedef std::vector<IndexType> IndexListType;
+
+	typedef std::tr1::unordered_map<KeyElementType, IndexListType, HasherUnary>
+		ReverseIndexType;
+
+
 	/**
 	 * @brief  Constant iterator
 	 *
@@ -415,9 +424,33 @@ private:  // Private data members
 
 	HashTableNnary containerN_;
 
+	ReverseIndexType reverseIndex_;
+
 private:  // Private methods
 
 
+	void addToReverseIndex(const IndexType& index)
+	{
+		for (size_t i = 0; i < index.size(); ++i)
+		{	// for each element of the vector
+			bool isFirstOccurrence = true;
+			for (size_t j = 0; j < i; ++j)
+			{	// check that the element has not been seen in the vector yet
+				if (index[j] == index[i])
+				{
+					isFirstOccurrence = false;
+					break;
+				}
+			}
+
+			if (isFirstOccurrence)
+			{	// in case the vector is not yet in the list of the element
+				reverseIndex_[index[i]].push_back(index);
+			}
+		}
+	}
+
+
 	const ValueType& getValueForArity0(const IndexType& lhs) const
 	{
 		// Assertions
@@ -487,6 +520,7 @@ private:  // Private methods
 		if ((itHash = container1_.find(lhs[0])) == container1_.end())
 		{
 			container1_.insert(std::make_pair(lhs[0], value));
+			addToReverseIndex(lhs);
 		}
 		else
 		{
@@ -503,6 +537,7 @@ private:  // Private methods
 		if ((itHash = container2_.find(std::make_pair(lhs[0], lhs[1]))) == container2_.end())
 		{
 			container2_.insert(std::make_pair(std::make_pair(lhs[0], lhs[1]), value));
+			addToReverseIndex(lhs);
 		}
 		else
 		{
@@ -519,6 +554,7 @@ private:  // Private methods
 		if ((itHash = containerN_.find(lhs)) == containerN_.end())
 		{
 			containerN_.insert(std::make_pair(lhs, value));
+			addToReverseIndex(lhs);
 		}
 		else
 		{
@@ -533,7 +569,8 @@ public:   // Public methods
 			container0_(defaultValue_),
 			container1_(),
 			container2_(),
-			containerN_()
+			containerN_(),
+			reverseIndex_()
 	{ }
 
 	const ValueType& GetValue(const IndexType& index) const
@@ -558,102 +595,79 @@ public:   // Public methods
 		}
 	}
 
-	template <template <typename> class TSet>
-	IndexValueArray GetItemsWith(const KeyElementType& elem,
-		const TSet<KeyElementType>& elemDomain) const
+	/**
+	 * @brief  Returns all vectors with an element
+	 *
+	 * Returns all vectors that contain given element together with their
+	 * values, grouped by the length of the vectors. The vectors are taken
+	 * from the reverse index, so the complexity is proportional to the number
+	 * of the returned vectors.
+	 *
+	 * @param[in]  elem  The element
+	 *
+	 * @returns  Array of vectors with the element indexed by their length
+	 */
+	IndexValueArray GetItemsWith(const KeyElementType& elem) const
 	{
-		typedef TSet<KeyElementType> DomainSetType;
 		// start with arrays for nullary, unary and binary vectors
 		IndexValueArray result(3);
 
+		typename ReverseIndexType::const_iterator itReverse;
+		if ((itReverse = reverseIndex_.find(elem)) == reverseIndex_.end())
+		{	// in case there is no vector with the element
+			return result;
+		}
 
-		{	// for unary items
-			typename HashTableUnary::const_iterator itUnary;
-			if ((itUnary = container1_.find(elem)) != container1_.end())
-			{	// in case the value is in the hash table
-				IndexType index;
-				index.push_back(elem);
-				IndexValueType valuePair = std::make_pair(index, itUnary->second);
-
-				result[1].push_back(valuePair);
+		const IndexListType& indices = itReverse->second;
+		for (typename IndexListType::const_iterator itIndices = indices.begin();
+			itIndices != indices.end(); ++itIndices)
+		{	// for each vector with the element
+			while (result.size() <= itIndices->size())
+			{
+				result.push_back(SameLengthIndexValueVector());
 			}
+
+			result[itIndices->size()].push_back(
+				std::make_pair(*itIndices, GetValue(*itIndices)));
 		}
 
+		return result;
+	}
 
-		// for binary items
-		for (typename DomainSetType::const_iterator itDom = elemDomain.begin();
-			itDom != elemDomain.end(); ++itDom)
+	void insert(const VectorMap& vecMap)
+	{
+		// copy all vectors (without the nullary one)
+		for (typename HashTableUnary::const_iterator itUnary =
+			vecMap.container1_.begin(); itUnary != vecMap.container1_.end(); ++itUnary)
 		{
-			// when desired element is at the first position
-			KeyElementPairType binaryKey;
-			binaryKey.first = elem;
-			binaryKey.second = *itDom;
-
-			typename HashTableBinary::const_iterator itBinary;
-			if ((itBinary = container2_.find(binaryKey)) != container2_.end())
-			{	// in case the value is in the hash table
+			if (container1_.insert(*itUnary).second)
+			{	// in case the vector is new
 				IndexType index;
-				index.push_back(elem);
-				index.push_back(*itDom);
-				IndexValueType valuePair = std::make_pair(index, itBinary->second);
-
-				result[2].push_back(valuePair);
-			}
-
-			if (elem == *itDom)
-			{	// in case the first and second element is the same, return only once
-				continue;
+				index.push_back(itUnary->first);
+				addToReverseIndex(index);
 			}
+		}
 
-			// when desired element is at the second position
-			binaryKey.first = *itDom;
-			binaryKey.second = elem;
-
-			if ((itBinary = container2_.find(binaryKey)) != container2_.end())
-			{	// in case the value is in the hash table
+		for (typename HashTableBinary::const_iterator itBinary =
+			vecMap.container2_.begin(); itBinary != vecMap.container2_.end(); ++itBinary)
+		{
+			if (container2_.insert(*itBinary).second)
+			{	// in case the vector is new
 				IndexType index;
-				index.push_back(*itDom);
-				index.push_back(elem);
-				IndexValueType valuePair = std::make_pair(index, itBinary->second);
-
-				result[2].push_back(valuePair);
+				index.push_back(itBinary->first.first);
+				index.push_back(itBinary->first.second);
+				addToReverseIndex(index);
 			}
 		}
 
-
-		// for n-nary items
-		for (typename HashTableNnary::const_iterator itNnary = containerN_.begin();
-			itNnary != containerN_.end(); ++itNnary)
-		{	// traverse the whole container
-			const IndexType& vec = itNnary->first;
-			for (typename IndexType::const_iterator itIndex = vec.begin();
-				itIndex != vec.end(); ++itIndex)
-			{	// try to find desired element in the vector
-				if (*itIndex == elem)
-				{	// in case it is there
-					IndexValueType valuePair = std::make_pair(vec, itNnary->second);
-
-					while (result.size() <= vec.size())
-					{
-						result.push_back(SameLengthIndexValueVector());
-					}
-
-					result[vec.size()].push_back(valuePair);
-
-					break;
-				}
+		for (typename HashTableNnary::const_iterator itNnary =
+			vecMap.containerN_.begin(); itNnary != vecMap.containerN_.end(); ++itNnary)
+		{
+			if (containerN_.insert(*itNnary).second)
+			{	// in case the vector is new
+				addToReverseIndex(itNnary->first);
 			}
 		}
-
-		return result;
-	}
-
-	void insert(const VectorMap& vecMap)
-	{
-		// copy all vectors (without the nullary one)
-		container1_.insert(vecMap.container1_.begin(), vecMap.container1_.end());
-		container2_.insert(vecMap.container2_.begin(), vecMap.container2_.end());
-		containerN_.insert(vecMap.containerN_.begin(), vecMap.containerN_.end());
 	}
 
 	const_iterator begin() const
@@ -0,0 +1,236 @@
+/*****************************************************************************
+ *  Symbolic Finite Tree Automata Library
+ *
+ *  Copyright (c) 2010  Ondra Lengal <ondra@lengal.net>
+ *
+ *  Description:
+ *    Header file with WitnessTree class that represents a tree witnessing
+ *    that language inclusion does not hold.
+ *
+ *****************************************************************************/
+
+#ifndef _SFTA_WITNESS_TREE_HH_
+#define _SFTA_WITNESS_TREE_HH_
+
+// Standard library headers
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// SFTA headers
+#include <sfta/convert.hh>
+
+
+// insert the class into proper namespace
+namespace SFTA
+{
+	template
+	<
+		typename Symbol
+	>
+	class WitnessTree;
+}
+
+
+/**
+ * @brief   Witness tree
+ * @author  Ondra Lengal <ondra@lengal.net>
+ * @date    2010
+ *
+ * A tree labelled by symbols, such as a tree that is accepted by one
+ * automaton and not by another one, or a tree queried for membership in the
+ * language of an automaton. Nodes are stored in a vector and refer to their
+ * children by indices, so a subtree may be shared by several nodes. The
+ * children of a node need to be added before the node itself.
+ *
+ * @tparam  Symbol  Data type for symbols.
+ */
+template
+<
+	typename Symbol
+>
+class SFTA::WitnessTree
+{
+public:   // Public data types
+
+	typedef Symbol SymbolType;
+
+	typedef std::vector<size_t> ChildrenType;
+
+
+	/**
+	 * @brief  Node of the tree
+	 *
+	 * The symbol of the node together with indices of its children.
+	 */
+	struct Node
+	{
+		SymbolType symbol;
+		ChildrenType children;
+
+		Node(const SymbolType& sym, const ChildrenType& chld)
+			: symbol(sym),
+				children(chld)
+		{ }
+	};
+
+private:  // Private data types
+
+	typedef std::vector<Node> NodeVectorType;
+	typedef SFTA::Private::Convert Convert;
+
+
+	/**
+	 * @brief  Default translator of symbols
+	 *
+	 * Translates a symbol to string using Convert::ToString().
+	 */
+	struct DefaultTranslator
+	{
+		std::string operator()(const SymbolType& symbol) const
+		{
+			return Convert::ToString(symbol);
+		}
+	};
+
+private:  // Private data members
+
+	NodeVectorType nodes_;
+
+	size_t root_;
+
+private:  // Private methods
+
+	template <class SymbolTranslator>
+	std::string nodeToString(size_t node, const SymbolTranslator& translator) const
+	{
+		const Node& nd = GetNode(node);
+
+		std::string result = translator(nd.symbol);
+		if (!nd.children.empty())
+		{	// in case the node is not a leaf
+			result += "(";
+			for (size_t i = 0; i < nd.children.size(); ++i)
+			{
+				if (i > 0)
+				{
+					result += ", ";
+				}
+
+				result += nodeToString(nd.children[i], translator);
+			}
+
+			result += ")";
+		}
+
+		return result;
+	}
+
+public:   // Public methods
+
+	WitnessTree()
+		: nodes_(),
+			root_(0)
+	{ }
+
+
+	/**
+	 * @brief  Adds a node
+	 *
+	 * Adds a node with given symbol and children. The last added node is the
+	 * root of the tree unless SetRoot() is called.
+	 *
+	 * @param[in]  symbol    The symbol of the node
+	 * @param[in]  children  Indices of the children of the node
+	 *
+	 * @returns  The index of the node
+	 */
+	size_t AddNode(const SymbolType& symbol, const ChildrenType& children)
+	{
+		for (ChildrenType::const_iterator itChildren = children.begin();
+			itChildren != children.end(); ++itChildren)
+		{
+			if (*itChildren >= nodes_.size())
+			{	// in case the child has not been added yet
+				throw std::runtime_error(__func__ +
+					std::string(": invalid child ") + Convert::ToString(*itChildren));
+			}
+		}
+
+		nodes_.push_back(Node(symbol, children));
+		root_ = nodes_.size() - 1;
+
+		return root_;
+	}
+
+	inline void SetRoot(size_t root)
+	{
+		if (root >= nodes_.size())
+		{
+			throw std::runtime_error(__func__ +
+				std::string(": invalid root ") + Convert::ToString(root));
+		}
+
+		root_ = root;
+	}
+
+	inline size_t GetRoot() const
+	{
+		return root_;
+	}
+
+	inline const Node& GetNode(size_t node) const
+	{
+		if (node >= nodes_.size())
+		{
+			throw std::runtime_error(__func__ +
+				std::string(": invalid node ") + Convert::ToString(node));
+		}
+
+		return nodes_[node];
+	}
+
+	inline bool IsEmpty() const
+	{
+		return nodes_.empty();
+	}
+
+	inline size_t Size() const
+	{
+		return nodes_.size();
+	}
+
+	inline void Clear()
+	{
+		nodes_.clear();
+		root_ = 0;
+	}
+
+
+	/**
+	 * @brief  Converts the tree to a term
+	 *
+	 * Converts the tree to a term in the syntax of Timbuk, e.g. @p f(a, g(b)).
+	 *
+	 * @param[in]  translator  Functor that converts a symbol to string
+	 *
+	 * @returns  The term, or an empty string if the tree is empty
+	 */
+	template <class SymbolTranslator>
+	std::string ToString(const SymbolTranslator& translator) const
+	{
+		if (IsEmpty())
+		{
+			return std::string();
+		}
+
+		return nodeToString(root_, translator);
+	}
+
+	std::string ToString() const
+	{
+		return ToString(DefaultTranslator());
+	}
+};
+
+#endif
@@ -0,0 +1,247 @@
+/*****************************************************************************
+ *  Symbolic Finite Tree Automata Library
+ *
+ *  Copyright (c) 2010  Ondra Lengal <ondra@lengal.net>
+ *
+ *  Description:
+ *    Header file with WorkStealingQueue class that distributes independent
+ *    tasks among worker threads.
+ *
+ *****************************************************************************/
+
+#ifndef _SFTA_WORK_STEALING_QUEUE_HH_
+#define _SFTA_WORK_STEALING_QUEUE_HH_
+
+// Standard library headers
+#include <deque>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// POSIX headers
+#include <pthread.h>
+
+// SFTA headers
+#include <sfta/convert.hh>
+
+
+// insert the class into proper namespace
+namespace SFTA
+{
+	namespace Private
+	{
+		class WorkStealingQueue;
+	}
+}
+
+
+/**
+ * @brief   Work stealing queue
+ * @author  Ondra Lengal <ondra@lengal.net>
+ * @date    2010
+ *
+ * Queue of independent tasks, given by their indices, for a fixed number of
+ * worker threads. Every worker has its own deque of tasks and takes tasks
+ * from its front. A worker whose deque is empty steals a task from the back
+ * of the deque of another worker, so that workers that got easy tasks help
+ * the others. All tasks need to be pushed before the workers start, a
+ * worker is finished when Pop() fails.
+ */
+class SFTA::Private::WorkStealingQueue
+{
+public:   // Public data types
+
+	typedef size_t TaskType;
+
+private:  // Private data types
+
+	typedef SFTA::Private::Convert Convert;
+
+	typedef std::deque<TaskType> TaskDequeType;
+
+
+	/**
+	 * @brief  Deque of a worker
+	 *
+	 * Tasks of a single worker together with the mutex that guards them.
+	 */
+	struct WorkerDeque
+	{
+		pthread_mutex_t mutex;
+		TaskDequeType tasks;
+
+		WorkerDeque()
+			: mutex(),
+				tasks()
+		{ }
+	};
+
+	typedef std::vector<WorkerDeque> WorkerDequeVectorType;
+
+private:  // Private data members
+
+	WorkerDequeVectorType deques_;
+
+	pthread_mutex_t statisticsMutex_;
+
+	size_t stolenTasks_;
+
+private:  // Private methods
+
+	WorkStealingQueue(const WorkStealingQueue& queue);
+	WorkStealingQueue& operator=(const WorkStealingQueue& rhs);
+
+	inline void checkWorker(size_t worker) const
+	{
+		if (worker >= deques_.size())
+		{	// in case the worker is unknown
+			throw std::runtime_error(__func__ +
+				std::string(": invalid worker ") + Convert::ToString(worker));
+		}
+	}
+
+public:   // Public methods
+
+	explicit WorkStealingQueue(size_t numWorkers)
+		: deques_(numWorkers),
+			statisticsMutex_(),
+			stolenTasks_(0)
+	{
+		if (numWorkers == 0)
+		{	// in case there would be nobody to do the work
+			throw std::runtime_error(__func__ +
+				std::string(": there needs to be at least one worker"));
+		}
+
+		for (size_t i = 0; i < deques_.size(); ++i)
+		{	// the deques are in place now, so the mutexes can be initialized
+			pthread_mutex_init(&deques_[i].mutex, static_cast<pthread_mutexattr_t*>(0));
+		}
+
+		pthread_mutex_init(&statisticsMutex_, static_cast<pthread_mutexattr_t*>(0));
+	}
+
+
+	/**
+	 * @brief  Adds a task
+	 *
+	 * Adds a task to the back of the deque of given worker. Tasks are not to
+	 * be pushed once the workers have started.
+	 *
+	 * @param[in]  worker  The worker
+	 * @param[in]  task    The task
+	 */
+	inline void Push(size_t worker, const TaskType& task)
+	{
+		checkWorker(worker);
+
+		deques_[worker].tasks.push_back(task);
+	}
+
+
+	/**
+	 * @brief  Adds tasks in a round-robin fashion
+	 *
+	 * Adds tasks @p 0, ..., @p numTasks - 1 such that the @p i -th task is
+	 * added to the deque of worker @p i modulo the number of workers.
+	 *
+	 * @param[in]  numTasks  The number of tasks
+	 */
+	void PushRoundRobin(size_t numTasks)
+	{
+		for (TaskType task = 0; task < numTasks; ++task)
+		{	// distribute the tasks
+			Push(task % deques_.size(), task);
+		}
+	}
+
+
+	/**
+	 * @brief  Takes a task
+	 *
+	 * Takes the task from the front of the deque of given worker. If the
+	 * deque is empty, a task is stolen from the back of the deque of another
+	 * worker, starting with the next one.
+	 *
+	 * @param[in]   worker  The worker
+	 * @param[out]  task    The task
+	 *
+	 * @returns  @p false if there are no tasks left, @p true otherwise
+	 */
+	bool Pop(size_t worker, TaskType& task)
+	{
+		checkWorker(worker);
+
+		for (size_t i = 0; i < deques_.size(); ++i)
+		{	// try own deque first, then the others
+			size_t victim = (worker + i) % deques_.size();
+			WorkerDeque& deque = deques_[victim];
+
+			pthread_mutex_lock(&deque.mutex);
+			bool isFound = !deque.tasks.empty();
+			if (isFound)
+			{	// in case there is a task
+				if (victim == worker)
+				{	// in case the task is from own deque
+					task = deque.tasks.front();
+					deque.tasks.pop_front();
+				}
+				else
+				{	// in case the task is stolen
+					task = deque.tasks.back();
+					deque.tasks.pop_back();
+				}
+			}
+			pthread_mutex_unlock(&deque.mutex);
+
+			if (isFound)
+			{	// in case a task was taken
+				if (victim != worker)
+				{	// in case it was stolen
+					pthread_mutex_lock(&statisticsMutex_);
+					++stolenTasks_;
+					pthread_mutex_unlock(&statisticsMutex_);
+				}
+
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+
+	/**
+	 * @brief  Returns the number of stolen tasks
+	 *
+	 * Returns the number of tasks that were taken by other workers than the
+	 * workers they were pushed for.
+	 *
+	 * @returns  The number of stolen tasks
+	 */
+	size_t GetNumberOfStolenTasks()
+	{
+		pthread_mutex_lock(&statisticsMutex_);
+		size_t result = stolenTasks_;
+		pthread_mutex_unlock(&statisticsMutex_);
+
+		return result;
+	}
+
+	inline size_t GetNumberOfWorkers() const
+	{
+		return deques_.size();
+	}
+
+	~WorkStealingQueue()
+	{
+		for (size_t i = 0; i < deques_.size(); ++i)
+		{
+			pthread_mutex_destroy(&deques_[i].mutex);
+		}
+
+		pthread_mutex_destroy(&statisticsMutex_);
+	}
+};
+
+#endif
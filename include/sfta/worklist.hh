@@ -0,0 +1,214 @@
+/*****************************************************************************
+ *  Symbolic Finite Tree Automata Library
+ *
+ *  Copyright (c) 2010  Ondra Lengal <ondra@lengal.net>
+ *
+ *  Description:
+ *    Header file with Worklist class that returns items in the order given
+ *    by an exploration strategy.
+ *
+ *****************************************************************************/
+
+#ifndef _SFTA_WORKLIST_HH_
+#define _SFTA_WORKLIST_HH_
+
+// Standard library headers
+#include <algorithm>
+#include <deque>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+
+// insert the class into proper namespace
+namespace SFTA
+{
+	/**
+	 * @brief  Exploration strategy of a worklist
+	 *
+	 * The order in which items of a worklist are processed.
+	 */
+	enum WorklistStrategy
+	{
+		WORKLIST_BFS = 0,         // breadth-first, the oldest item first
+		WORKLIST_DFS,             // depth-first, the newest item first
+		WORKLIST_PRIORITY         // the item with the lowest priority first
+	};
+
+	namespace Private
+	{
+		template
+		<
+			typename Item,
+			class Priority
+		>
+		class Worklist;
+	}
+}
+
+
+/**
+ * @brief   Worklist
+ * @author  Ondra Lengal <ondra@lengal.net>
+ * @date    2010
+ *
+ * Container of items waiting for processing. The order in which the items
+ * are removed is given by the strategy of the worklist: the breadth-first
+ * strategy behaves as a queue, the depth-first strategy behaves as a stack
+ * and the priority strategy removes the item with the lowest priority, where
+ * items with the same priority are removed in the order of insertion.
+ *
+ * @tparam  Item      The type of items.
+ * @tparam  Priority  Functor that computes the priority (a @p size_t value) of
+ *                    an item.
+ */
+template
+<
+	typename Item,
+	class Priority
+>
+class SFTA::Private::Worklist
+{
+public:   // Public data types
+
+	typedef Item ItemType;
+	typedef Priority PriorityType;
+
+private:  // Private data types
+
+	typedef std::deque<ItemType> ItemDequeType;
+
+
+	/**
+	 * @brief  Item of the heap
+	 *
+	 * The item together with its priority and the number of its insertion.
+	 */
+	struct HeapItem
+	{
+		size_t priority;
+		size_t number;
+		ItemType item;
+
+		HeapItem(size_t prio, size_t num, const ItemType& it)
+			: priority(prio),
+				number(num),
+				item(it)
+		{ }
+
+		// the heap has the greatest item on the top, so the order is reversed
+		friend bool operator<(const HeapItem& lhs, const HeapItem& rhs)
+		{
+			return (lhs.priority > rhs.priority) ||
+				((lhs.priority == rhs.priority) && (lhs.number > rhs.number));
+		}
+	};
+
+	typedef std::vector<HeapItem> HeapType;
+
+private:  // Private data members
+
+	WorklistStrategy strategy_;
+
+	PriorityType priority_;
+
+
+	/**
+	 * Items for the breadth-first and the depth-first strategy.
+	 */
+	ItemDequeType items_;
+
+
+	/**
+	 * Items for the priority strategy.
+	 */
+	HeapType heap_;
+
+
+	/**
+	 * The number of inserted items.
+	 */
+	size_t counter_;
+
+public:   // Public methods
+
+	explicit Worklist(WorklistStrategy strategy,
+		const PriorityType& priority = PriorityType())
+		: strategy_(strategy),
+			priority_(priority),
+			items_(),
+			heap_(),
+			counter_(0)
+	{ }
+
+	inline WorklistStrategy GetStrategy() const
+	{
+		return strategy_;
+	}
+
+	void Push(const ItemType& item)
+	{
+		if (strategy_ == WORKLIST_PRIORITY)
+		{	// in case the items are ordered by priority
+			heap_.push_back(HeapItem(priority_(item), counter_, item));
+			std::push_heap(heap_.begin(), heap_.end());
+		}
+		else
+		{
+			items_.push_back(item);
+		}
+
+		++counter_;
+	}
+
+
+	/**
+	 * @brief  Removes the next item
+	 *
+	 * Removes the next item according to the strategy of the worklist.
+	 *
+	 * @returns  The removed item
+	 */
+	ItemType Pop()
+	{
+		if (IsEmpty())
+		{
+			throw std::runtime_error(__func__ + std::string(": the worklist is empty"));
+		}
+
+		if (strategy_ == WORKLIST_PRIORITY)
+		{	// in case the items are ordered by priority
+			std::pop_heap(heap_.begin(), heap_.end());
+			ItemType result = heap_.back().item;
+			heap_.pop_back();
+
+			return result;
+		}
+		else if (strategy_ == WORKLIST_DFS)
+		{	// in case the newest item goes first
+			ItemType result = items_.back();
+			items_.pop_back();
+
+			return result;
+		}
+		else
+		{	// in case the oldest item goes first
+			ItemType result = items_.front();
+			items_.pop_front();
+
+			return result;
+		}
+	}
+
+	inline bool IsEmpty() const
+	{
+		return items_.empty() && heap_.empty();
+	}
+
+	inline size_t Size() const
+	{
+		return items_.size() + heap_.size();
+	}
+};
+
+#endif
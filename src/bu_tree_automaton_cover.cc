@@ -8,6 +8,11 @@
  *
  *****************************************************************************/
 
+// Standard library headers
+#include <algorithm>
+#include <cctype>
+
+// SFTA headers
 #include <sfta/bu_tree_automaton_cover.hh>
 
 
@@ -86,6 +91,7 @@ void SFTA::BUTreeAutomatonCover::SetStateFinal(const StateType& state)
 	else
 	{	// in case we know the state
 		automaton_->SetStateFinal(itStates->second);
+		invalidateCache();
 	}
 }
 
@@ -112,13 +118,9 @@ void SFTA::BUTreeAutomatonCover::AddTransition(const LeftHandSideType& lhs,
 	}
 
 	// translate the symbol
-	InternalSymbolType internalSymbol = symbolDict_->Translate(symbol);
+	InternalSymbolType internalSymbol = translateSymbol(symbol);
 
-	// retrieve the original right-hand side
-	InternalRightHandSideType origRhs =
-		automaton_->GetTransition(internalLhs, internalSymbol);
-
-	// add new states
+	InternalRightHandSideType newRhs;
 	for (typename RightHandSideType::const_iterator itRhs = rhs.begin();
 		itRhs != rhs.end(); ++itRhs)
 	{
@@ -130,11 +132,96 @@ void SFTA::BUTreeAutomatonCover::AddTransition(const LeftHandSideType& lhs,
 				std::string(": transition to unknown symbol = " +
 				Convert::ToString(*itRhs)));
 		}
-		origRhs.insert(itStates->second);
+		newRhs.insert(itStates->second);
 	}
 
+	if (isBatchOpen_)
+	{	// in case we are in a batch, postpone the insertion
+		pendingTransitions_[internalLhs][symbol].insert(newRhs);
+		return;
+	}
+
+	// retrieve the original right-hand side
+	InternalRightHandSideType origRhs =
+		automaton_->GetTransition(internalLhs, internalSymbol);
+
+	// add new states
+	origRhs.insert(newRhs);
+
 	// update the right-hand side
 	automaton_->AddTransition(internalLhs, internalSymbol, origRhs);
+	invalidateCache();
+}
+
+
+void SFTA::BUTreeAutomatonCover::BeginTransitionBatch()
+{
+	if (isBatchOpen_)
+	{	// in case there is already a batch
+		throw std::logic_error(__func__ +
+			std::string(": a batch of transitions is already open"));
+	}
+
+	isBatchOpen_ = true;
+}
+
+
+void SFTA::BUTreeAutomatonCover::CommitTransitionBatch()
+{
+	if (!isBatchOpen_)
+	{	// in case there is no batch
+		throw std::logic_error(__func__ +
+			std::string(": no batch of transitions is open"));
+	}
+
+	typedef NDSymbolicBUTreeAutomaton::SymbolRightHandSideListType
+		SymbolRightHandSideList;
+
+	for (typename PendingTransitionMap::const_iterator itLhs =
+		pendingTransitions_.begin(); itLhs != pendingTransitions_.end(); ++itLhs)
+	{	// for each left-hand side
+		const SymbolToInternalRightHandSideMap& symbolMap = itLhs->second;
+
+		SymbolRightHandSideList transitions;
+		transitions.reserve(symbolMap.size());
+		for (typename SymbolToInternalRightHandSideMap::const_iterator itSymbol =
+			symbolMap.begin(); itSymbol != symbolMap.end(); ++itSymbol)
+		{	// for each symbol, merge with transitions from before the batch
+			// (the encoding of the symbol may have grown since it was added)
+			InternalSymbolType internalSymbol = symbolDict_->Translate(itSymbol->first);
+
+			InternalRightHandSideType rhs =
+				automaton_->GetTransition(itLhs->first, internalSymbol);
+			rhs.insert(itSymbol->second);
+
+			transitions.push_back(std::make_pair(internalSymbol, rhs));
+		}
+
+		automaton_->AddTransitions(itLhs->first, transitions);
+	}
+
+	pendingTransitions_.clear();
+	isBatchOpen_ = false;
+
+	invalidateCache();
+}
+
+
+SFTA::BUTreeAutomatonCover::Type* SFTA::BUTreeAutomatonCover::CopyToManager(
+	TTWrapperPtr wrapper, SymbolDictionaryPtrType symbolDict) const
+{
+	if (isBatchOpen_)
+	{	// in case some transitions are not in the automaton yet
+		throw std::logic_error(__func__ +
+			std::string(": a batch of transitions is open"));
+	}
+
+	std::auto_ptr<Type> result(
+		new Type(automaton_->CopyToManager(wrapper), symbolDict));
+	result->state2internalStateMap_ = state2internalStateMap_;
+	result->areStatesFromOutside_ = areStatesFromOutside_;
+
+	return result.release();
 }
 
 
@@ -149,6 +236,138 @@ void SFTA::BUTreeAutomatonCover::AddState(const StateType& state)
 			std::string(": inserting already existing state " +
 			Convert::ToString(state)));
 	}
+
+	invalidateCache();
+}
+
+
+void SFTA::BUTreeAutomatonCover::forgetRemovedStates()
+{
+	InternalStateVector states = automaton_->GetVectorOfStates();
+
+	typename StateToInternalStateMap::iterator itStates =
+		state2internalStateMap_.begin();
+	while (itStates != state2internalStateMap_.end())
+	{
+		if (std::binary_search(states.begin(), states.end(), itStates->second))
+		{	// in case the state is kept
+			++itStates;
+		}
+		else
+		{
+			state2internalStateMap_.erase(itStates++);
+		}
+	}
+}
+
+
+const SFTA::BUTreeAutomatonCover::NDSymbolicTDTreeAutomaton*
+	SFTA::BUTreeAutomatonCover::getTopDownAutomaton() const
+{
+	if (topDownCache_.get() == static_cast<NDSymbolicTDTreeAutomaton*>(0))
+	{	// in case the automaton has not been converted yet
+		topDownCache_.reset(automaton_->GetTopDownAutomaton());
+	}
+
+	return topDownCache_.get();
+}
+
+
+const SFTA::BUTreeAutomatonCover::InternalSimulationType*
+	SFTA::BUTreeAutomatonCover::getSimulation() const
+{
+	typedef typename NDSymbolicBUTreeAutomaton::HierarchyRoot AbstractAutomaton;
+	typedef typename AbstractAutomaton::Operation InternalOperationType;
+
+	if (simulationCache_.get() == static_cast<InternalSimulationType*>(0))
+	{	// in case the simulation has not been computed yet
+		std::auto_ptr<InternalOperationType> oper(automaton_->GetOperation());
+		simulationCache_.reset(oper->ComputeSimulationPreorder(automaton_.get()));
+	}
+
+	return simulationCache_.get();
+}
+
+
+const SFTA::BUTreeAutomatonCover::InternalSimulationType*
+	SFTA::BUTreeAutomatonCover::getIdentityRelation() const
+{
+	typedef typename NDSymbolicBUTreeAutomaton::HierarchyRoot AbstractAutomaton;
+	typedef typename AbstractAutomaton::Operation InternalOperationType;
+
+	if (identityCache_.get() == static_cast<InternalSimulationType*>(0))
+	{	// in case the relation has not been computed yet
+		std::auto_ptr<InternalOperationType> oper(automaton_->GetOperation());
+		identityCache_.reset(oper->GetIdentityRelation(automaton_.get()));
+	}
+
+	return identityCache_.get();
+}
+
+
+void SFTA::BUTreeAutomatonCover::invalidateCache()
+{
+	topDownCache_.reset();
+	simulationCache_.reset();
+	identityCache_.reset();
+}
+
+
+size_t SFTA::BUTreeAutomatonCover::RemoveUselessStates()
+{
+	size_t removedStates = automaton_->RemoveUselessStates();
+	invalidateCache();
+
+	if (removedStates > 0)
+	{	// in case some states were removed, forget their names
+		forgetRemovedStates();
+	}
+
+	return removedStates;
+}
+
+
+SFTA::BUTreeAutomatonCover::ReductionStatisticsType
+	SFTA::BUTreeAutomatonCover::ReduceBySimulation()
+{
+	// the simulation may have been computed by a check of language inclusion
+	ReductionStatisticsType stats = automaton_->ReduceBySimulation(*getSimulation());
+	invalidateCache();
+
+	if (stats.removedStates > 0)
+	{	// in case some states were merged, forget their names
+		forgetRemovedStates();
+	}
+
+	return stats;
+}
+
+
+bool SFTA::BUTreeAutomatonCover::Accepts(const std::string& term) const
+{
+	InternalTreeType tree;
+	bool areSymbolsKnown = true;
+
+	size_t pos = 0;
+	parseTerm(term, pos, tree, areSymbolsKnown);
+
+	while ((pos < term.length()) && isspace(static_cast<unsigned char>(term[pos])))
+	{	// skip trailing whitespace
+		++pos;
+	}
+
+	if (pos != term.length())
+	{	// in case there is something after the term
+		throw std::runtime_error(__func__ + std::string(": invalid term ") + term);
+	}
+
+	if (!areSymbolsKnown)
+	{	// in case there is no transition over some symbol
+		SFTA_LOGGER_INFO("Term " + term + " contains an unknown symbol");
+		return false;
+	}
+
+	return automaton_->Accepts(tree);
 }
 
 
@@ -196,6 +415,21 @@ std::string SFTA::BUTreeAutomatonCover::statesToString(
 	return result;
 }
 
+SFTA::BUTreeAutomatonCover::InternalSymbolType
+	SFTA::BUTreeAutomatonCover::translateSymbol(const SymbolType& symbol)
+{
+	size_t oldWidth = symbolDict_->GetEncodingWidth();
+
+	InternalSymbolType internalSymbol = symbolDict_->Translate(symbol);
+
+	for (size_t var = oldWidth; var < symbolDict_->GetEncodingWidth(); ++var)
+	{	// symbols encoded so far have value 0 of variables added to the encoding
+		automaton_->GetTTWrapper()->GetMTBDD()->RestrictVariableToZero(var);
+	}
+
+	return internalSymbol;
+}
+
 std::vector<SFTA::BUTreeAutomatonCover::SymbolType>
 	SFTA::BUTreeAutomatonCover::translateInternalSymbolToSymbols(
 	const InternalSymbolType& internalSymbol) const
@@ -204,7 +438,14 @@ std::vector<SFTA::BUTreeAutomatonCover::SymbolType>
 
 	typedef std::vector<InternalSymbolType> InternalSymbolVector;
 
-	InternalSymbolVector symbols = internalSymbol.GetVectorOfConcreteSymbols();
+	// the symbol need not contain variables the MTBDD does not depend on
+	InternalSymbolType paddedSymbol = internalSymbol;
+	if (paddedSymbol.VariablesCount() < symbolDict_->GetEncodingWidth())
+	{	// in case some variables are missing, they are don't care
+		paddedSymbol.AddVariablesUpTo(symbolDict_->GetEncodingWidth() - 1);
+	}
+
+	InternalSymbolVector symbols = paddedSymbol.GetVectorOfConcreteSymbols();
 	for (typename InternalSymbolVector::const_iterator itSym = symbols.begin();
 		itSym != symbols.end(); ++itSym)
 	{
@@ -214,6 +455,74 @@ std::vector<SFTA::BUTreeAutomatonCover::SymbolType>
 	return result;
 }
 
+size_t SFTA::BUTreeAutomatonCover::parseTerm(const std::string& term,
+	size_t& pos, InternalTreeType& tree, bool& areSymbolsKnown) const
+{
+	while ((pos < term.length()) && isspace(static_cast<unsigned char>(term[pos])))
+	{	// skip leading whitespace
+		++pos;
+	}
+
+	size_t begin = pos;
+	while ((pos < term.length()) &&
+		!isspace(static_cast<unsigned char>(term[pos])) &&
+		(term[pos] != '(') && (term[pos] != ')') && (term[pos] != ','))
+	{	// read the name of the symbol
+		++pos;
+	}
+
+	if (pos == begin)
+	{	// in case the symbol is missing
+		throw std::runtime_error(__func__ + std::string(": missing symbol at position ")
+			+ Convert::ToString(pos) + " of " + term);
+	}
+
+	SymbolType symbol = term.substr(begin, pos - begin);
+
+	while ((pos < term.length()) && isspace(static_cast<unsigned char>(term[pos])))
+	{
+		++pos;
+	}
+
+	typename InternalTreeType::ChildrenType children;
+	if ((pos < term.length()) && (term[pos] == '('))
+	{	// in case the node has children
+		do
+		{	// parse the children
+			++pos;
+			children.push_back(parseTerm(term, pos, tree, areSymbolsKnown));
+
+			while ((pos < term.length()) &&
+				isspace(static_cast<unsigned char>(term[pos])))
+			{
+				++pos;
+			}
+		} while ((pos < term.length()) && (term[pos] == ','));
+
+		if ((pos == term.length()) || (term[pos] != ')'))
+		{	// in case the parenthesis is not closed
+			throw std::runtime_error(__func__ + std::string(": missing ')' at position ")
+				+ Convert::ToString(pos) + " of " + term);
+		}
+
+		++pos;
+	}
+
+	// an unknown symbol is stored as the universal symbol, it is never evaluated
+	InternalSymbolType internalSymbol = InternalSymbolType::GetUniversalSymbol();
+	if (symbolDict_->HasTranslation(symbol))
+	{	// in case the automaton knows the symbol
+		internalSymbol = symbolDict_->Translate(symbol);
+	}
+	else
+	{
+		areSymbolsKnown = false;
+	}
+
+	return tree.AddNode(internalSymbol, children);
+}
+
+
 SFTA::BUTreeAutomatonCover::StateType
 	SFTA::BUTreeAutomatonCover::translateInternalStateToState(
 	const InternalDualStateType& internalState) const
@@ -277,7 +586,7 @@ SFTA::BUTreeAutomatonCover::Type*
 			std::string(": cannot convert to proper type"));
 	}
 
-	return new Type(lhs->GetBDDSize(), result, lhs->GetSymbolDictionary());
+	return new Type(result, lhs->GetSymbolDictionary());
 }
 
 
@@ -296,6 +605,7 @@ SFTA::BUTreeAutomatonCover::Type*
 	typedef typename NDSymbolicBUTreeAutomaton::HierarchyRoot AbstractAutomaton;
 	std::auto_ptr<typename AbstractAutomaton::Operation> oper(
 		lhs->getAutomaton()->GetOperation());
+	oper->SetPruningProducts(isPruningProducts_);
 	AbstractAutomaton* abstractResult =
 		oper->Intersection((lhs->getAutomaton()).get(), (rhs->getAutomaton()).get());
 
@@ -307,7 +617,7 @@ SFTA::BUTreeAutomatonCover::Type*
 			std::string(": cannot convert to proper type"));
 	}
 
-	return new Type(lhs->GetBDDSize(), result, lhs->GetSymbolDictionary());
+	return new Type(result, lhs->GetSymbolDictionary());
 }
 
 
@@ -326,8 +636,25 @@ SFTA::BUTreeAutomatonCover::SimulationRelationType
 		InternalSimulationType;
 
 	std::auto_ptr<InternalOperationType> oper(aut->getAutomaton()->GetOperation());
-	std::auto_ptr<InternalSimulationType> simulation(
-		oper->ComputeSimulationPreorder((aut->getAutomaton()).get()));
+	std::auto_ptr<InternalSimulationType> simulation;
+
+	if (isSimulationByCounters_)
+	{	// in case the original algorithm is demanded
+		const NDSymbolicBUTreeAutomaton::Operation* ndOper =
+			static_cast<NDSymbolicBUTreeAutomaton::Operation*>(0);
+		if ((ndOper = dynamic_cast<const NDSymbolicBUTreeAutomaton::Operation*>(
+			oper.get())) == static_cast<NDSymbolicBUTreeAutomaton::Operation*>(0))
+		{	// in case the type is not OK
+			throw std::runtime_error(__func__ + std::string(": Invalid type"));
+		}
+
+		simulation.reset(ndOper->ComputeSimulationPreorderByCounters(
+			(aut->getAutomaton()).get()));
+	}
+	else
+	{
+		simulation.reset(oper->ComputeSimulationPreorder((aut->getAutomaton()).get()));
+	}
 
 
 	std::vector<InternalStateType> internalStates =
@@ -366,7 +693,7 @@ bool SFTA::BUTreeAutomatonCover::Operation::DoesLanguageInclusionHoldUpwards(
 
 	// check language inclusion
 	std::auto_ptr<InternalOperationType> buOper(lhs->getAutomaton()->GetOperation());
-	return buOper->CheckLanguageInclusion(lhs->getAutomaton().get(), rhs->getAutomaton().get(),
+	return checkLanguageInclusion(buOper.get(), lhs, lhs->getAutomaton().get(), rhs->getAutomaton().get(),
 		static_cast<InternalSimulationType*>(0), static_cast<InternalSimulationType*>(0));
 }
 
@@ -380,26 +707,15 @@ bool SFTA::BUTreeAutomatonCover::Operation::DoesLanguageInclusionHoldDownwards(
 
 	typedef typename NDSymbolicBUTreeAutomaton::HierarchyRoot AbstractAutomaton;
 	typedef typename AbstractAutomaton::Operation InternalOperationType;
-	typedef typename InternalOperationType::SimulationRelationType
-		InternalSimulationType;
 
-	// compute simulations
-	std::auto_ptr<InternalOperationType> oper(lhs->getAutomaton()->GetOperation());
-	std::auto_ptr<InternalSimulationType> lhsSim(
-		oper->ComputeSimulationPreorder((lhs->getAutomaton()).get()));
-	std::auto_ptr<InternalSimulationType> rhsSim(
-		oper->ComputeSimulationPreorder((rhs->getAutomaton()).get()));
-
-	// convert automata to top-down
-	std::auto_ptr<typename NDSymbolicBUTreeAutomaton::NDSymbolicTDTreeAutomatonType>
-		lhsTD(lhs->getAutomaton()->GetTopDownAutomaton());
-	std::auto_ptr<typename NDSymbolicBUTreeAutomaton::NDSymbolicTDTreeAutomatonType>
-		rhsTD(rhs->getAutomaton()->GetTopDownAutomaton());
+	// the top-down automata and simulations are cached by the covers
+	const NDSymbolicTDTreeAutomaton* lhsTD = lhs->getTopDownAutomaton();
+	const NDSymbolicTDTreeAutomaton* rhsTD = rhs->getTopDownAutomaton();
 
 	// check language inclusion
-	std::auto_ptr<InternalOperationType> tdOper(lhsTD.get()->GetOperation());
-	return tdOper->CheckLanguageInclusion(lhsTD.get(), rhsTD.get(), lhsSim.get(),
-		rhsSim.get());
+	std::auto_ptr<InternalOperationType> tdOper(lhsTD->GetOperation());
+	return checkLanguageInclusion(tdOper.get(), lhs, lhsTD, rhsTD,
+		lhs->getSimulation(), rhs->getSimulation());
 }
 
 
@@ -412,24 +728,20 @@ bool SFTA::BUTreeAutomatonCover::Operation::
 
 	typedef typename NDSymbolicBUTreeAutomaton::HierarchyRoot AbstractAutomaton;
 	typedef typename AbstractAutomaton::Operation InternalOperationType;
-	typedef typename InternalOperationType::SimulationRelationType
-		InternalSimulationType;
 
-	// compute simulations
+	// compute simulations (depends on both automata, so it is not cached)
 	std::auto_ptr<InternalOperationType> oper(lhs->getAutomaton()->GetOperation());
 	std::auto_ptr<AbstractAutomaton> united(oper->Union((lhs->getAutomaton().get()),
 		(rhs->getAutomaton()).get()));
 	std::auto_ptr<InternalSimulationType> sim(oper->ComputeSimulationPreorder(united.get()));
 
-	// convert automata to top-down
-	std::auto_ptr<typename NDSymbolicBUTreeAutomaton::NDSymbolicTDTreeAutomatonType>
-		lhsTD(lhs->getAutomaton()->GetTopDownAutomaton());
-	std::auto_ptr<typename NDSymbolicBUTreeAutomaton::NDSymbolicTDTreeAutomatonType>
-		rhsTD(rhs->getAutomaton()->GetTopDownAutomaton());
+	// the top-down automata are cached by the covers
+	const NDSymbolicTDTreeAutomaton* lhsTD = lhs->getTopDownAutomaton();
+	const NDSymbolicTDTreeAutomaton* rhsTD = rhs->getTopDownAutomaton();
 
 	// check language inclusion
-	std::auto_ptr<InternalOperationType> tdOper(lhsTD.get()->GetOperation());
-	return tdOper->CheckLanguageInclusion(lhsTD.get(), rhsTD.get(), sim.get(), sim.get());
+	std::auto_ptr<InternalOperationType> tdOper(lhsTD->GetOperation());
+	return checkLanguageInclusion(tdOper.get(), lhs, lhsTD, rhsTD, sim.get(), sim.get());
 }
 
 bool SFTA::BUTreeAutomatonCover::Operation::
@@ -443,26 +755,22 @@ bool SFTA::BUTreeAutomatonCover::Operation::
 
 	typedef typename NDSymbolicBUTreeAutomaton::HierarchyRoot AbstractAutomaton;
 	typedef typename AbstractAutomaton::Operation InternalOperationType;
-	typedef typename InternalOperationType::SimulationRelationType
-		InternalSimulationType;
 
-	// compute simulations
+	// compute simulations (depends on both automata, so it is not cached)
 	std::auto_ptr<InternalOperationType> oper(lhs->getAutomaton()->GetOperation());
 	std::auto_ptr<AbstractAutomaton> united(oper->Union((lhs->getAutomaton().get()),
 		(rhs->getAutomaton()).get()));
 	std::auto_ptr<InternalSimulationType> sim(oper->ComputeSimulationPreorder(united.get()));
 
-	// convert automata to top-down
-	std::auto_ptr<typename NDSymbolicBUTreeAutomaton::NDSymbolicTDTreeAutomatonType>
-		lhsTD(lhs->getAutomaton()->GetTopDownAutomaton());
-	std::auto_ptr<typename NDSymbolicBUTreeAutomaton::NDSymbolicTDTreeAutomatonType>
-		rhsTD(rhs->getAutomaton()->GetTopDownAutomaton());
+	// the top-down automata are cached by the covers
+	const NDSymbolicTDTreeAutomaton* lhsTD = lhs->getTopDownAutomaton();
+	const NDSymbolicTDTreeAutomaton* rhsTD = rhs->getTopDownAutomaton();
 
 	clock_gettime(CLOCK_THREAD_CPUTIME_ID, start);
 
 	// check language inclusion
-	std::auto_ptr<InternalOperationType> tdOper(lhsTD.get()->GetOperation());
-	return tdOper->CheckLanguageInclusion(lhsTD.get(), rhsTD.get(), sim.get(), sim.get());
+	std::auto_ptr<InternalOperationType> tdOper(lhsTD->GetOperation());
+	return checkLanguageInclusion(tdOper.get(), lhs, lhsTD, rhsTD, sim.get(), sim.get());
 }
 
 
@@ -477,28 +785,18 @@ bool SFTA::BUTreeAutomatonCover::Operation::
 
 	typedef typename NDSymbolicBUTreeAutomaton::HierarchyRoot AbstractAutomaton;
 	typedef typename AbstractAutomaton::Operation InternalOperationType;
-	typedef typename InternalOperationType::SimulationRelationType
-		InternalSimulationType;
-
-	// compute simulations
-	std::auto_ptr<InternalOperationType> oper(lhs->getAutomaton()->GetOperation());
-	std::auto_ptr<InternalSimulationType> lhsSim(
-		oper->ComputeSimulationPreorder((lhs->getAutomaton()).get()));
-	std::auto_ptr<InternalSimulationType> rhsSim(
-		oper->ComputeSimulationPreorder((rhs->getAutomaton()).get()));
 
-	// convert automata to top-down
-	std::auto_ptr<typename NDSymbolicBUTreeAutomaton::NDSymbolicTDTreeAutomatonType>
-		lhsTD(lhs->getAutomaton()->GetTopDownAutomaton());
-	std::auto_ptr<typename NDSymbolicBUTreeAutomaton::NDSymbolicTDTreeAutomatonType>
-		rhsTD(rhs->getAutomaton()->GetTopDownAutomaton());
+	// the top-down automata and simulations are cached by the covers
+	const InternalSimulationType* lhsSim = lhs->getSimulation();
+	const InternalSimulationType* rhsSim = rhs->getSimulation();
+	const NDSymbolicTDTreeAutomaton* lhsTD = lhs->getTopDownAutomaton();
+	const NDSymbolicTDTreeAutomaton* rhsTD = rhs->getTopDownAutomaton();
 
 	clock_gettime(CLOCK_THREAD_CPUTIME_ID, start);
 
 	// check language inclusion
-	std::auto_ptr<InternalOperationType> tdOper(lhsTD.get()->GetOperation());
-	return tdOper->CheckLanguageInclusion(lhsTD.get(), rhsTD.get(), lhsSim.get(),
-		rhsSim.get());
+	std::auto_ptr<InternalOperationType> tdOper(lhsTD->GetOperation());
+	return checkLanguageInclusion(tdOper.get(), lhs, lhsTD, rhsTD, lhsSim, rhsSim);
 }
 
 
@@ -512,26 +810,69 @@ bool SFTA::BUTreeAutomatonCover::Operation::
 
 	typedef typename NDSymbolicBUTreeAutomaton::HierarchyRoot AbstractAutomaton;
 	typedef typename AbstractAutomaton::Operation InternalOperationType;
-	typedef typename InternalOperationType::SimulationRelationType
-		InternalSimulationType;
 
-	// compute simulations
-	std::auto_ptr<InternalOperationType> oper(lhs->getAutomaton()->GetOperation());
-	std::auto_ptr<InternalSimulationType> lhsSim(
-		oper->GetIdentityRelation((lhs->getAutomaton()).get()));
-	std::auto_ptr<InternalSimulationType> rhsSim(
-		oper->GetIdentityRelation((rhs->getAutomaton()).get()));
-
-	// convert automata to top-down
-	std::auto_ptr<typename NDSymbolicBUTreeAutomaton::NDSymbolicTDTreeAutomatonType>
-		lhsTD(lhs->getAutomaton()->GetTopDownAutomaton());
-	std::auto_ptr<typename NDSymbolicBUTreeAutomaton::NDSymbolicTDTreeAutomatonType>
-		rhsTD(rhs->getAutomaton()->GetTopDownAutomaton());
+	// the top-down automata and identities are cached by the covers
+	const InternalSimulationType* lhsSim = lhs->getIdentityRelation();
+	const InternalSimulationType* rhsSim = rhs->getIdentityRelation();
+	const NDSymbolicTDTreeAutomaton* lhsTD = lhs->getTopDownAutomaton();
+	const NDSymbolicTDTreeAutomaton* rhsTD = rhs->getTopDownAutomaton();
 
 	clock_gettime(CLOCK_THREAD_CPUTIME_ID, start);
 
 	// check language inclusion
-	std::auto_ptr<InternalOperationType> tdOper(lhsTD.get()->GetOperation());
-	return tdOper->CheckLanguageInclusion(lhsTD.get(), rhsTD.get(), lhsSim.get(),
-		rhsSim.get());
+	std::auto_ptr<InternalOperationType> tdOper(lhsTD->GetOperation());
+	return checkLanguageInclusion(tdOper.get(), lhs, lhsTD, rhsTD, lhsSim, rhsSim);
+}
+
+
+double SFTA::BUTreeAutomatonCover::Operation::PrepareDownwardInclusionBatch(
+	const Type* rhs) const
+{
+	// Assertions
+	assert(rhs != static_cast<Type*>(0));
+
+	timespec start;
+	clock_gettime(CLOCK_THREAD_CPUTIME_ID, &start);
+
+	// fill the cache of the automaton
+	rhs->getSimulation();
+	rhs->getTopDownAutomaton();
+
+	timespec finish;
+	clock_gettime(CLOCK_THREAD_CPUTIME_ID, &finish);
+
+	return (finish.tv_sec - start.tv_sec) + 1e-9*(finish.tv_nsec - start.tv_nsec);
+}
+
+
+SFTA::BUTreeAutomatonCover::Operation::BatchQueryResult
+	SFTA::BUTreeAutomatonCover::Operation::CheckDownwardInclusionInBatch(
+	const Type* lhs, const Type* rhs) const
+{
+	// Assertions
+	assert(lhs != static_cast<Type*>(0));
+	assert(rhs != static_cast<Type*>(0));
+
+	if (lhs->automaton_->GetTTWrapper() != rhs->automaton_->GetTTWrapper())
+	{	// in case the automata do not share the MTBDD
+		throw std::runtime_error(__func__ +
+			std::string(": automata of a batch need to share the MTBDD wrapper"));
+	}
+
+	BatchQueryResult result;
+
+	timespec start;
+	clock_gettime(CLOCK_THREAD_CPUTIME_ID, &start);
+
+	result.holds = DoesLanguageInclusionHoldDownwards(lhs, rhs);
+
+	timespec finish;
+	clock_gettime(CLOCK_THREAD_CPUTIME_ID, &finish);
+
+	result.time = (finish.tv_sec - start.tv_sec) +
+		1e-9*(finish.tv_nsec - start.tv_nsec);
+	result.processedPairs = GetNumberOfProcessedPairs();
+	result.witness = GetWitness();
+
+	return result;
 }
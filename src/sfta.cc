@@ -16,6 +16,9 @@
 #include <fstream>
 #include <iostream>
 
+// POSIX headers
+#include <pthread.h>
+
 // Log4cpp headers
 #include <log4cpp/Category.hh>
 #include <log4cpp/OstreamAppender.hh>
@@ -28,6 +31,7 @@
 #include <sfta/td_tree_automaton_cover.hh>
 #include <sfta/timbuk_bu_ta_builder.hh>
 #include <sfta/timbuk_td_ta_builder.hh>
+#include <sfta/work_stealing_queue.hh>
 
 
 
@@ -45,6 +49,32 @@ typedef SFTA::TimbukTDTABuilder<TDTreeAutomaton> TimbukTDTABuilder;
 
 typedef SFTA::Private::Convert Convert;
 
+typedef BUTreeAutomaton::ManagerConfigurationType ManagerConfiguration;
+
+// configuration of the MTBDD manager given on the command line
+ManagerConfiguration managerConfig;
+
+// print statistics of the MTBDD manager after each operation?
+bool printStatistics = false;
+
+// the order of processing of pairs in checks of language inclusion
+SFTA::WorklistStrategy worklistStrategy = SFTA::WORKLIST_BFS;
+
+// print a tree witnessing that language inclusion does not hold?
+bool printCounterexample = false;
+
+// remove useless states from products of automata?
+bool pruneProducts = false;
+
+// reduce loaded automata using simulation?
+bool reduceBySimulation = false;
+
+// compute simulation by the original algorithm with counters?
+bool simulationByCounters = false;
+
+// the number of threads that process a batch of checks
+size_t numThreads = 1;
+
 enum OperationType
 {
 	OPERATION_INVALID = 0,
@@ -57,7 +87,10 @@ enum OperationType
 	OPERATION_DOWN_INCLUSION_SIMBOTH_NOTIME,
 	OPERATION_DOWN_INCLUSION_NOTIME,
 	OPERATION_DOWN_INCLUSION_NOSIM,
+	OPERATION_DOWN_INCLUSION_BATCH,
 	OPERATION_UP_INCLUSION,
+	OPERATION_EMPTINESS,
+	OPERATION_MEMBERSHIP,
 
 	OPERATION_HELP,
 
@@ -75,6 +108,9 @@ void printHelp(const std::string& programName)
 	std::cout << "   or: " << programName << " (-o|--down-inclusion-nosim)   <file1> <file2>\n";
 	std::cout << "   or: " << programName << " (-w|--down-inclusion-notime)  <file1> <file2>\n";
 	std::cout << "   or: " << programName << " (-p|--up-inclusion)           <file1> <file2>\n";
+	std::cout << "   or: " << programName << " (-B|--down-inclusion-batch)   <list> <file2>\n";
+	std::cout << "   or: " << programName << " (-e|--emptiness)              <file1>\n";
+	std::cout << "   or: " << programName << " (-r|--accepts)                <file1> <term>\n";
 	std::cout << "\n";
 	std::cout << "    -l, --load             load an automaton from <file1>.\n";
 	std::cout << "    -u, --union            create an automaton with language that is the union\n";
@@ -101,6 +137,57 @@ void printHelp(const std::string& programName)
 	std::cout << "    -p, --up-inclusion     check whether the language of the automaton from\n";
 	std::cout << "                           <file1> is a subset of the language of the automaton\n";
 	std::cout << "                           from <file2> (upward processing).\n";
+	std::cout << "    -B, --down-inclusion-batch  check for each file in <list> (one per line,\n";
+	std::cout << "                           empty lines and lines starting with '#' are\n";
+	std::cout << "                           skipped) whether the language of the automaton from\n";
+	std::cout << "                           the file is a subset of the language of the\n";
+	std::cout << "                           automaton from <file2> (downward processing).\n";
+	std::cout << "                           The automaton from <file2> is loaded and simulated\n";
+	std::cout << "                           only once, a line '<file> <result> <time>' is\n";
+	std::cout << "                           printed for each query.\n";
+	std::cout << "    -e, --emptiness        check whether the language of the automaton from\n";
+	std::cout << "                           <file1> is empty.\n";
+	std::cout << "    -r, --accepts          check whether the automaton from <file1> accepts\n";
+	std::cout << "                           the tree given by <term>, e.g. 'f(a, g(b))'.\n";
+	std::cout << "\n";
+	std::cout << "  MTBDD manager options:\n";
+	std::cout << "    -U, --unique-slots <n> initial number of slots of the unique table.\n";
+	std::cout << "    -C, --cache-slots <n>  initial number of slots of the computed table.\n";
+	std::cout << "    -X, --max-cache <n>    maximum number of slots of the computed table.\n";
+	std::cout << "    -M, --max-memory <n>   target maximum memory of the manager (in bytes).\n";
+	std::cout << "    -G, --gc-threshold <n> number of slots of the unique table up to which\n";
+	std::cout << "                           the table grows instead of collecting garbage.\n";
+	std::cout << "    -R, --reorder          reorder variables dynamically by sifting; when\n";
+	std::cout << "                           loading, variables are also reordered once after\n";
+	std::cout << "                           the automaton is loaded.\n";
+	std::cout << "    -S, --statistics       print the number of nodes and hit rates of caches\n";
+	std::cout << "                           after the operation (and the number of processed\n";
+	std::cout << "                           pairs after a check of language inclusion).\n";
+	std::cout << "\n";
+	std::cout << "  Simulation options:\n";
+	std::cout << "    -K, --counter-simulation  compute the simulation by the original algorithm\n";
+	std::cout << "                           with counters in MTBDDs instead of partition\n";
+	std::cout << "                           refinement (for comparison of the results).\n";
+	std::cout << "\n";
+	std::cout << "  Load options:\n";
+	std::cout << "    -Q, --reduce           merge simulation equivalent states of the automaton\n";
+	std::cout << "                           and remove simulated transitions (bottom-up only).\n";
+	std::cout << "\n";
+	std::cout << "  Batch options:\n";
+	std::cout << "    -j, --threads <n>      process the checks by <n> threads, each of them with\n";
+	std::cout << "                           its own MTBDD manager and copy of the automaton\n";
+	std::cout << "                           from <file2> (default 1).\n";
+	std::cout << "\n";
+	std::cout << "  Intersection options:\n";
+	std::cout << "    -P, --prune            remove useless states from the product.\n";
+	std::cout << "\n";
+	std::cout << "  Language inclusion options:\n";
+	std::cout << "    -W, --worklist <s>     the order in which pairs are processed, <s> is one\n";
+	std::cout << "                           of 'bfs' (default), 'dfs' and 'priority' (pairs\n";
+	std::cout << "                           with smaller sets of states first).\n";
+	std::cout << "    -c, --counterexample   print a tree that is accepted by the automaton from\n";
+	std::cout << "                           <file1> and not by the automaton from <file2>\n";
+	std::cout << "                           if the inclusion does not hold.\n";
 }
 
 void needsArguments(size_t value, size_t needsToBe)
@@ -127,6 +214,93 @@ void specifyOperation(OperationType& oper, OperationType value)
 }
 
 
+template <class Automaton>
+void printManagerStatistics(Automaton* ta)
+{
+	// Assertions
+	assert(ta != static_cast<Automaton*>(0));
+
+	if (printStatistics)
+	{	// in case statistics are demanded
+		typename Automaton::TTWrapperPtr wrapper = ta->GetTTWrapper();
+
+		std::cerr << "live nodes: " << wrapper->GetMTBDD()->GetNodeCount()
+			<< ", peak nodes: " << wrapper->GetMTBDD()->GetPeakNodeCount()
+			<< ", computed table hit rate: "
+			<< wrapper->GetMTBDD()->GetComputedTableHitRate()
+			<< ", leaf cache hits: " << wrapper->GetMTBDD()->GetCacheHits()
+			<< ", leaf cache misses: " << wrapper->GetMTBDD()->GetCacheMisses()
+			<< "\n";
+	}
+}
+
+
+SFTA::WorklistStrategy parseWorklistStrategy(const std::string& str)
+{
+	if (str == "bfs")
+	{
+		return SFTA::WORKLIST_BFS;
+	}
+	else if (str == "dfs")
+	{
+		return SFTA::WORKLIST_DFS;
+	}
+	else if (str == "priority")
+	{
+		return SFTA::WORKLIST_PRIORITY;
+	}
+
+	throw std::runtime_error("Invalid worklist strategy: " + str);
+}
+
+
+template <class Operation>
+void printInclusionStatistics(const Operation* op)
+{
+	// Assertions
+	assert(op != static_cast<Operation*>(0));
+
+	if (printStatistics)
+	{	// in case statistics are demanded
+		std::cerr << "processed pairs: " << op->GetNumberOfProcessedPairs() << "\n";
+	}
+}
+
+
+template <class Operation>
+void printWitness(const Operation* op, bool result)
+{
+	// Assertions
+	assert(op != static_cast<Operation*>(0));
+
+	if (printCounterexample && !result)
+	{	// in case the witness of non-inclusion is demanded
+		std::cout << op->GetWitness() << "\n";
+	}
+}
+
+
+template <class Automaton>
+void reorderVariables(Automaton* ta)
+{
+	// Assertions
+	assert(ta != static_cast<Automaton*>(0));
+
+	if (managerConfig.dynamicReordering)
+	{	// in case variables are to be reordered
+		typename Automaton::TTWrapperPtr wrapper = ta->GetTTWrapper();
+
+		if (printStatistics)
+		{	// in case statistics are demanded
+			std::cerr << "live nodes before reordering: "
+				<< wrapper->GetMTBDD()->GetNodeCount() << "\n";
+		}
+
+		wrapper->GetMTBDD()->ReorderVariables();
+	}
+}
+
+
 void performUnion(bool isTopDown, const std::string& lhsFile,
 	const std::string& rhsFile)
 {
@@ -145,7 +319,7 @@ void performUnion(bool isTopDown, const std::string& lhsFile,
 	if (!isTopDown)
 	{
 		std::auto_ptr<AbstractBUTABuilder> builder(new TimbukBUTABuilder());
-		BUTABuildingDirector director(builder.get());
+		BUTABuildingDirector director(builder.get(), managerConfig);
 
 		std::auto_ptr<BUTreeAutomaton> taLhs(director.Construct(ifsLhs));
 		std::auto_ptr<BUTreeAutomaton> taRhs(director.Construct(ifsRhs));
@@ -155,11 +329,12 @@ void performUnion(bool isTopDown, const std::string& lhsFile,
 		std::auto_ptr<BUTreeAutomaton> taUnion(op->Union(taLhs.get(), taRhs.get()));
 
 		std::cout << taUnion->ToString();
+		printManagerStatistics(taUnion.get());
 	}
 	else
 	{
 		std::auto_ptr<AbstractTDTABuilder> builder(new TimbukTDTABuilder());
-		TDTABuildingDirector director(builder.get());
+		TDTABuildingDirector director(builder.get(), managerConfig);
 
 		std::auto_ptr<TDTreeAutomaton> taLhs(director.Construct(ifsLhs));
 		std::auto_ptr<TDTreeAutomaton> taRhs(director.Construct(ifsRhs));
@@ -169,6 +344,7 @@ void performUnion(bool isTopDown, const std::string& lhsFile,
 		std::auto_ptr<TDTreeAutomaton> taUnion(op->Union(taLhs.get(), taRhs.get()));
 
 		std::cout << taUnion->ToString();
+		printManagerStatistics(taUnion.get());
 	}
 }
 
@@ -191,34 +367,42 @@ void performIntersection(bool isTopDown, const std::string& lhsFile,
 	if (!isTopDown)
 	{
 		std::auto_ptr<AbstractBUTABuilder> builder(new TimbukBUTABuilder());
-		BUTABuildingDirector director(builder.get());
+		BUTABuildingDirector director(builder.get(), managerConfig);
 
 		std::auto_ptr<BUTreeAutomaton> taLhs(director.Construct(ifsLhs));
 		std::auto_ptr<BUTreeAutomaton> taRhs(director.Construct(ifsRhs));
 
 		std::auto_ptr<BUTreeAutomaton::Operation> op(taLhs->GetOperation());
+		op->SetPruningProducts(pruneProducts);
 
+		timespec start;
+		clock_gettime(CLOCK_THREAD_CPUTIME_ID, &start);
 
-		//clock_t start = clock();
 		std::auto_ptr<BUTreeAutomaton> taUnion(op->Intersection(taLhs.get(), taRhs.get()));
-		//clock_t finish = clock();
-		//SFTA_LOGGER_INFO("Duration: " + Convert::ToString(static_cast<double>(finish - start) / CLOCKS_PER_SEC) + " s");
+
+		timespec tmp;
+		clock_gettime(CLOCK_THREAD_CPUTIME_ID, &tmp);
+		double t = (tmp.tv_sec - start.tv_sec) + 1e-9*(tmp.tv_nsec - start.tv_nsec);
 
 		std::cout << taUnion->ToString();
+		std::cerr << t << "\n";
+		printManagerStatistics(taUnion.get());
 	}
 	else
 	{
 		std::auto_ptr<AbstractTDTABuilder> builder(new TimbukTDTABuilder());
-		TDTABuildingDirector director(builder.get());
+		TDTABuildingDirector director(builder.get(), managerConfig);
 
 		std::auto_ptr<TDTreeAutomaton> taLhs(director.Construct(ifsLhs));
 		std::auto_ptr<TDTreeAutomaton> taRhs(director.Construct(ifsRhs));
 
 		std::auto_ptr<TDTreeAutomaton::Operation> op(taLhs->GetOperation());
+		op->SetPruningProducts(pruneProducts);
 
 		std::auto_ptr<TDTreeAutomaton> taUnion(op->Intersection(taLhs.get(), taRhs.get()));
 
 		std::cout << taUnion->ToString();
+		printManagerStatistics(taUnion.get());
 	}
 }
 
@@ -234,20 +418,42 @@ void performLoad(bool isTopDown, const std::string& file)
 	if (!isTopDown)
 	{
 		std::auto_ptr<AbstractBUTABuilder> builder(new TimbukBUTABuilder());
-		BUTABuildingDirector director(builder.get());
+		BUTABuildingDirector director(builder.get(), managerConfig);
 
 		std::auto_ptr<BUTreeAutomaton> ta(director.Construct(ifs));
 
+		if (reduceBySimulation)
+		{	// in case the automaton is to be reduced
+			BUTreeAutomaton::ReductionStatisticsType stats = ta->ReduceBySimulation();
+
+			if (printStatistics)
+			{	// in case statistics are demanded
+				std::cerr << "removed states: " << stats.removedStates
+					<< ", removed transitions: " << stats.removedTransitions
+					<< ", removed nodes: " << stats.removedNodes << "\n";
+			}
+		}
+
+		reorderVariables(ta.get());
+
 		std::cout << ta->ToString();
+		printManagerStatistics(ta.get());
 	}
 	else
 	{
+		if (reduceBySimulation)
+		{
+			throw std::runtime_error("Reduction of top-down automata is not supported.");
+		}
+
 		std::auto_ptr<AbstractTDTABuilder> builder(new TimbukTDTABuilder());
-		TDTABuildingDirector director(builder.get());
+		TDTABuildingDirector director(builder.get(), managerConfig);
 
 		std::auto_ptr<TDTreeAutomaton> ta(director.Construct(ifs));
+		reorderVariables(ta.get());
 
 		std::cout << ta->ToString();
+		printManagerStatistics(ta.get());
 	}
 }
 
@@ -263,11 +469,12 @@ void performComputationOfSimulation(bool isTopDown, const std::string& file)
 	if (!isTopDown)
 	{
 		std::auto_ptr<AbstractBUTABuilder> builder(new TimbukBUTABuilder());
-		BUTABuildingDirector director(builder.get());
+		BUTABuildingDirector director(builder.get(), managerConfig);
 
 		std::auto_ptr<BUTreeAutomaton> ta(director.Construct(ifs));
 
 		std::auto_ptr<BUTreeAutomaton::Operation> op(ta->GetOperation());
+		op->SetSimulationByCounters(simulationByCounters);
 
 		typedef BUTreeAutomaton::SimulationRelationType SimulationRelationType;
 
@@ -276,6 +483,7 @@ void performComputationOfSimulation(bool isTopDown, const std::string& file)
 		std::string resultString = Convert::ToString(sim);
 
 		std::cout << resultString << "\n";
+		printManagerStatistics(ta.get());
 	}
 	else
 	{
@@ -302,12 +510,13 @@ void performCheckingDownwardInclusion(bool isTopDown, const std::string& lhsFile
 	if (!isTopDown)
 	{
 		std::auto_ptr<AbstractBUTABuilder> builder(new TimbukBUTABuilder());
-		BUTABuildingDirector director(builder.get());
+		BUTABuildingDirector director(builder.get(), managerConfig);
 
 		std::auto_ptr<BUTreeAutomaton> taLhs(director.Construct(ifsLhs));
 		std::auto_ptr<BUTreeAutomaton> taRhs(director.Construct(ifsRhs));
 
 		std::auto_ptr<BUTreeAutomaton::Operation> op(taLhs->GetOperation());
+		op->SetWorklistStrategy(worklistStrategy);
 
 		bool result;
 
@@ -322,6 +531,9 @@ void performCheckingDownwardInclusion(bool isTopDown, const std::string& lhsFile
 
 		std::cout << (result? "1" : "0") << "\n";
 		std::cerr << t << "\n";
+		printWitness(op.get(), result);
+		printInclusionStatistics(op.get());
+		printManagerStatistics(taLhs.get());
 	}
 	else
 	{
@@ -348,12 +560,13 @@ void performCheckingDownwardInclusionSimBoth(bool isTopDown, const std::string&
 	if (!isTopDown)
 	{
 		std::auto_ptr<AbstractBUTABuilder> builder(new TimbukBUTABuilder());
-		BUTABuildingDirector director(builder.get());
+		BUTABuildingDirector director(builder.get(), managerConfig);
 
 		std::auto_ptr<BUTreeAutomaton> taLhs(director.Construct(ifsLhs));
 		std::auto_ptr<BUTreeAutomaton> taRhs(director.Construct(ifsRhs));
 
 		std::auto_ptr<BUTreeAutomaton::Operation> op(taLhs->GetOperation());
+		op->SetWorklistStrategy(worklistStrategy);
 
 		bool result;
 
@@ -368,6 +581,9 @@ void performCheckingDownwardInclusionSimBoth(bool isTopDown, const std::string&
 
 		std::cout << (result? "1" : "0") << "\n";
 		std::cerr << t << "\n";
+		printWitness(op.get(), result);
+		printInclusionStatistics(op.get());
+		printManagerStatistics(taLhs.get());
 	}
 	else
 	{
@@ -394,12 +610,13 @@ void performCheckingDownwardInclusionSimBothNoSimTime(bool isTopDown, const std:
 	if (!isTopDown)
 	{
 		std::auto_ptr<AbstractBUTABuilder> builder(new TimbukBUTABuilder());
-		BUTABuildingDirector director(builder.get());
+		BUTABuildingDirector director(builder.get(), managerConfig);
 
 		std::auto_ptr<BUTreeAutomaton> taLhs(director.Construct(ifsLhs));
 		std::auto_ptr<BUTreeAutomaton> taRhs(director.Construct(ifsRhs));
 
 		std::auto_ptr<BUTreeAutomaton::Operation> op(taLhs->GetOperation());
+		op->SetWorklistStrategy(worklistStrategy);
 
 		bool result;
 
@@ -413,6 +630,9 @@ void performCheckingDownwardInclusionSimBothNoSimTime(bool isTopDown, const std:
 
 		std::cout << (result? "1" : "0") << "\n";
 		std::cerr << t << "\n";
+		printWitness(op.get(), result);
+		printInclusionStatistics(op.get());
+		printManagerStatistics(taLhs.get());
 	}
 	else
 	{
@@ -439,12 +659,13 @@ void performCheckingDownwardInclusionWithoutTime(bool isTopDown, const std::stri
 	if (!isTopDown)
 	{
 		std::auto_ptr<AbstractBUTABuilder> builder(new TimbukBUTABuilder());
-		BUTABuildingDirector director(builder.get());
+		BUTABuildingDirector director(builder.get(), managerConfig);
 
 		std::auto_ptr<BUTreeAutomaton> taLhs(director.Construct(ifsLhs));
 		std::auto_ptr<BUTreeAutomaton> taRhs(director.Construct(ifsRhs));
 
 		std::auto_ptr<BUTreeAutomaton::Operation> op(taLhs->GetOperation());
+		op->SetWorklistStrategy(worklistStrategy);
 
 		bool result;
 
@@ -457,6 +678,9 @@ void performCheckingDownwardInclusionWithoutTime(bool isTopDown, const std::stri
 
 		std::cout << (result? "1" : "0") << "\n";
 		std::cerr << t << "\n";
+		printWitness(op.get(), result);
+		printInclusionStatistics(op.get());
+		printManagerStatistics(taLhs.get());
 	}
 	else
 	{
@@ -483,12 +707,13 @@ void performCheckingDownwardInclusionWithoutSim(bool isTopDown,
 	if (!isTopDown)
 	{
 		std::auto_ptr<AbstractBUTABuilder> builder(new TimbukBUTABuilder());
-		BUTABuildingDirector director(builder.get());
+		BUTABuildingDirector director(builder.get(), managerConfig);
 
 		std::auto_ptr<BUTreeAutomaton> taLhs(director.Construct(ifsLhs));
 		std::auto_ptr<BUTreeAutomaton> taRhs(director.Construct(ifsRhs));
 
 		std::auto_ptr<BUTreeAutomaton::Operation> op(taLhs->GetOperation());
+		op->SetWorklistStrategy(worklistStrategy);
 
 		bool result;
 
@@ -502,6 +727,9 @@ void performCheckingDownwardInclusionWithoutSim(bool isTopDown,
 
 		std::cout << (result? "1" : "0") << "\n";
 		std::cerr << t << "\n";
+		printWitness(op.get(), result);
+		printInclusionStatistics(op.get());
+		printManagerStatistics(taLhs.get());
 	}
 	else
 	{
@@ -510,6 +738,257 @@ void performCheckingDownwardInclusionWithoutSim(bool isTopDown,
 }
 
 
+/**
+ * @brief  Worker of a parallel batch
+ *
+ * The data a worker thread of a parallel batch of checks of language
+ * inclusion works with. MTBDD managers are not thread-safe, therefore every
+ * worker has its own director and thus its own MTBDD manager and symbol
+ * dictionary. The bigger automaton is copied to the manager of the worker
+ * before the worker is started.
+ */
+struct BatchWorker
+{
+	size_t number;
+	SFTA::Private::WorkStealingQueue* queue;
+	const std::vector<std::string>* lhsFiles;
+	std::vector<BUTreeAutomaton::Operation::BatchQueryResult>* results;
+	std::auto_ptr<AbstractBUTABuilder> builder;
+	std::auto_ptr<BUTABuildingDirector> director;
+	std::auto_ptr<BUTreeAutomaton> taRhs;
+	std::string error;
+
+	BatchWorker()
+		: number(0),
+			queue(static_cast<SFTA::Private::WorkStealingQueue*>(0)),
+			lhsFiles(static_cast<const std::vector<std::string>*>(0)),
+			results(static_cast<std::vector<BUTreeAutomaton::Operation::BatchQueryResult>*>(0)),
+			builder(new TimbukBUTABuilder()),
+			director(new BUTABuildingDirector(builder.get(), managerConfig)),
+			taRhs(),
+			error()
+	{ }
+
+private:
+
+	BatchWorker(const BatchWorker& worker);
+	BatchWorker& operator=(const BatchWorker& rhs);
+};
+
+
+void* performBatchWork(void* data)
+{
+	// Assertions
+	assert(data != static_cast<void*>(0));
+
+	BatchWorker& worker = *static_cast<BatchWorker*>(data);
+
+	try
+	{
+		// the copy of the bigger automaton in the manager of the worker
+		BUTreeAutomaton* taRhs = worker.taRhs.get();
+
+		std::auto_ptr<BUTreeAutomaton::Operation> op(taRhs->GetOperation());
+		op->SetWorklistStrategy(worklistStrategy);
+		op->PrepareDownwardInclusionBatch(taRhs);
+
+		SFTA::Private::WorkStealingQueue::TaskType query;
+		while (worker.queue->Pop(worker.number, query))
+		{	// process queries until there are none left
+			const std::string& lhsFile = (*worker.lhsFiles)[query];
+
+			std::ifstream ifsLhs(lhsFile.c_str());
+			if (ifsLhs.fail())
+			{
+				throw std::runtime_error("Could not open file " + lhsFile);
+			}
+
+			std::auto_ptr<BUTreeAutomaton> taLhs(worker.director->Construct(ifsLhs));
+
+			// every query has its own slot, so no locking is needed
+			(*worker.results)[query] =
+				op->CheckDownwardInclusionInBatch(taLhs.get(), taRhs);
+		}
+	}
+	catch (std::exception& ex)
+	{	// exceptions cannot leave the thread
+		worker.error = ex.what();
+	}
+
+	return static_cast<void*>(0);
+}
+
+
+void performCheckingDownwardInclusionBatchInParallel(std::istream& isList,
+	std::istream& isRhs)
+{
+	typedef BUTreeAutomaton::Operation::BatchQueryResult BatchQueryResult;
+
+	std::vector<std::string> lhsFiles;
+	std::string lhsFile;
+	while (std::getline(isList, lhsFile))
+	{	// read the names of the smaller automata
+		if (!lhsFile.empty() && (lhsFile[0] != '#'))
+		{	// in case the line is not empty or a comment
+			lhsFiles.push_back(lhsFile);
+		}
+	}
+
+	std::vector<BatchQueryResult> results(lhsFiles.size());
+
+	SFTA::Private::WorkStealingQueue queue(numThreads);
+	queue.PushRoundRobin(lhsFiles.size());
+
+	// directors are created and destroyed by this thread only
+	std::vector<BatchWorker*> workers;
+	{
+		// the bigger automaton is parsed only once and copied to the manager of
+		// every worker here, since copying needs the manager of the original
+		std::auto_ptr<AbstractBUTABuilder> builder(new TimbukBUTABuilder());
+		BUTABuildingDirector director(builder.get(), managerConfig);
+
+		std::auto_ptr<BUTreeAutomaton> taRhs(director.Construct(isRhs));
+
+		for (size_t i = 0; i < numThreads; ++i)
+		{	// prepare the workers
+			workers.push_back(new BatchWorker());
+			workers.back()->number = i;
+			workers.back()->queue = &queue;
+			workers.back()->lhsFiles = &lhsFiles;
+			workers.back()->results = &results;
+			workers.back()->taRhs.reset(workers.back()->director->Copy(*taRhs));
+		}
+	}
+
+	std::vector<pthread_t> threads(numThreads);
+	size_t numStarted = 0;
+	for ( ; numStarted < numThreads; ++numStarted)
+	{	// start the workers
+		if (pthread_create(&threads[numStarted], static_cast<pthread_attr_t*>(0),
+			performBatchWork, workers[numStarted]) != 0)
+		{	// in case the thread could not be created, the others do the work
+			break;
+		}
+	}
+
+	for (size_t i = 0; i < numStarted; ++i)
+	{	// wait for the workers
+		pthread_join(threads[i], static_cast<void**>(0));
+	}
+
+	std::string error;
+	if (numStarted == 0)
+	{
+		error = "Could not create any thread";
+	}
+
+	for (size_t i = 0; i < workers.size(); ++i)
+	{	// collect errors and release the workers
+		if (error.empty())
+		{
+			error = workers[i]->error;
+		}
+
+		delete workers[i];
+	}
+
+	if (!error.empty())
+	{	// in case some worker failed
+		throw std::runtime_error(error);
+	}
+
+	for (size_t i = 0; i < lhsFiles.size(); ++i)
+	{	// print the results in the order of the list
+		std::cout << lhsFiles[i] << " " << (results[i].holds? "1" : "0") << " "
+			<< results[i].time << "\n";
+
+		if (printCounterexample && !results[i].holds)
+		{	// in case the witness of non-inclusion is demanded
+			std::cout << results[i].witness << "\n";
+		}
+
+		if (printStatistics)
+		{	// in case statistics are demanded
+			std::cerr << "processed pairs: " << results[i].processedPairs << "\n";
+		}
+	}
+
+	if (printStatistics)
+	{	// in case statistics are demanded
+		std::cerr << "threads: " << numStarted << ", stolen queries: "
+			<< queue.GetNumberOfStolenTasks() << "\n";
+	}
+}
+
+
+void performCheckingDownwardInclusionBatch(bool isTopDown, const std::string& listFile,
+	const std::string& rhsFile)
+{
+	std::ifstream ifsList(listFile.c_str());
+	if (ifsList.fail())
+	{
+		throw std::runtime_error("Could not open file " + listFile);
+	}
+
+	std::ifstream ifsRhs(rhsFile.c_str());
+	if (ifsRhs.fail())
+	{
+		throw std::runtime_error("Could not open file " + rhsFile);
+	}
+
+	if (!isTopDown && (numThreads > 1))
+	{	// in case the checks are to be processed in parallel
+		performCheckingDownwardInclusionBatchInParallel(ifsList, ifsRhs);
+	}
+	else if (!isTopDown)
+	{
+		std::auto_ptr<AbstractBUTABuilder> builder(new TimbukBUTABuilder());
+		BUTABuildingDirector director(builder.get(), managerConfig);
+
+		// the bigger automaton is loaded and simulated only once
+		std::auto_ptr<BUTreeAutomaton> taRhs(director.Construct(ifsRhs));
+
+		std::auto_ptr<BUTreeAutomaton::Operation> op(taRhs->GetOperation());
+		op->SetWorklistStrategy(worklistStrategy);
+
+		std::cerr << "preparation: " << op->PrepareDownwardInclusionBatch(taRhs.get())
+			<< "\n";
+
+		std::string lhsFile;
+		while (std::getline(ifsList, lhsFile))
+		{	// stream the smaller automata through
+			if (lhsFile.empty() || (lhsFile[0] == '#'))
+			{	// in case the line is empty or a comment
+				continue;
+			}
+
+			std::ifstream ifsLhs(lhsFile.c_str());
+			if (ifsLhs.fail())
+			{
+				throw std::runtime_error("Could not open file " + lhsFile);
+			}
+
+			BUTreeAutomaton::Operation::BatchQueryResult result;
+			{	// the smaller automaton is released before the statistics are printed
+				std::auto_ptr<BUTreeAutomaton> taLhs(director.Construct(ifsLhs));
+
+				result = op->CheckDownwardInclusionInBatch(taLhs.get(), taRhs.get());
+			}
+
+			std::cout << lhsFile << " " << (result.holds? "1" : "0") << " "
+				<< result.time << "\n";
+			printWitness(op.get(), result.holds);
+			printInclusionStatistics(op.get());
+			printManagerStatistics(taRhs.get());
+		}
+	}
+	else
+	{
+		throw std::runtime_error("Batches of checks are supported only for bottom-up automata");
+	}
+}
+
+
 void performCheckingUpwardInclusion(bool isTopDown, const std::string& lhsFile,
 	const std::string& rhsFile)
 {
@@ -528,12 +1007,13 @@ void performCheckingUpwardInclusion(bool isTopDown, const std::string& lhsFile,
 	if (!isTopDown)
 	{
 		std::auto_ptr<AbstractBUTABuilder> builder(new TimbukBUTABuilder());
-		BUTABuildingDirector director(builder.get());
+		BUTABuildingDirector director(builder.get(), managerConfig);
 
 		std::auto_ptr<BUTreeAutomaton> taLhs(director.Construct(ifsLhs));
 		std::auto_ptr<BUTreeAutomaton> taRhs(director.Construct(ifsRhs));
 
 		std::auto_ptr<BUTreeAutomaton::Operation> op(taLhs->GetOperation());
+		op->SetWorklistStrategy(worklistStrategy);
 
 		bool result;
 
@@ -548,6 +1028,9 @@ void performCheckingUpwardInclusion(bool isTopDown, const std::string& lhsFile,
 
 		std::cout << (result? "1" : "0") << "\n";
 		std::cerr << t << "\n";
+		printWitness(op.get(), result);
+		printInclusionStatistics(op.get());
+		printManagerStatistics(taLhs.get());
 	}
 	else
 	{
@@ -556,6 +1039,77 @@ void performCheckingUpwardInclusion(bool isTopDown, const std::string& lhsFile,
 }
 
 
+void performCheckingEmptiness(bool isTopDown, const std::string& file)
+{
+	std::ifstream ifs(file.c_str());
+	if (ifs.fail())
+	{
+		throw std::runtime_error("Could not open file " + file);
+	}
+
+	if (!isTopDown)
+	{
+		std::auto_ptr<AbstractBUTABuilder> builder(new TimbukBUTABuilder());
+		BUTABuildingDirector director(builder.get(), managerConfig);
+
+		std::auto_ptr<BUTreeAutomaton> ta(director.Construct(ifs));
+
+		timespec start;
+		clock_gettime(CLOCK_THREAD_CPUTIME_ID, &start);
+
+		bool result = ta->IsEmpty();
+
+		timespec tmp;
+		clock_gettime(CLOCK_THREAD_CPUTIME_ID, &tmp);
+		double t = (tmp.tv_sec - start.tv_sec) + 1e-9*(tmp.tv_nsec - start.tv_nsec);
+
+		std::cout << (result? "1" : "0") << "\n";
+		std::cerr << t << "\n";
+		printManagerStatistics(ta.get());
+	}
+	else
+	{
+		throw std::runtime_error("Emptiness is checked only for bottom-up automata");
+	}
+}
+
+
+void performCheckingMembership(bool isTopDown, const std::string& file,
+	const std::string& term)
+{
+	std::ifstream ifs(file.c_str());
+	if (ifs.fail())
+	{
+		throw std::runtime_error("Could not open file " + file);
+	}
+
+	if (!isTopDown)
+	{
+		std::auto_ptr<AbstractBUTABuilder> builder(new TimbukBUTABuilder());
+		BUTABuildingDirector director(builder.get(), managerConfig);
+
+		std::auto_ptr<BUTreeAutomaton> ta(director.Construct(ifs));
+
+		timespec start;
+		clock_gettime(CLOCK_THREAD_CPUTIME_ID, &start);
+
+		bool result = ta->Accepts(term);
+
+		timespec tmp;
+		clock_gettime(CLOCK_THREAD_CPUTIME_ID, &tmp);
+		double t = (tmp.tv_sec - start.tv_sec) + 1e-9*(tmp.tv_nsec - start.tv_nsec);
+
+		std::cout << (result? "1" : "0") << "\n";
+		std::cerr << t << "\n";
+		printManagerStatistics(ta.get());
+	}
+	else
+	{
+		throw std::runtime_error("Membership is checked only for bottom-up automata");
+	}
+}
+
+
 void startLogger()
 {
 	// create the appender
@@ -580,7 +1134,7 @@ int main(int argc, char* argv[])
 	{
 		startLogger();
 
-		const char* getoptString = "uihlbtsnmawop";
+		const char* getoptString = "uihlbtsnmawoperBU:C:X:M:G:RSW:cPQKj:";
 		option longOptions[] = {
 			{"union",                      0, static_cast<int*>(0), 'u'},
 			{"intersection",               0, static_cast<int*>(0), 'i'},
@@ -595,6 +1149,22 @@ int main(int argc, char* argv[])
 			{"down-inclusion-notime",      0, static_cast<int*>(0), 'w'},
 			{"down-inclusion-nosim",       0, static_cast<int*>(0), 'o'},
 			{"up-inclusion",               0, static_cast<int*>(0), 'p'},
+			{"down-inclusion-batch",       0, static_cast<int*>(0), 'B'},
+			{"emptiness",                  0, static_cast<int*>(0), 'e'},
+			{"accepts",                    0, static_cast<int*>(0), 'r'},
+			{"unique-slots",               1, static_cast<int*>(0), 'U'},
+			{"cache-slots",                1, static_cast<int*>(0), 'C'},
+			{"max-cache",                  1, static_cast<int*>(0), 'X'},
+			{"max-memory",                 1, static_cast<int*>(0), 'M'},
+			{"gc-threshold",               1, static_cast<int*>(0), 'G'},
+			{"reorder",                    0, static_cast<int*>(0), 'R'},
+			{"statistics",                 0, static_cast<int*>(0), 'S'},
+			{"worklist",                   1, static_cast<int*>(0), 'W'},
+			{"counterexample",             0, static_cast<int*>(0), 'c'},
+			{"prune",                      0, static_cast<int*>(0), 'P'},
+			{"reduce",                     0, static_cast<int*>(0), 'Q'},
+			{"counter-simulation",         0, static_cast<int*>(0), 'K'},
+			{"threads",                    1, static_cast<int*>(0), 'j'},
 
 			{static_cast<const char*>(0),  0, static_cast<int*>(0), 0}
 		};
@@ -618,9 +1188,25 @@ int main(int argc, char* argv[])
 			  case 'a': specifyOperation(operation, OPERATION_DOWN_INCLUSION_SIMBOTH_NOTIME); break;
 				case 'w': specifyOperation(operation, OPERATION_DOWN_INCLUSION_NOTIME); break;
 				case 'p': specifyOperation(operation, OPERATION_UP_INCLUSION); break;
+				case 'B': specifyOperation(operation, OPERATION_DOWN_INCLUSION_BATCH); break;
 				case 'o': specifyOperation(operation, OPERATION_DOWN_INCLUSION_NOSIM); break;
+				case 'e': specifyOperation(operation, OPERATION_EMPTINESS); break;
+				case 'r': specifyOperation(operation, OPERATION_MEMBERSHIP); break;
 				case 'b': isTopDown = false; break;
 				case 't': isTopDown = true; break;
+				case 'U': managerConfig.uniqueSlots = Convert::FromString<unsigned>(optarg); break;
+				case 'C': managerConfig.cacheSlots = Convert::FromString<unsigned>(optarg); break;
+				case 'X': managerConfig.maxCacheSlots = Convert::FromString<unsigned>(optarg); break;
+				case 'M': managerConfig.maxMemory = Convert::FromString<unsigned long>(optarg); break;
+				case 'G': managerConfig.gcThreshold = Convert::FromString<unsigned>(optarg); break;
+				case 'R': managerConfig.dynamicReordering = true; break;
+				case 'S': printStatistics = true; break;
+				case 'W': worklistStrategy = parseWorklistStrategy(optarg); break;
+				case 'c': printCounterexample = true; break;
+				case 'P': pruneProducts = true; break;
+				case 'Q': reduceBySimulation = true; break;
+				case 'K': simulationByCounters = true; break;
+				case 'j': numThreads = Convert::FromString<size_t>(optarg); break;
 				default: throw std::runtime_error("Invalid command line parameter."); break;
 			}
 		}
@@ -630,6 +1216,11 @@ int main(int argc, char* argv[])
 			throw std::runtime_error("Invalid command line parameters.");
 		}
 
+		if (numThreads == 0)
+		{
+			throw std::runtime_error("The number of threads needs to be positive.");
+		}
+
 		typedef std::vector<std::string> StringVector;
 		StringVector inputs;
 
@@ -692,11 +1283,26 @@ int main(int argc, char* argv[])
 				performCheckingDownwardInclusionWithoutSim(isTopDown, inputs[0], inputs[1]);
 				break;
 
+			case OPERATION_DOWN_INCLUSION_BATCH:
+				needsArguments(inputs.size(), 2);
+				performCheckingDownwardInclusionBatch(isTopDown, inputs[0], inputs[1]);
+				break;
+
 			case OPERATION_UP_INCLUSION:
 				needsArguments(inputs.size(), 2);
 				performCheckingUpwardInclusion(isTopDown, inputs[0], inputs[1]);
 				break;
 
+			case OPERATION_EMPTINESS:
+				needsArguments(inputs.size(), 1);
+				performCheckingEmptiness(isTopDown, inputs[0]);
+				break;
+
+			case OPERATION_MEMBERSHIP:
+				needsArguments(inputs.size(), 2);
+				performCheckingMembership(isTopDown, inputs[0], inputs[1]);
+				break;
+
 			default: throw std::runtime_error("Invalid operation type.");break;
 		}
 	}
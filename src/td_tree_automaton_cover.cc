@@ -8,6 +8,10 @@
  *
  *****************************************************************************/
 
+// Standard library headers
+#include <algorithm>
+
+// SFTA headers
 #include <sfta/td_tree_automaton_cover.hh>
 
 
@@ -138,13 +142,9 @@ void SFTA::TDTreeAutomatonCover::AddTransition( const LeftHandSideType& lhs,
 	}
 
 	// translate the symbol
-	InternalSymbolType internalSymbol = symbolDict_->Translate(symbol);
-
-	// retrieve the original right-hand side
-	InternalRightHandSideType origRhs =
-		automaton_->GetTransition(internalLhs, internalSymbol);
+	InternalSymbolType internalSymbol = translateSymbol(symbol);
 
-	// add new states
+	InternalRightHandSideType newRhs;
 	for (typename RightHandSideType::const_iterator itRhs = rhs.begin();
 		itRhs != rhs.end(); ++itRhs)
 	{
@@ -165,17 +165,81 @@ void SFTA::TDTreeAutomatonCover::AddTransition( const LeftHandSideType& lhs,
 			newSuperState.push_back(itStates->second);
 		}
 
-		origRhs.insert(newSuperState);
+		newRhs.insert(newSuperState);
 	}
 
+	if (isBatchOpen_)
+	{	// in case we are in a batch, postpone the insertion
+		pendingTransitions_[internalLhs][symbol].insert(newRhs);
+		return;
+	}
+
+	// retrieve the original right-hand side
+	InternalRightHandSideType origRhs =
+		automaton_->GetTransition(internalLhs, internalSymbol);
+
+	// add new states
+	origRhs.insert(newRhs);
+
 	// update the right-hand side
 	automaton_->AddTransition(internalLhs, internalSymbol, origRhs);
 }
 
 
+void SFTA::TDTreeAutomatonCover::BeginTransitionBatch()
+{
+	if (isBatchOpen_)
+	{	// in case there is already a batch
+		throw std::logic_error(__func__ +
+			std::string(": a batch of transitions is already open"));
+	}
+
+	isBatchOpen_ = true;
+}
+
+
+void SFTA::TDTreeAutomatonCover::CommitTransitionBatch()
+{
+	if (!isBatchOpen_)
+	{	// in case there is no batch
+		throw std::logic_error(__func__ +
+			std::string(": no batch of transitions is open"));
+	}
+
+	typedef NDSymbolicTDTreeAutomaton::SymbolRightHandSideListType
+		SymbolRightHandSideList;
+
+	for (typename PendingTransitionMap::const_iterator itLhs =
+		pendingTransitions_.begin(); itLhs != pendingTransitions_.end(); ++itLhs)
+	{	// for each left-hand side
+		const SymbolToInternalRightHandSideMap& symbolMap = itLhs->second;
+
+		SymbolRightHandSideList transitions;
+		transitions.reserve(symbolMap.size());
+		for (typename SymbolToInternalRightHandSideMap::const_iterator itSymbol =
+			symbolMap.begin(); itSymbol != symbolMap.end(); ++itSymbol)
+		{	// for each symbol, merge with transitions from before the batch
+			// (the encoding of the symbol may have grown since it was added)
+			InternalSymbolType internalSymbol = symbolDict_->Translate(itSymbol->first);
+
+			InternalRightHandSideType rhs =
+				automaton_->GetTransition(itLhs->first, internalSymbol);
+			rhs.insert(itSymbol->second);
+
+			transitions.push_back(std::make_pair(internalSymbol, rhs));
+		}
+
+		automaton_->AddTransitions(itLhs->first, transitions);
+	}
+
+	pendingTransitions_.clear();
+	isBatchOpen_ = false;
+}
+
+
 void SFTA::TDTreeAutomatonCover::AddSymbol(const SymbolType& symbol)
 {
-	symbolDict_->Translate(symbol);
+	translateSymbol(symbol);
 }
 
 
@@ -193,6 +257,33 @@ void SFTA::TDTreeAutomatonCover::AddState(const StateType& state)
 }
 
 
+size_t SFTA::TDTreeAutomatonCover::RemoveUselessStates()
+{
+	size_t removedStates = automaton_->RemoveUselessStates();
+
+	if (removedStates > 0)
+	{	// in case some states were removed, forget their names
+		InternalStateVector states = automaton_->GetVectorOfStates();
+
+		typename StateToInternalStateMap::iterator itStates =
+			state2internalStateMap_.begin();
+		while (itStates != state2internalStateMap_.end())
+		{
+			if (std::binary_search(states.begin(), states.end(), itStates->second))
+			{	// in case the state is kept
+				++itStates;
+			}
+			else
+			{
+				state2internalStateMap_.erase(itStates++);
+			}
+		}
+	}
+
+	return removedStates;
+}
+
+
 std::string SFTA::TDTreeAutomatonCover::symbolsToString(
 	const std::vector<SymbolType>& vec)
 {
@@ -225,6 +316,21 @@ std::string SFTA::TDTreeAutomatonCover::initialStatesToString(
 }
 
 
+SFTA::TDTreeAutomatonCover::InternalSymbolType
+	SFTA::TDTreeAutomatonCover::translateSymbol(const SymbolType& symbol)
+{
+	size_t oldWidth = symbolDict_->GetEncodingWidth();
+
+	InternalSymbolType internalSymbol = symbolDict_->Translate(symbol);
+
+	for (size_t var = oldWidth; var < symbolDict_->GetEncodingWidth(); ++var)
+	{	// symbols encoded so far have value 0 of variables added to the encoding
+		automaton_->GetTTWrapper()->GetMTBDD()->RestrictVariableToZero(var);
+	}
+
+	return internalSymbol;
+}
+
 std::vector<SFTA::TDTreeAutomatonCover::SymbolType>
 	SFTA::TDTreeAutomatonCover::translateInternalSymbolToSymbols(
 	const InternalSymbolType& internalSymbol) const
@@ -233,7 +339,14 @@ std::vector<SFTA::TDTreeAutomatonCover::SymbolType>
 
 	typedef std::vector<InternalSymbolType> InternalSymbolVector;
 
-	InternalSymbolVector symbols = internalSymbol.GetVectorOfConcreteSymbols();
+	// the symbol need not contain variables the MTBDD does not depend on
+	InternalSymbolType paddedSymbol = internalSymbol;
+	if (paddedSymbol.VariablesCount() < symbolDict_->GetEncodingWidth())
+	{	// in case some variables are missing, they are don't care
+		paddedSymbol.AddVariablesUpTo(symbolDict_->GetEncodingWidth() - 1);
+	}
+
+	InternalSymbolVector symbols = paddedSymbol.GetVectorOfConcreteSymbols();
 	for (typename InternalSymbolVector::const_iterator itSym = symbols.begin();
 		itSym != symbols.end(); ++itSym)
 	{
@@ -273,7 +386,7 @@ SFTA::TDTreeAutomatonCover::Type*
 			std::string(": cannot convert to proper type"));
 	}
 
-	return new Type(lhs->GetBDDSize(), result, lhs->GetSymbolDictionary());
+	return new Type(result, lhs->GetSymbolDictionary());
 }
 
 
@@ -292,6 +405,7 @@ SFTA::TDTreeAutomatonCover::Type*
 	typedef typename NDSymbolicTDTreeAutomaton::HierarchyRoot AbstractAutomaton;
 	std::auto_ptr<typename AbstractAutomaton::Operation> oper(
 		lhs->getAutomaton()->GetOperation());
+	oper->SetPruningProducts(isPruningProducts_);
 	AbstractAutomaton* abstractResult =
 		oper->Intersection((lhs->getAutomaton()).get(), (rhs->getAutomaton()).get());
 
@@ -303,5 +417,5 @@ SFTA::TDTreeAutomatonCover::Type*
 			std::string(": cannot convert to proper type"));
 	}
 
-	return new Type(lhs->GetBDDSize(), result, lhs->GetSymbolDictionary());
+	return new Type(result, lhs->GetSymbolDictionary());
 }
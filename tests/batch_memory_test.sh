@@ -0,0 +1,80 @@
+#!/bin/sh
+
+# Checks that the smaller automata of a batch of checks of language inclusion
+# are released after their query, i.e. that the number of live MTBDD nodes
+# printed after each query does not grow when the same automaton is checked
+# over and over again. The first query may add new symbols to the manager, so
+# the counts are compared with the one after the second query.
+
+DIRPATH=$(dirname "$0")
+ECHO=/bin/echo
+
+# Programs
+SFTA=${DIRPATH}/../build/src/sfta
+
+# Automata pool directory
+AUT_DIR=${DIRPATH}/automata
+
+# The number of queries in each batch
+QUERIES=20
+
+# Create temporary files
+LIST_TMP=$(mktemp)
+STATS_TMP=$(mktemp)
+
+# Set the initial value of the result
+result=0
+
+# The green colour
+green='\e[1;32m'
+red='\e[1;31m'
+endcolor='\e[0m'
+
+${ECHO} "Checking that batches of checks of language inclusion do not leak MTBDD nodes"
+
+for aut_file in ${AUT_DIR}/* ; do
+
+  aut=$(basename ${aut_file})
+
+  ${ECHO} -n "Testing    batch of ${aut}:          "
+
+  # the automaton is checked against itself repeatedly
+  : > ${LIST_TMP}
+  i=0
+  while [ ${i} -lt ${QUERIES} ]; do
+    ${ECHO} ${aut_file} >> ${LIST_TMP}
+    i=$((i + 1))
+  done
+
+  failed=0
+  ${SFTA} --down-inclusion-batch --statistics ${LIST_TMP} ${aut_file} \
+    > /dev/null 2> ${STATS_TMP} || failed=1
+
+  counts=$(sed -n 's/^live nodes: \([0-9]*\),.*$/\1/p' ${STATS_TMP})
+
+  if [ $(${ECHO} "${counts}" | grep -c .) -ne ${QUERIES} ]; then
+    failed=1
+  fi
+
+  # the count after the second query is the reference
+  reference=$(${ECHO} "${counts}" | sed -n '2p')
+  for count in $(${ECHO} "${counts}" | sed '1d'); do
+    if [ "${count}" != "${reference}" ]; then
+      failed=1
+    fi
+  done
+
+  # In case the number of nodes changes
+  if [ ${failed} -ne 0 ]; then
+    result=1
+    ${ECHO} -e "${red}FAILED${endcolor}"
+  else
+    ${ECHO} -e "${green}PASSED${endcolor}"
+  fi
+done
+
+# Remove temporary files
+rm ${LIST_TMP}
+rm ${STATS_TMP}
+
+exit ${result}
@@ -0,0 +1,70 @@
+#!/bin/sh
+
+DIRPATH=$(dirname "$0")
+ECHO=/bin/echo
+
+# Programs
+SFTA=${DIRPATH}/../build/src/sfta
+
+# Automata pool directory
+AUT_DIR=${DIRPATH}/automata
+
+# Create temporary files
+LIST_TMP=$(mktemp)
+BATCH_TMP=$(mktemp)
+PARALLEL_TMP=$(mktemp)
+
+# Set the initial value of the result
+result=0
+
+# The green colour
+green='\e[1;32m'
+red='\e[1;31m'
+endcolor='\e[0m'
+
+${ECHO} "Comparing (parallel) batches of checks of language inclusion with single checks"
+
+# All automata of the pool are checked against each bigger automaton
+ls ${AUT_DIR}/* > ${LIST_TMP}
+
+for rhs_file in ${AUT_DIR}/* ; do
+
+  rhs=$(basename ${rhs_file})
+
+  ${ECHO} -n "Testing    batch against ${rhs}:          "
+
+  ${SFTA} --down-inclusion-batch ${LIST_TMP} ${rhs_file} > ${BATCH_TMP} 2> /dev/null || result=1
+  ${SFTA} --down-inclusion-batch --threads 4 ${LIST_TMP} ${rhs_file} > ${PARALLEL_TMP} 2> /dev/null || result=1
+
+  failed=0
+  for lhs_file in ${AUT_DIR}/* ; do
+
+    # the result of the single check
+    single=$(${SFTA} --down-inclusion ${lhs_file} ${rhs_file} 2> /dev/null)
+
+    # the result of the check in the batch
+    batch=$(grep "^${lhs_file} " ${BATCH_TMP} | cut -d' ' -f2)
+
+    # the result of the check in the parallel batch
+    parallel=$(grep "^${lhs_file} " ${PARALLEL_TMP} | cut -d' ' -f2)
+
+    if [ "${single}" != "${batch}" ] || [ "${single}" != "${parallel}" ]; then
+      failed=1
+    fi
+  done
+
+  # In case some results differ
+  if [ ${failed} -ne 0 ]; then
+    result=1
+    ${ECHO} -e "${red}FAILED${endcolor}"
+  else
+    ${ECHO} -e "${green}PASSED${endcolor}"
+  fi
+done
+
+# Remove temporary files
+rm ${LIST_TMP}
+rm ${BATCH_TMP}
+rm ${PARALLEL_TMP}
+
+exit ${result}
@@ -0,0 +1,58 @@
+#!/bin/sh
+
+# Measures the total time of the bottom-up product construction on pairs of
+# automata from union_test_automata.txt. If a path to a reference build of
+# sfta is given, its time is reported as well, so that two revisions can be
+# compared.
+
+DIRPATH=$(dirname "$0")
+ECHO=/bin/echo
+
+# Programs
+SFTA=${DIRPATH}/../build/src/sfta
+SFTA_REF=$1
+
+# Automata pool directory
+AUT_DIR=${DIRPATH}/automata
+
+# Create temporary files
+SFTA_TMP=$(mktemp)
+
+# Set the initial value of the result
+result=0
+
+# Sums the times of intersection for all pairs of automata
+# $1 ... the program
+total_time()
+{
+  total=0
+
+  while read inputline ; do
+
+    # Parse command-line arguments
+    aut1=$(echo ${inputline} | cut -d' ' -f 1)
+    aut2=$(echo ${inputline} | cut -d' ' -f 2)
+
+    $1 --intersection ${AUT_DIR}/${aut1} ${AUT_DIR}/${aut2} 2> ${SFTA_TMP} > /dev/null || return 1
+
+    # the time is on the first line of the standard error output
+    time=$(head -n 1 ${SFTA_TMP})
+    total=$(echo "${total} + ${time}" | bc -l)
+  done < ${DIRPATH}/union_test_automata.txt
+
+  ${ECHO} ${total}
+}
+
+time=$(total_time ${SFTA}) || result=1
+${ECHO} "--intersection: ${time} s"
+
+if [ -n "${SFTA_REF}" ]
+then
+  ref_time=$(total_time ${SFTA_REF}) || result=1
+  ${ECHO} "--intersection (reference): ${ref_time} s"
+fi
+
+# Remove temporary files
+rm ${SFTA_TMP}
+
+exit ${result}
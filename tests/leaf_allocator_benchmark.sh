@@ -0,0 +1,12 @@
+#!/bin/sh
+
+# Measures the time of creation and lookup of leaves in MapLeafAllocator for
+# growing numbers of leaves. The number of leaves in the largest round may be
+# given as the first argument.
+
+DIRPATH=$(dirname "$0")
+
+# Programs
+BENCHMARK=${DIRPATH}/../build/unit_tests/map_leaf_allocator_benchmark
+
+${BENCHMARK} $1
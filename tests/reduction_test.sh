@@ -0,0 +1,84 @@
+#!/bin/sh
+
+# Checks that reduction of automata by simulation preserves their language,
+# i.e. that each automaton of the pool and its reduced version are
+# equivalent according to the reference library. The check fails as well if
+# no automaton of the pool loses any states or transitions, because the
+# reduction would not be tested at all then.
+
+DIRPATH=$(dirname "$0")
+ECHO=/bin/echo
+
+# Programs
+SFTA=${DIRPATH}/../build/src/sfta
+REFLIB=${DIRPATH}/../reflib/main
+
+# Automata pool directory
+AUT_DIR=${DIRPATH}/automata
+
+# Create temporary files
+REDUCED_TMP=$(mktemp)
+STATS_TMP=$(mktemp)
+
+# Set the initial value of the result
+result=0
+
+# The number of reduced automata
+reduced=0
+
+# The green colour
+green='\e[1;32m'
+red='\e[1;31m'
+endcolor='\e[0m'
+
+${ECHO} "Checking that reduction by simulation preserves languages of automata"
+
+for aut_file in ${AUT_DIR}/* ; do
+
+  aut=$(basename ${aut_file})
+
+  ${ECHO} -n "Testing    reduction of ${aut}:          "
+
+  failed=0
+
+  # the reduced automaton
+  ${SFTA} --load --reduce --statistics ${aut_file} > ${REDUCED_TMP} 2> ${STATS_TMP} || failed=1
+
+  removed_states=$(sed -n 's/^removed states: \([0-9]*\),.*$/\1/p' ${STATS_TMP})
+  removed_trans=$(sed -n 's/^.*removed transitions: \([0-9]*\),.*$/\1/p' ${STATS_TMP})
+
+  if [ -z "${removed_states}" ] || [ -z "${removed_trans}" ]
+  then
+    failed=1
+  elif [ $((removed_states + removed_trans)) -gt 0 ]
+  then
+    reduced=$((reduced + 1))
+  fi
+
+  # Check if the automata are equivalent (have equivalent language)
+  equivalent=$(${REFLIB} eq ${REDUCED_TMP} ${aut_file})
+
+  # In case the run failed or the languages differ
+  if [ ${failed} -ne 0 ] || [ "${equivalent}" != "true" ]; then
+    result=1
+    ${ECHO} -e "${red}FAILED${endcolor}"
+  else
+    ${ECHO} -e "${green}PASSED${endcolor}"
+  fi
+done
+
+${ECHO} -n "Testing    that some automata were reduced:          "
+
+# In case no automaton lost states or transitions
+if [ ${reduced} -eq 0 ]; then
+  result=1
+  ${ECHO} -e "${red}FAILED${endcolor}"
+else
+  ${ECHO} -e "${green}PASSED${endcolor} (${reduced} reduced)"
+fi
+
+# Remove temporary files
+rm ${REDUCED_TMP}
+rm ${STATS_TMP}
+
+exit ${result}
@@ -0,0 +1,55 @@
+#!/bin/sh
+
+# Compares the number of MTBDD nodes of loaded automata before and after
+# reordering of variables by sifting.
+
+DIRPATH=$(dirname "$0")
+ECHO=/bin/echo
+
+# Programs
+SFTA=${DIRPATH}/../build/src/sfta
+
+# Automata pool directory
+AUT_DIR=${DIRPATH}/automata
+
+# Create temporary files
+SFTA_TMP=$(mktemp)
+
+# Set the initial value of the result
+result=0
+
+# Total numbers of nodes
+total_before=0
+total_after=0
+
+${ECHO} "Number of nodes before and after reordering of variables"
+
+for aut_file in ${AUT_DIR}/* ; do
+
+  aut=$(basename ${aut_file})
+
+  # SFTA computation
+  ${SFTA} --load --reorder --statistics ${aut_file} 2> ${SFTA_TMP} > /dev/null || result=1
+
+  before=$(sed -n 's/^live nodes before reordering: \([0-9]*\).*$/\1/p' ${SFTA_TMP})
+  after=$(sed -n 's/^live nodes: \([0-9]*\),.*$/\1/p' ${SFTA_TMP})
+
+  if [ -z "${before}" ] || [ -z "${after}" ]
+  then
+    result=1
+    ${ECHO} "${aut}: FAILED"
+    continue
+  fi
+
+  total_before=$((total_before + before))
+  total_after=$((total_after + after))
+
+  ${ECHO} "${aut}: ${before} -> ${after}"
+done
+
+${ECHO} "Total: ${total_before} -> ${total_after}"
+
+# Remove temporary files
+rm ${SFTA_TMP}
+
+exit ${result}
@@ -0,0 +1,53 @@
+#!/bin/sh
+
+DIRPATH=$(dirname "$0")
+ECHO=/bin/echo
+
+# Programs
+SFTA=${DIRPATH}/../build/src/sfta
+COMPARE=${DIRPATH}/compare_sim_output.sh
+
+# Automata pool directory
+AUT_DIR=${DIRPATH}/automata
+
+# Create temporary files
+REFINEMENT_TMP=$(mktemp)
+COUNTERS_TMP=$(mktemp)
+
+# Set the initial value of the result
+result=0
+
+# The green colour
+green='\e[1;32m'
+red='\e[1;31m'
+endcolor='\e[0m'
+
+${ECHO} "Comparing algorithms for simulation of automata"
+
+for aut_file in ${AUT_DIR}/* ; do
+
+  aut=$(basename ${aut_file})
+
+  ${ECHO} -n "Testing    simulation of ${aut}:          "
+
+  # partition refinement
+  ${SFTA} --simulation ${aut_file} > ${REFINEMENT_TMP} || result=1
+
+  # the original algorithm with counters
+  ${SFTA} --simulation --counter-simulation ${aut_file} > ${COUNTERS_TMP} || result=1
+
+  # In case the relations differ
+  if ! ${COMPARE} ${REFINEMENT_TMP} ${COUNTERS_TMP} > /dev/null
+  then
+    result=1
+    ${ECHO} -e "${red}FAILED${endcolor}"
+  else
+    ${ECHO} -e "${green}PASSED${endcolor}"
+  fi
+done
+
+# Remove temporary files
+rm ${REFINEMENT_TMP}
+rm ${COUNTERS_TMP}
+
+exit ${result}
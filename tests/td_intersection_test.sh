@@ -0,0 +1,65 @@
+#!/bin/sh
+
+# Compares the intersection of top-down automata with the intersection of
+# bottom-up automata. The top-down product is printed in the Timbuk format
+# with its initial states as final states, so the languages of both products
+# are compared by the reference library.
+
+DIRPATH=$(dirname "$0")
+ECHO=/bin/echo
+
+# Programs
+SFTA=${DIRPATH}/../build/src/sfta
+REFLIB=${DIRPATH}/../reflib/main
+
+# Automata pool directory
+AUT_DIR=${DIRPATH}/automata
+
+# Create temporary files
+BU_TMP=$(mktemp)
+TD_TMP=$(mktemp)
+
+# Set the initial value of the result
+result=0
+
+# The green colour
+green='\e[1;32m'
+red='\e[1;31m'
+endcolor='\e[0m'
+
+${ECHO} "Comparing intersection of top-down and bottom-up automata"
+
+while read inputline ; do
+
+  # Parse command-line arguments
+  aut1=$(echo ${inputline} | cut -d' ' -f 1)
+  aut2=$(echo ${inputline} | cut -d' ' -f 2)
+
+  ${ECHO} -n "Testing    ${aut1} intersection ${aut2}:          "
+
+  aut1_file=${AUT_DIR}/${aut1}
+  aut2_file=${AUT_DIR}/${aut2}
+
+  failed=0
+
+  # bottom-up and top-down products
+  ${SFTA} -b --intersection --prune ${aut1_file} ${aut2_file} > ${BU_TMP} 2> /dev/null || failed=1
+  ${SFTA} -t --intersection --prune ${aut1_file} ${aut2_file} > ${TD_TMP} 2> /dev/null || failed=1
+
+  # Check if the products are equivalent (have equivalent language)
+  equivalent=$(${REFLIB} eq ${BU_TMP} ${TD_TMP})
+
+  # In case the run failed or the languages differ
+  if [ ${failed} -ne 0 ] || [ "${equivalent}" != "true" ]; then
+    result=1
+    ${ECHO} -e "${red}FAILED${endcolor}"
+  else
+    ${ECHO} -e "${green}PASSED${endcolor}"
+  fi
+done < ${DIRPATH}/union_test_automata.txt
+
+# Remove temporary files
+rm ${BU_TMP}
+rm ${TD_TMP}
+
+exit ${result}
@@ -0,0 +1,91 @@
+#!/bin/sh
+
+# Checks that trees printed when language inclusion does not hold are
+# counterexamples, i.e. that they are accepted by the smaller automaton and
+# not by the bigger one. Both directions of inclusion are checked for every
+# pair of automata from union_test_automata.txt.
+
+DIRPATH=$(dirname "$0")
+ECHO=/bin/echo
+
+# Programs
+SFTA=${DIRPATH}/../build/src/sfta
+
+# Automata pool directory
+AUT_DIR=${DIRPATH}/automata
+
+# Create temporary files
+SFTA_TMP=$(mktemp)
+
+# Set the initial value of the result
+result=0
+
+# The green colour
+green='\e[1;32m'
+red='\e[1;31m'
+endcolor='\e[0m'
+
+# Checks the witness of non-inclusion of two automata
+# $1 ... the operation
+# $2 ... the smaller automaton
+# $3 ... the bigger automaton
+check_witness()
+{
+  holds=$(${SFTA} $1 $2 $3 2> /dev/null) || return 1
+
+  if [ "${holds}" = "1" ]
+  then
+    return 0
+  fi
+
+  [ "${holds}" = "0" ] || return 1
+
+  # the witness follows the result of the check
+  ${SFTA} $1 --counterexample $2 $3 > ${SFTA_TMP} 2> /dev/null || return 1
+  [ "$(sed -n '1p' ${SFTA_TMP})" = "0" ] || return 1
+  witness=$(sed -n '2p' ${SFTA_TMP})
+
+  # an empty witness of a failed check is an error as well
+  [ -n "${witness}" ] || return 1
+
+  in_smaller=$(${SFTA} --accepts $2 "${witness}" 2> /dev/null) || return 1
+  in_bigger=$(${SFTA} --accepts $3 "${witness}" 2> /dev/null) || return 1
+
+  [ "${in_smaller}" = "1" ] && [ "${in_bigger}" = "0" ]
+}
+
+${ECHO} "Checking witnesses of non-inclusion of automata"
+
+while read inputline ; do
+
+  # Parse command-line arguments
+  aut1=$(echo ${inputline} | cut -d' ' -f 1)
+  aut2=$(echo ${inputline} | cut -d' ' -f 2)
+
+  aut1_file=${AUT_DIR}/${aut1}
+  aut2_file=${AUT_DIR}/${aut2}
+
+  for op in --down-inclusion --up-inclusion ; do
+    for pair in "${aut1} ${aut2}" "${aut2} ${aut1}" ; do
+
+      smaller=$(echo ${pair} | cut -d' ' -f 1)
+      bigger=$(echo ${pair} | cut -d' ' -f 2)
+
+      ${ECHO} -n "Testing    ${smaller} ${op} ${bigger}:          "
+
+      # In case the witness is not a counterexample
+      if ! check_witness ${op} ${AUT_DIR}/${smaller} ${AUT_DIR}/${bigger}
+      then
+        result=1
+        ${ECHO} -e "${red}FAILED${endcolor}"
+      else
+        ${ECHO} -e "${green}PASSED${endcolor}"
+      fi
+    done
+  done
+done < ${DIRPATH}/union_test_automata.txt
+
+# Remove temporary files
+rm ${SFTA_TMP}
+
+exit ${result}
@@ -0,0 +1,265 @@
+/*****************************************************************************
+ *  Symbolic Finite Tree Automata Library
+ *
+ *  Copyright (c) 2010  Ondra Lengal <ondra@lengal.net>
+ *
+ *  Description:
+ *    Test suite for Antichain class. Answers of the antichain are compared
+ *    with a plain list of sets.
+ *
+ *****************************************************************************/
+
+// Standard library headers
+#include <algorithm>
+#include <list>
+#include <set>
+#include <vector>
+
+// SFTA headers
+#include <sfta/antichain.hh>
+#include <sfta/convert.hh>
+#include <sfta/ordered_vector.hh>
+
+// Boost headers
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE Antichain
+#include <boost/test/unit_test.hpp>
+#include <boost/random/mersenne_twister.hpp>
+
+// testing headers
+#include "log_fixture.hh"
+
+
+/******************************************************************************
+ *                                  Constants                                 *
+ ******************************************************************************/
+
+/**
+ * Number of states (more than the width of a signature)
+ */
+const unsigned NUM_STATES = 100;
+
+/**
+ * Number of states that the sets are indexed by
+ */
+const unsigned NUM_KEYS = 4;
+
+/**
+ * Number of random operations
+ */
+const unsigned NUM_OPERATIONS = 2000;
+
+
+/******************************************************************************
+ *                                  Fixtures                                  *
+ ******************************************************************************/
+
+/**
+ * @brief  Antichain test fixture
+ *
+ * Fixture for test of Antichain with unsigned states. The fixture keeps a
+ * list of sets for each key that serves as the reference.
+ */
+class AntichainFixture : public LogFixture
+{
+public:   // public types
+
+	typedef unsigned StateType;
+	typedef SFTA::OrderedVector<StateType> StateSetType;
+	typedef SFTA::Private::Antichain<StateType, StateSetType> AntichainType;
+	typedef std::list<StateSetType> ReferenceListType;
+
+	typedef SFTA::Private::Convert Convert;
+
+public:   // public data members
+
+	boost::mt19937 generator;
+
+	AntichainType antichain;
+
+	std::vector<ReferenceListType> reference;
+
+public:   // public methods
+
+	AntichainFixture()
+		: generator(), antichain(), reference(NUM_KEYS)
+	{ }
+
+	/**
+	 * @brief  Creates a random set of states
+	 *
+	 * States are picked from a range that depends on the size of the set, so
+	 * that there are subsets among the sets as well as states with equal
+	 * signatures.
+	 *
+	 * @returns  A random set of states
+	 */
+	StateSetType randomStateSet()
+	{
+		StateSetType states;
+		unsigned size = generator() % 6;
+		unsigned range = (generator() % 2 == 0)? 8 : NUM_STATES;
+		for (unsigned i = 0; i < size; ++i)
+		{	// pick random states
+			states.insert(generator() % range);
+		}
+
+		return states;
+	}
+
+	static bool isSubset(const StateSetType& lhs, const StateSetType& rhs)
+	{
+		return std::includes(rhs.begin(), rhs.end(), lhs.begin(), lhs.end());
+	}
+
+	bool referenceContainsSubsetOf(StateType key, const StateSetType& states) const
+	{
+		for (ReferenceListType::const_iterator itList = reference[key].begin();
+			itList != reference[key].end(); ++itList)
+		{
+			if (isSubset(*itList, states))
+			{
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	bool referenceContainsSupersetOf(StateType key, const StateSetType& states) const
+	{
+		for (ReferenceListType::const_iterator itList = reference[key].begin();
+			itList != reference[key].end(); ++itList)
+		{
+			if (isSubset(states, *itList))
+			{
+				return true;
+			}
+		}
+
+		return false;
+	}
+};
+
+
+/******************************************************************************
+ *                              Start of testing                              *
+ ******************************************************************************/
+
+BOOST_FIXTURE_TEST_SUITE(suite, AntichainFixture)
+
+BOOST_AUTO_TEST_CASE(queries)
+{
+	for (unsigned i = 0; i < NUM_OPERATIONS; ++i)
+	{	// perform random insertions and queries
+		StateType key = generator() % NUM_KEYS;
+		StateSetType states = randomStateSet();
+
+		BOOST_CHECK_MESSAGE(antichain.ContainsSubsetOf(key, states) ==
+			referenceContainsSubsetOf(key, states),
+			"Invalid subset query for " + Convert::ToString(states));
+		BOOST_CHECK_MESSAGE(antichain.ContainsSupersetOf(key, states) ==
+			referenceContainsSupersetOf(key, states),
+			"Invalid superset query for " + Convert::ToString(states));
+
+		antichain.Insert(key, i, states);
+		reference[key].push_back(states);
+	}
+}
+
+BOOST_AUTO_TEST_CASE(finding_supersets)
+{
+	for (unsigned i = 0; i < NUM_OPERATIONS; ++i)
+	{	// perform random insertions and searches
+		StateType key = generator() % NUM_KEYS;
+		StateSetType states = randomStateSet();
+
+		const AntichainType::Element* superset = antichain.FindSupersetOf(key, states);
+		BOOST_CHECK_MESSAGE((superset != static_cast<const AntichainType::Element*>(0))
+			== referenceContainsSupersetOf(key, states),
+			"Invalid superset search for " + Convert::ToString(states));
+
+		if (superset != static_cast<const AntichainType::Element*>(0))
+		{	// in case a superset was found
+			BOOST_CHECK_MESSAGE(isSubset(states, superset->states),
+				Convert::ToString(superset->states) + " is not a superset of "
+				+ Convert::ToString(states));
+			BOOST_CHECK_MESSAGE(superset->number < i,
+				"Invalid number " + Convert::ToString(superset->number));
+		}
+
+		antichain.Insert(key, i, states);
+		reference[key].push_back(states);
+	}
+}
+
+BOOST_AUTO_TEST_CASE(minimal_sets)
+{
+	std::set<size_t> liveNumbers;
+
+	for (unsigned i = 0; i < NUM_OPERATIONS; ++i)
+	{	// keep only minimal sets as the upward inclusion check does
+		StateType key = generator() % NUM_KEYS;
+		StateSetType states = randomStateSet();
+
+		if (!antichain.ContainsSubsetOf(key, states))
+		{	// in case there is no smaller set
+			std::vector<size_t> erased;
+			antichain.EraseSupersetsOf(key, states, erased);
+			for (std::vector<size_t>::const_iterator itErased = erased.begin();
+				itErased != erased.end(); ++itErased)
+			{	// the erased numbers need to be live
+				BOOST_CHECK_MESSAGE(liveNumbers.erase(*itErased) == 1,
+					"Erased number " + Convert::ToString(*itErased) + " is not live");
+			}
+
+			antichain.Insert(key, i, states);
+			liveNumbers.insert(i);
+		}
+	}
+
+	size_t numElements = 0;
+	for (StateType key = 0; key < NUM_KEYS; ++key)
+	{	// check that the sets of each key are incomparable
+		const AntichainType::ElementListType* elements = antichain.GetElements(key);
+		if (elements == static_cast<const AntichainType::ElementListType*>(0))
+		{
+			continue;
+		}
+
+		for (AntichainType::ElementListType::const_iterator itLhs = elements->begin();
+			itLhs != elements->end(); ++itLhs)
+		{
+			++numElements;
+			BOOST_CHECK_MESSAGE(liveNumbers.find(itLhs->number) != liveNumbers.end(),
+				"Number " + Convert::ToString(itLhs->number) + " is not live");
+
+			for (AntichainType::ElementListType::const_iterator itRhs = elements->begin();
+				itRhs != elements->end(); ++itRhs)
+			{
+				BOOST_CHECK_MESSAGE((itLhs == itRhs) || !isSubset(itLhs->states, itRhs->states),
+					Convert::ToString(itLhs->states) + " is a subset of "
+					+ Convert::ToString(itRhs->states));
+			}
+		}
+	}
+
+	BOOST_CHECK_MESSAGE(numElements == liveNumbers.size(),
+		"Invalid number of elements: " + Convert::ToString(numElements));
+}
+
+BOOST_AUTO_TEST_CASE(erasing)
+{
+	StateSetType states = randomStateSet();
+	antichain.Insert(0, 0, states);
+	antichain.Insert(0, 1, states);
+
+	BOOST_CHECK_MESSAGE(antichain.Erase(0, states), "Inserted set not found");
+	BOOST_CHECK_MESSAGE(antichain.ContainsSubsetOf(0, states),
+		"Both occurrences of the set were erased");
+	BOOST_CHECK_MESSAGE(antichain.Erase(0, states), "Second set not found");
+	BOOST_CHECK_MESSAGE(!antichain.Erase(0, states), "Erased set found");
+	BOOST_CHECK_MESSAGE(!antichain.Erase(1, states), "Set found for unknown state");
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,166 @@
+/*****************************************************************************
+ *  Symbolic Finite Tree Automata Library
+ *
+ *  Copyright (c) 2010  Ondra Lengal <ondra@lengal.net>
+ *
+ *  Description:
+ *    Test suite for membership queries of BUTreeAutomatonCover class.
+ *
+ *****************************************************************************/
+
+// Standard library headers
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+// SFTA headers
+#include <sfta/bu_tree_automaton_cover.hh>
+#include <sfta/ta_building_director.hh>
+#include <sfta/timbuk_bu_ta_builder.hh>
+
+// Boost headers
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE BUTreeAutomatonCover
+#include <boost/test/unit_test.hpp>
+
+// testing headers
+#include "log_fixture.hh"
+
+
+/******************************************************************************
+ *                                  Constants                                 *
+ ******************************************************************************/
+
+/**
+ * The automaton accepting trees @p c, @p f(a, b) and @p f(a, g(a))
+ */
+const char* const AUTOMATON =
+	"Ops a:0 b:0 c:0 g:1 f:2\n"
+	"\n"
+	"Automaton test\n"
+	"\n"
+	"States q0:0 q1:0 q2:0\n"
+	"\n"
+	"Final States q2\n"
+	"\n"
+	"Transitions\n"
+	"a -> q0\n"
+	"b -> q1\n"
+	"c -> q2\n"
+	"g(q0) -> q1\n"
+	"f(q0,q1) -> q2\n";
+
+
+/******************************************************************************
+ *                                  Fixtures                                  *
+ ******************************************************************************/
+
+/**
+ * @brief  BUTreeAutomatonCover test fixture
+ *
+ * Fixture for test of membership queries, it loads the automaton
+ * @c AUTOMATON.
+ */
+class BUTreeAutomatonCoverFixture : public LogFixture
+{
+public:   // public types
+
+	typedef SFTA::BUTreeAutomatonCover AutomatonType;
+	typedef SFTA::TimbukBUTABuilder<AutomatonType> BuilderType;
+	typedef SFTA::TABuildingDirector<AutomatonType> DirectorType;
+
+public:   // public data members
+
+	BuilderType builder;
+
+	DirectorType director;
+
+	std::auto_ptr<AutomatonType> aut;
+
+private:  // private methods
+
+	BUTreeAutomatonCoverFixture(const BUTreeAutomatonCoverFixture& fixture);
+	BUTreeAutomatonCoverFixture& operator=(const BUTreeAutomatonCoverFixture& rhs);
+
+public:   // public methods
+
+	BUTreeAutomatonCoverFixture()
+		: builder(),
+			director(&builder),
+			aut()
+	{
+		std::istringstream is(AUTOMATON);
+		aut.reset(director.Construct(is));
+	}
+};
+
+
+/******************************************************************************
+ *                              Start of testing                              *
+ ******************************************************************************/
+
+BOOST_FIXTURE_TEST_SUITE(suite, BUTreeAutomatonCoverFixture)
+
+BOOST_AUTO_TEST_CASE(constants)
+{
+	BOOST_CHECK_MESSAGE(aut->Accepts("c"), "Constant c is not accepted");
+	BOOST_CHECK_MESSAGE(aut->Accepts("  c "),
+		"Constant c surrounded by spaces is not accepted");
+	BOOST_CHECK_MESSAGE(!aut->Accepts("a"), "Constant a is accepted");
+	BOOST_CHECK_MESSAGE(!aut->Accepts("b"), "Constant b is accepted");
+}
+
+BOOST_AUTO_TEST_CASE(nested_terms)
+{
+	BOOST_CHECK_MESSAGE(aut->Accepts("f(a, b)"), "Term f(a, b) is not accepted");
+	BOOST_CHECK_MESSAGE(aut->Accepts("f(a,g(a))"),
+		"Term f(a,g(a)) is not accepted");
+	BOOST_CHECK_MESSAGE(aut->Accepts(" f ( a , g ( a ) ) "),
+		"Term f(a, g(a)) with spaces is not accepted");
+}
+
+BOOST_AUTO_TEST_CASE(rejected_terms)
+{
+	BOOST_CHECK_MESSAGE(!aut->Accepts("f(b, a)"), "Term f(b, a) is accepted");
+	BOOST_CHECK_MESSAGE(!aut->Accepts("g(a)"), "Term g(a) is accepted");
+	BOOST_CHECK_MESSAGE(!aut->Accepts("f(a, g(b))"), "Term f(a, g(b)) is accepted");
+	BOOST_CHECK_MESSAGE(!aut->Accepts("f(a, g(g(a)))"),
+		"Term f(a, g(g(a))) is accepted");
+}
+
+BOOST_AUTO_TEST_CASE(unknown_symbols)
+{
+	BOOST_CHECK_MESSAGE(!aut->Accepts("h"), "Unknown constant is accepted");
+	BOOST_CHECK_MESSAGE(!aut->Accepts("f(a, h(b))"),
+		"Term with unknown symbol is accepted");
+}
+
+BOOST_AUTO_TEST_CASE(malformed_terms)
+{
+	// empty terms and missing symbols
+	BOOST_CHECK_THROW(aut->Accepts(""), std::runtime_error);
+	BOOST_CHECK_THROW(aut->Accepts("  "), std::runtime_error);
+	BOOST_CHECK_THROW(aut->Accepts("f()"), std::runtime_error);
+	BOOST_CHECK_THROW(aut->Accepts("f(, b)"), std::runtime_error);
+	BOOST_CHECK_THROW(aut->Accepts("f(a, )"), std::runtime_error);
+
+	// unbalanced parentheses
+	BOOST_CHECK_THROW(aut->Accepts("f(a, b"), std::runtime_error);
+	BOOST_CHECK_THROW(aut->Accepts("f(a, g(a)"), std::runtime_error);
+	BOOST_CHECK_THROW(aut->Accepts("f(a, b))"), std::runtime_error);
+	BOOST_CHECK_THROW(aut->Accepts(")"), std::runtime_error);
+
+	// trailing garbage
+	BOOST_CHECK_THROW(aut->Accepts("f(a, b) c"), std::runtime_error);
+	BOOST_CHECK_THROW(aut->Accepts("c, c"), std::runtime_error);
+}
+
+BOOST_AUTO_TEST_CASE(non_ascii_characters)
+{
+	// characters with the highest bit set must not be taken for spaces
+	BOOST_CHECK_MESSAGE(!aut->Accepts("c\xa0"), "Term c\\xa0 is accepted");
+	BOOST_CHECK_THROW(aut->Accepts("f(a, b)\xa0"), std::runtime_error);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
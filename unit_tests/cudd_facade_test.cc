@@ -90,6 +90,13 @@ const char* const SQUARED_TEST_CASES_TABLE =
 	"|0|0|0|9|16|0|0|0|0|81|0|0|0|0|196|225|";
 
 
+/**
+ * Parities of values of standard test cases represented by a table
+ */
+const char* const PARITY_TEST_CASES_TABLE =
+	"|0|0|0|1|0|0|0|0|0|1|0|0|0|0|0|1|";
+
+
 /**
  * Formulae for standard test cases to be found not present in the MTBDD
  */
@@ -550,6 +557,35 @@ protected:
 	}
 
 
+	/**
+	 * @brief  Checks whether an MTBDD is reduced
+	 *
+	 * Checks that no internal node of given MTBDD has both children the
+	 * same.
+	 *
+	 * @param[in]  facade  CUDDFacade object
+	 * @param[in]  node    The root of the MTBDD
+	 *
+	 * @returns  True if the MTBDD is reduced, false otherwise
+	 */
+	static bool IsReduced(const CUDDFacade& facade, CUDDFacade::Node* node)
+	{
+		// Assertions
+		assert(node != static_cast<CUDDFacade::Node*>(0));
+
+		if (facade.IsNodeConstant(node))
+		{	// in case the node is a leaf
+			return true;
+		}
+
+		CUDDFacade::Node* thenChild = facade.GetThenChild(node);
+		CUDDFacade::Node* elseChild = facade.GetElseChild(node);
+
+		return (thenChild != elseChild) && IsReduced(facade, thenChild)
+			&& IsReduced(facade, elseChild);
+	}
+
+
 	/**
 	 * @brief  Creates MTBDD for test cases
 	 *
@@ -704,6 +740,45 @@ BOOST_AUTO_TEST_CASE(composed_values_storage_test)
 }
 
 
+BOOST_AUTO_TEST_CASE(configured_manager_test)
+{
+	CUDDFacade::ManagerConfiguration config;
+	config.uniqueSlots = 16;
+	config.cacheSlots = 64;
+	config.maxCacheSlots = 1024;
+	config.gcThreshold = 4096;
+
+	CUDDFacade facade(config);
+
+	// load test cases
+	ListOfTestCasesType testCases;
+	ListOfTestCasesType failedCases;
+	loadStandardTests(testCases, failedCases);
+
+	CUDDFacade::Node* node = CreateMTBDDForTestCases(facade, testCases);
+
+	for (ListOfTestCasesType::const_iterator itTests = testCases.begin();
+		itTests != testCases.end(); ++itTests)
+	{	// test that the test cases have been stored properly
+		FormulaParser::ParserResultUnsignedType prsRes =
+			FormulaParser::ParseExpressionUnsigned(*itTests);
+		BOOST_CHECK_MESSAGE(getValue(facade, node, prsRes.second)
+			== prsRes.first, *itTests + " != "
+			+ Convert::ToString(getValue(facade, node, prsRes.second)));
+	}
+
+	BOOST_CHECK_MESSAGE(facade.GetPeakNodeCount() >= facade.GetDagSize(node),
+		"Peak number of nodes " + Convert::ToString(facade.GetPeakNodeCount())
+		+ " is smaller than the size of the MTBDD");
+
+	double hitRate = facade.GetComputedTableHitRate();
+	BOOST_CHECK_MESSAGE((hitRate >= 0.0) && (hitRate <= 1.0),
+		"Invalid hit rate of the computed table: " + Convert::ToString(hitRate));
+
+	facade.RecursiveDeref(node);
+}
+
+
 BOOST_AUTO_TEST_CASE(large_diagram_test)
 {
 	CUDDFacade facade;
@@ -1005,6 +1080,87 @@ BOOST_AUTO_TEST_CASE(variable_trimming)
 }
 
 
+BOOST_AUTO_TEST_CASE(variable_reordering)
+{
+	CUDDFacade::ManagerConfiguration config;
+	config.dynamicReordering = true;
+
+	CUDDFacade facade(config);
+
+	// load test cases
+	ListOfTestCasesType testCases;
+	ListOfTestCasesType failedCases;
+	loadStandardTests(testCases, failedCases);
+
+	CUDDFacade::Node* node = CreateMTBDDForTestCases(facade, testCases);
+
+	std::string table = ValueTableToString(GetValueTable(facade, node));
+	unsigned long nodeCount = facade.GetNodeCount();
+
+	// reorder the variables
+	facade.ReorderVariables();
+
+	BOOST_CHECK_MESSAGE(facade.GetReorderingCount() > 0,
+		"Variables have not been reordered");
+	BOOST_CHECK_MESSAGE(facade.GetNodeCount() <= nodeCount,
+		"Reordering increased the number of nodes from "
+		+ Convert::ToString(nodeCount) + " to "
+		+ Convert::ToString(facade.GetNodeCount()));
+	BOOST_CHECK_MESSAGE(ValueTableToString(GetValueTable(facade, node)) == table,
+		"Stored table " + ValueTableToString(GetValueTable(facade, node))
+		+ " is not equal to the table before reordering " + table);
+
+	class OddVariablePredicateFunctor
+		: public CUDDFacade::AbstractNodePredicateFunctor
+	{
+	public:
+
+		virtual bool operator()(unsigned index)
+		{
+			return index % 2 == 1;
+		}
+	};
+
+	class AdditionApplyFunctor : public CUDDFacade::AbstractApplyFunctor
+	{
+	public:
+
+		virtual ValueType operator()(const ValueType& lhs, const ValueType& rhs)
+		{
+			return lhs + rhs;
+		}
+	};
+
+	OddVariablePredicateFunctor predicateOdd;
+	AdditionApplyFunctor merge;
+
+	// remove variables from the reordered MTBDD
+	CUDDFacade::Node* trimmedNode = facade.RemoveVariables(node,
+		&predicateOdd, &merge);
+
+	BOOST_CHECK_MESSAGE(ValueTableToString(GetValueTable(facade, trimmedNode))
+		== TRIMMED_TWO_VAR_STANDARD_TEST_CASES_TABLE,
+		"Stored table " + ValueTableToString(GetValueTable(facade, trimmedNode))
+		+ " is not equal to expected table "
+		+ std::string(TRIMMED_TWO_VAR_STANDARD_TEST_CASES_TABLE));
+
+	// change index of a variable in the reordered MTBDD (after trimming as a
+	// new variable is created)
+	CUDDFacade::Node* reindexedNode = facade.ChangeVariableIndex(node, 1, 4);
+	facade.Ref(reindexedNode);
+
+	BOOST_CHECK_MESSAGE(ValueTableToString(GetValueTable(facade, reindexedNode))
+		== REINDEXED_STANDARD_TEST_CASES_TABLE,
+		"Stored table " + ValueTableToString(GetValueTable(facade, reindexedNode))
+		+ " is not equal to expected table "
+		+ Convert::ToString(REINDEXED_STANDARD_TEST_CASES_TABLE));
+
+	facade.RecursiveDeref(trimmedNode);
+	facade.RecursiveDeref(reindexedNode);
+	facade.RecursiveDeref(node);
+}
+
+
 BOOST_AUTO_TEST_CASE(storing_and_loading)
 {
 	CUDDFacade facade;
@@ -1083,4 +1239,225 @@ BOOST_AUTO_TEST_CASE(monadic_apply)
 }
 
 
+BOOST_AUTO_TEST_CASE(cached_monadic_apply)
+{
+	CUDDFacade facade;
+
+	// load test cases
+	ListOfTestCasesType testCases;
+	ListOfTestCasesType failedCases;
+	loadStandardTests(testCases, failedCases);
+
+	CUDDFacade::Node* node = CreateMTBDDForTestCases(facade, testCases);
+
+	class CountingSquareMonadicApplyFunctor
+		: public CUDDFacade::AbstractMonadicApplyFunctor
+	{
+	public:
+
+		size_t calls;
+
+		CountingSquareMonadicApplyFunctor()
+			: calls(0)
+		{ }
+
+		virtual ValueType operator()(const ValueType& val)
+		{
+			++calls;
+			return val*val;
+		}
+	};
+
+	CountingSquareMonadicApplyFunctor squarer;
+	CUDDFacade::OperationIdType op = facade.CreateCachedOperation();
+
+	for (unsigned i = 0; i < 2; ++i)
+	{	// perform the operation twice, the second time from the cache
+		CUDDFacade::Node* squaredNode = facade.MonadicApply(node, &squarer, op);
+		facade.Ref(squaredNode);
+
+		BOOST_CHECK_MESSAGE(ValueTableToString(GetValueTable(facade, squaredNode))
+			== SQUARED_TEST_CASES_TABLE,
+			"Stored table " + ValueTableToString(GetValueTable(facade, squaredNode))
+			+ Convert::ToString(" is not equal to expected table ")
+			+ SQUARED_TEST_CASES_TABLE);
+
+		facade.RecursiveDeref(squaredNode);
+	}
+
+	size_t callsAfterFirst = squarer.calls;
+	BOOST_CHECK_MESSAGE(facade.GetLeafCacheMisses() == callsAfterFirst,
+		"Number of cache misses " + Convert::ToString(facade.GetLeafCacheMisses())
+		+ " does not match the number of calls " + Convert::ToString(callsAfterFirst));
+	BOOST_CHECK_MESSAGE(facade.GetLeafCacheHits() > 0, "No cache hits");
+
+	// after invalidation, the functor needs to be called again
+	facade.InvalidateCachedOperation(op);
+	CUDDFacade::Node* squaredNode = facade.MonadicApply(node, &squarer, op);
+	facade.Ref(squaredNode);
+	BOOST_CHECK_MESSAGE(squarer.calls == 2 * callsAfterFirst,
+		"Invalidated results were used: " + Convert::ToString(squarer.calls));
+
+	facade.EraseCachedOperation(op);
+	facade.RecursiveDeref(squaredNode);
+	facade.RecursiveDeref(node);
+}
+
+
+BOOST_AUTO_TEST_CASE(copying_to_other_manager)
+{
+	CUDDFacade facade;
+	CUDDFacade otherFacade;
+
+	// load test cases
+	ListOfTestCasesType testCases;
+	ListOfTestCasesType failedCases;
+	loadStandardTests(testCases, failedCases);
+
+	CUDDFacade::Node* node = CreateMTBDDForTestCases(facade, testCases);
+
+	class SquareMonadicApplyFunctor
+		: public CUDDFacade::AbstractMonadicApplyFunctor
+	{
+	public:
+
+		virtual ValueType operator()(const ValueType& val)
+		{
+			return val*val;
+		}
+	};
+
+	NodeArrayType roots;
+	roots.push_back(node);
+
+	// plain copy
+	NodeArrayType copies = facade.CopyTo(otherFacade, roots,
+		static_cast<CUDDFacade::AbstractMonadicApplyFunctor*>(0));
+	BOOST_REQUIRE(copies.size() == 1);
+
+	BOOST_CHECK_MESSAGE(
+		ValueTableToString(GetValueTable(otherFacade, copies[0]))
+		== ValueTableToString(GetValueTable(facade, node)), "Original table "
+		+ ValueTableToString(GetValueTable(facade, node))
+		+ " is not equal to copied table "
+		+ ValueTableToString(GetValueTable(otherFacade, copies[0])));
+
+	otherFacade.RecursiveDeref(copies[0]);
+
+	// copy with translated leaves
+	SquareMonadicApplyFunctor squarer;
+	copies = facade.CopyTo(otherFacade, roots, &squarer);
+	BOOST_REQUIRE(copies.size() == 1);
+
+	BOOST_CHECK_MESSAGE(ValueTableToString(GetValueTable(otherFacade, copies[0]))
+		== SQUARED_TEST_CASES_TABLE,
+		"Copied table " + ValueTableToString(GetValueTable(otherFacade, copies[0]))
+		+ Convert::ToString(" is not equal to expected table ")
+		+ SQUARED_TEST_CASES_TABLE);
+
+	otherFacade.RecursiveDeref(copies[0]);
+
+	BOOST_CHECK_THROW(facade.CopyTo(facade, roots,
+		static_cast<CUDDFacade::AbstractMonadicApplyFunctor*>(0)), std::runtime_error);
+
+	facade.RecursiveDeref(node);
+}
+
+
+BOOST_AUTO_TEST_CASE(copying_with_merged_leaves)
+{
+	CUDDFacade facade;
+	CUDDFacade otherFacade;
+
+	// load test cases
+	ListOfTestCasesType testCases;
+	ListOfTestCasesType failedCases;
+	loadStandardTests(testCases, failedCases);
+
+	CUDDFacade::Node* node = CreateMTBDDForTestCases(facade, testCases);
+
+	class ParityMonadicApplyFunctor
+		: public CUDDFacade::AbstractMonadicApplyFunctor
+	{
+	public:
+
+		virtual ValueType operator()(const ValueType& val)
+		{
+			return val % 2;
+		}
+	};
+
+	NodeArrayType roots;
+	roots.push_back(node);
+
+	// different leaves are translated to the same value
+	ParityMonadicApplyFunctor parity;
+	NodeArrayType copies = facade.CopyTo(otherFacade, roots, &parity);
+	BOOST_REQUIRE(copies.size() == 1);
+
+	BOOST_CHECK_MESSAGE(ValueTableToString(GetValueTable(otherFacade, copies[0]))
+		== PARITY_TEST_CASES_TABLE,
+		"Copied table " + ValueTableToString(GetValueTable(otherFacade, copies[0]))
+		+ Convert::ToString(" is not equal to expected table ")
+		+ PARITY_TEST_CASES_TABLE);
+	BOOST_CHECK_MESSAGE(IsReduced(otherFacade, copies[0]),
+		"Copied MTBDD contains a node with equal children");
+
+	otherFacade.RecursiveDeref(copies[0]);
+	facade.RecursiveDeref(node);
+}
+
+
+BOOST_AUTO_TEST_CASE(copying_with_failing_mapper)
+{
+	CUDDFacade facade;
+	CUDDFacade otherFacade;
+
+	// load test cases
+	ListOfTestCasesType testCases;
+	ListOfTestCasesType failedCases;
+	loadStandardTests(testCases, failedCases);
+
+	CUDDFacade::Node* node = CreateMTBDDForTestCases(facade, testCases);
+
+	class FailingMonadicApplyFunctor
+		: public CUDDFacade::AbstractMonadicApplyFunctor
+	{
+	public:
+
+		size_t calls;
+
+		FailingMonadicApplyFunctor()
+			: calls(0)
+		{ }
+
+		virtual ValueType operator()(const ValueType& val)
+		{
+			if (++calls > 2)
+			{	// in case some leaves have already been copied
+				throw std::runtime_error("Leaf cannot be translated");
+			}
+
+			return val;
+		}
+	};
+
+	NodeArrayType roots;
+	roots.push_back(node);
+
+	unsigned long nodeCount = otherFacade.GetNodeCount();
+
+	FailingMonadicApplyFunctor failing;
+	BOOST_CHECK_THROW(facade.CopyTo(otherFacade, roots, &failing),
+		std::runtime_error);
+
+	// the partial copy is released
+	BOOST_CHECK_MESSAGE(otherFacade.GetNodeCount() == nodeCount,
+		"Failed copy left " + Convert::ToString(otherFacade.GetNodeCount())
+		+ " live nodes instead of " + Convert::ToString(nodeCount));
+
+	facade.RecursiveDeref(node);
+}
+
+
 BOOST_AUTO_TEST_SUITE_END()
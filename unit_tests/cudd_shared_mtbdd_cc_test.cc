@@ -466,6 +466,51 @@ BOOST_AUTO_TEST_CASE(setters_and_getters_test)
 	delete bdd;
 }
 
+
+BOOST_AUTO_TEST_CASE(batch_setter_test)
+{
+	ASMTBDDCC* bdd = new CuddMTBDDCC();
+	bdd->SetBottomValue(0);
+
+	// load test cases
+	ListOfTestCasesType testCases;
+	ListOfTestCasesType failedCases;
+	loadStandardTests(testCases, failedCases);
+
+	// the reference MTBDD is created by sequential setting of values
+	RootType seqRoot = createMTBDDForTestCases(bdd, testCases);
+
+	ASMTBDDCC::AssignmentListType values;
+	for (unsigned i = 0; i < testCases.size(); ++i)
+	{	// collect all test cases into a single batch
+		FormulaParser::ParserResultUnsignedType prsRes =
+			FormulaParser::ParseExpressionUnsigned(testCases[i]);
+		values.push_back(std::make_pair(varListToAsgn(prsRes.second),
+			static_cast<LeafType>(prsRes.first)));
+	}
+
+	RootType batchRoot = bdd->CreateRoot();
+	bdd->SetValues(batchRoot, values);
+
+	ListOfTestCasesType allCases = testCases;
+	allCases.insert(allCases.end(), failedCases.begin(), failedCases.end());
+
+	for (unsigned i = 0; i < allCases.size(); ++i)
+	{	// test that both MTBDDs give the same values
+		FormulaParser::ParserResultUnsignedType prsRes =
+			FormulaParser::ParseExpressionUnsigned(allCases[i]);
+		MyVariableAssignment asgn = varListToAsgn(prsRes.second);
+
+		BOOST_CHECK_MESSAGE(compareTwoLeafContainers(
+			bdd->GetValue(batchRoot, asgn), bdd->GetValue(seqRoot, asgn)),
+			allCases[i] + ": " + leafContainerToString(bdd->GetValue(batchRoot, asgn))
+			+ " != " + leafContainerToString(bdd->GetValue(seqRoot, asgn)));
+	}
+
+	delete bdd;
+}
+
+
 BOOST_AUTO_TEST_CASE(large_diagram_test)
 {
 	ASMTBDDCC* bdd = new CuddMTBDDCC();
@@ -1013,6 +1058,158 @@ BOOST_AUTO_TEST_CASE(variable_trimming)
 	delete bdd;
 }
 
+
+BOOST_AUTO_TEST_CASE(variable_restriction)
+{
+	ASMTBDDCC* bdd = new CuddMTBDDCC();
+	bdd->SetBottomValue(0);
+
+	for (unsigned i = 0; i < NUM_VARIABLES; ++i)
+	{	// fill the table of variables
+		translateVarNameToIndex("x" + Convert::ToString(i));
+	}
+
+	// load test cases
+	ListOfTestCasesType testCases;
+	ListOfTestCasesType failedCases;
+	loadStandardTests(testCases, failedCases);
+
+	RootType root = createMTBDDForTestCases(bdd, testCases);
+
+	const ASMTBDDCC::VariableType restrictedVar = 3;
+	bdd->RestrictVariableToZero(restrictedVar);
+
+	for (unsigned i = 0; i < testCases.size(); ++i)
+	{	// test that only values with zero restricted variable are kept
+		FormulaParser::ParserResultUnsignedType prsRes =
+			FormulaParser::ParseExpressionUnsigned(testCases[i]);
+		LeafType leafValue = static_cast<LeafType>(prsRes.first);
+		MyVariableAssignment asgn = varListToAsgn(prsRes.second);
+
+		ASMTBDDCC::LeafContainer res;
+		if (asgn.GetIthVariableValue(restrictedVar) != MyVariableAssignment::ONE)
+		{	// in case the value is not restricted
+			res.push_back(&leafValue);
+		}
+
+		BOOST_CHECK_MESSAGE(
+			compareTwoLeafContainers(bdd->GetValue(root, asgn), res),
+			testCases[i] + ": " + leafContainerToString(bdd->GetValue(root, asgn)));
+	}
+
+	delete bdd;
+}
+
+BOOST_AUTO_TEST_CASE(root_release)
+{
+	ASMTBDDCC* bdd = new CuddMTBDDCC();
+	bdd->SetBottomValue(0);
+
+	// load test cases
+	ListOfTestCasesType testCases;
+	ListOfTestCasesType failedCases;
+	loadStandardTests(testCases, failedCases);
+
+	RootType root = createMTBDDForTestCases(bdd, testCases);
+
+	// apply functor that adds values in leaves
+	class PlusApplyFunctor
+		: public ASMTBDDCC::AbstractApplyFunctorType
+	{
+	public:
+
+		virtual LeafType operator()(const LeafType& lhs, const LeafType& rhs)
+		{
+			return lhs + rhs;
+		}
+	};
+
+	PlusApplyFunctor func;
+
+	unsigned long nodeCount = bdd->GetNodeCount();
+
+	std::vector<RootType> tmpRoots;
+	RootType sumRoot = root;
+	for (unsigned i = 0; i < NUM_VARIABLES; ++i)
+	{	// create a chain of intermediate results
+		sumRoot = bdd->Apply(sumRoot, root, &func);
+		tmpRoots.push_back(sumRoot);
+	}
+
+	RootType maxRoot = *std::max_element(tmpRoots.begin(), tmpRoots.end());
+
+	bdd->ReleaseRoots(tmpRoots);
+
+	BOOST_CHECK_MESSAGE(bdd->GetNodeCount() == nodeCount,
+		"Released roots keep " + Convert::ToString(bdd->GetNodeCount() - nodeCount)
+		+ " nodes alive");
+
+	RootType newRoot = bdd->CreateRoot();
+	BOOST_CHECK_MESSAGE(newRoot <= maxRoot,
+		"Released root is not reused: " + Convert::ToString(newRoot));
+
+	for (unsigned i = 0; i < testCases.size(); ++i)
+	{	// test that the original MTBDD is intact
+		FormulaParser::ParserResultUnsignedType prsRes =
+			FormulaParser::ParseExpressionUnsigned(testCases[i]);
+		LeafType leafValue = static_cast<LeafType>(prsRes.first);
+		MyVariableAssignment asgn = varListToAsgn(prsRes.second);
+
+		ASMTBDDCC::LeafContainer res;
+		res.push_back(&leafValue);
+
+		BOOST_CHECK_MESSAGE(
+			compareTwoLeafContainers(bdd->GetValue(root, asgn), res),
+			testCases[i] + ": " + leafContainerToString(bdd->GetValue(root, asgn)));
+	}
+
+	delete bdd;
+}
+
+BOOST_AUTO_TEST_CASE(shared_root_release)
+{
+	ASMTBDDCC* bdd = new CuddMTBDDCC();
+	bdd->SetBottomValue(0);
+
+	// load test cases
+	ListOfTestCasesType testCases;
+	ListOfTestCasesType failedCases;
+	loadStandardTests(testCases, failedCases);
+
+	RootType root = createMTBDDForTestCases(bdd, testCases);
+
+	// the root gets a second owner that erases it
+	bdd->ReferenceRoot(root);
+	bdd->EraseRoot(root);
+
+	RootType newRoot = bdd->CreateRoot();
+	BOOST_CHECK_MESSAGE(newRoot != root,
+		"Shared root is reused after one of its owners erased it");
+
+	for (unsigned i = 0; i < testCases.size(); ++i)
+	{	// test that the MTBDD is intact for the other owner
+		FormulaParser::ParserResultUnsignedType prsRes =
+			FormulaParser::ParseExpressionUnsigned(testCases[i]);
+		LeafType leafValue = static_cast<LeafType>(prsRes.first);
+		MyVariableAssignment asgn = varListToAsgn(prsRes.second);
+
+		ASMTBDDCC::LeafContainer res;
+		res.push_back(&leafValue);
+
+		BOOST_CHECK_MESSAGE(
+			compareTwoLeafContainers(bdd->GetValue(root, asgn), res),
+			testCases[i] + ": " + leafContainerToString(bdd->GetValue(root, asgn)));
+	}
+
+	// the last owner releases the root
+	bdd->EraseRoot(root);
+	bdd->EraseRoot(newRoot);
+	BOOST_CHECK_MESSAGE(bdd->CreateRoot() == newRoot,
+		"Released root is not reused");
+
+	delete bdd;
+}
+
 //BOOST_AUTO_TEST_CASE(serialization)
 //{
 //	ASMTBDDCC* bdd = new CuddMTBDDCC();
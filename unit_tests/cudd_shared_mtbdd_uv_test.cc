@@ -9,6 +9,9 @@
  *
  *****************************************************************************/
 
+// Standard library headers
+#include <algorithm>
+
 // SFTA headers
 #include <sfta/compact_variable_assignment.hh>
 #include <sfta/cudd_shared_mtbdd.hh>
@@ -1006,6 +1009,67 @@ BOOST_AUTO_TEST_CASE(variable_trimming)
 	delete bdd;
 }
 
+BOOST_AUTO_TEST_CASE(copying)
+{
+	CuddMTBDDUV source;
+	source.SetBottomValue(LeafType());
+	CuddMTBDDUV target;
+	target.SetBottomValue(LeafType());
+
+	// load test cases
+	ListOfTestCasesType testCases;
+	ListOfTestCasesType failedCases;
+	loadStandardTests(testCases, failedCases);
+
+	// leaves of the target get different handles than in the source
+	std::reverse(testCases.begin(), testCases.end());
+	RootType targetRoot = createMTBDDForTestCases(&target, testCases);
+	std::reverse(testCases.begin(), testCases.end());
+	RootType sourceRoot = createMTBDDForTestCases(&source, testCases);
+
+	std::vector<RootType> roots;
+	roots.push_back(sourceRoot);
+	roots.push_back(sourceRoot);
+	std::vector<RootType> copies = source.CopyTo(target, roots);
+
+	BOOST_REQUIRE(copies.size() == roots.size());
+	BOOST_CHECK_MESSAGE((copies[0] != copies[1]) && (copies[0] != targetRoot),
+		"Roots of copies are shared");
+
+	for (ListOfTestCasesType::const_iterator itTests = testCases.begin();
+		itTests != testCases.end(); ++itTests)
+	{	// test that the test cases have been copied properly
+		FormulaParser::ParserResultUnsignedVecType prsRes =
+			FormulaParser::ParseExpressionUnsignedVec(*itTests);
+		LeafType leafValue = static_cast<LeafType>(prsRes.first);
+		MyVariableAssignment asgn = varListToAsgn(prsRes.second);
+
+		ASMTBDDUV::LeafContainer res;
+		res.push_back(&leafValue);
+
+		for (size_t i = 0; i < copies.size(); ++i)
+		{
+			BOOST_CHECK_MESSAGE(
+				compareTwoLeafContainers(target.GetValue(copies[i], asgn), res), *itTests
+				+ " != " + leafContainerToString(target.GetValue(copies[i], asgn)));
+		}
+	}
+
+	for (ListOfTestCasesType::const_iterator itFailed = failedCases.begin();
+		itFailed != failedCases.end(); ++itFailed)
+	{	// the bottom needs to stay the bottom
+		FormulaParser::ParserResultUnsignedVecType prsFailedRes =
+			FormulaParser::ParseExpressionUnsignedVec(*itFailed);
+		MyVariableAssignment failedAsgn = varListToAsgn(prsFailedRes.second);
+
+		ASMTBDDUV::LeafContainer resFailed;
+
+		BOOST_CHECK_MESSAGE(
+			compareTwoLeafContainers(target.GetValue(copies[0], failedAsgn), resFailed),
+			*itFailed + " == " + leafContainerToString(target.GetValue(copies[0], failedAsgn)));
+	}
+}
+
 #if 0
 BOOST_AUTO_TEST_CASE(serialization)
 {
@@ -0,0 +1,217 @@
+/*****************************************************************************
+ *  Symbolic Finite Tree Automata Library
+ *
+ *  Copyright (c) 2010  Ondra Lengal <ondra@lengal.net>
+ *
+ *  Description:
+ *    Test suite for LTSSimulation class. The computed simulation is compared
+ *    with the greatest fixpoint computed by the definition.
+ *
+ *****************************************************************************/
+
+// Standard library headers
+#include <vector>
+
+// SFTA headers
+#include <sfta/convert.hh>
+#include <sfta/lts_simulation.hh>
+
+// Boost headers
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE LTSSimulation
+#include <boost/test/unit_test.hpp>
+#include <boost/random/mersenne_twister.hpp>
+
+// testing headers
+#include "log_fixture.hh"
+
+
+/******************************************************************************
+ *                                  Constants                                 *
+ ******************************************************************************/
+
+/**
+ * Number of random systems
+ */
+const unsigned NUM_SYSTEMS = 200;
+
+/**
+ * Maximum number of states of a system
+ */
+const unsigned MAX_STATES = 12;
+
+/**
+ * Number of labels
+ */
+const unsigned NUM_LABELS = 3;
+
+
+/******************************************************************************
+ *                                  Fixtures                                  *
+ ******************************************************************************/
+
+/**
+ * @brief  LTSSimulation test fixture
+ *
+ * Fixture for test of LTSSimulation that keeps the transitions of the
+ * system as a matrix and computes the simulation by the definition.
+ */
+class LTSSimulationFixture : public LogFixture
+{
+public:   // public types
+
+	typedef SFTA::Private::LTSSimulation LTSSimulationType;
+
+	typedef std::vector<std::vector<bool> > MatrixType;
+
+	typedef SFTA::Private::Convert Convert;
+
+public:   // public data members
+
+	boost::mt19937 generator;
+
+	size_t numStates;
+
+	std::vector<MatrixType> transitions;
+
+	std::vector<size_t> classes;
+
+public:   // public methods
+
+	LTSSimulationFixture()
+		: generator(), numStates(0), transitions(), classes()
+	{ }
+
+	void generateSystem(LTSSimulationType& lts)
+	{
+		for (size_t state = 0; state < numStates; ++state)
+		{	// pick the class of each state
+			classes[state] = generator() % 2;
+			lts.SetInitialClass(state, classes[state]);
+		}
+
+		size_t numTransitions = generator() % (2 * numStates * NUM_LABELS);
+		for (size_t i = 0; i < numTransitions; ++i)
+		{	// add random transitions
+			size_t source = generator() % numStates;
+			size_t label = generator() % NUM_LABELS;
+			size_t target = generator() % numStates;
+
+			transitions[label][source][target] = true;
+			lts.AddTransition(source, label, target);
+		}
+	}
+
+	MatrixType referenceSimulation() const
+	{
+		MatrixType sim(numStates, std::vector<bool>(numStates, false));
+		for (size_t p = 0; p < numStates; ++p)
+		{
+			for (size_t q = 0; q < numStates; ++q)
+			{
+				sim[p][q] = (classes[p] == classes[q]);
+			}
+		}
+
+		bool changed = true;
+		while (changed)
+		{	// remove pairs that violate the definition until the fixpoint
+			changed = false;
+			for (size_t p = 0; p < numStates; ++p)
+			{
+				for (size_t q = 0; q < numStates; ++q)
+				{
+					if (sim[p][q] && !isMatched(sim, p, q))
+					{
+						sim[p][q] = false;
+						changed = true;
+					}
+				}
+			}
+		}
+
+		return sim;
+	}
+
+	bool isMatched(const MatrixType& sim, size_t p, size_t q) const
+	{
+		for (size_t label = 0; label < NUM_LABELS; ++label)
+		{
+			for (size_t pSucc = 0; pSucc < numStates; ++pSucc)
+			{
+				if (!transitions[label][p][pSucc])
+				{
+					continue;
+				}
+
+				bool found = false;
+				for (size_t qSucc = 0; qSucc < numStates; ++qSucc)
+				{
+					if (transitions[label][q][qSucc] && sim[pSucc][qSucc])
+					{
+						found = true;
+						break;
+					}
+				}
+
+				if (!found)
+				{
+					return false;
+				}
+			}
+		}
+
+		return true;
+	}
+};
+
+
+/******************************************************************************
+ *                              Start of testing                              *
+ ******************************************************************************/
+
+BOOST_FIXTURE_TEST_SUITE(suite, LTSSimulationFixture)
+
+BOOST_AUTO_TEST_CASE(random_systems)
+{
+	for (unsigned i = 0; i < NUM_SYSTEMS; ++i)
+	{	// compare simulations of random systems
+		numStates = 1 + generator() % MAX_STATES;
+		transitions.assign(NUM_LABELS,
+			MatrixType(numStates, std::vector<bool>(numStates, false)));
+		classes.assign(numStates, 0);
+
+		LTSSimulationType lts(numStates);
+		generateSystem(lts);
+		lts.Compute();
+
+		MatrixType reference = referenceSimulation();
+		for (size_t p = 0; p < numStates; ++p)
+		{
+			for (size_t q = 0; q < numStates; ++q)
+			{
+				BOOST_CHECK_MESSAGE(lts.IsSimulated(p, q) == reference[p][q],
+					"Invalid simulation of " + Convert::ToString(p) + " by "
+					+ Convert::ToString(q) + " in system " + Convert::ToString(i));
+			}
+		}
+	}
+}
+
+BOOST_AUTO_TEST_CASE(chain)
+{
+	// 0 -a-> 1 -a-> 2, so 2 <= 1 <= 0 and not the other way round
+	LTSSimulationType lts(3);
+	lts.AddTransition(0, 0, 1);
+	lts.AddTransition(1, 0, 2);
+	lts.Compute();
+
+	BOOST_CHECK_MESSAGE(lts.IsSimulated(2, 1), "2 is not simulated by 1");
+	BOOST_CHECK_MESSAGE(lts.IsSimulated(1, 0), "1 is not simulated by 0");
+	BOOST_CHECK_MESSAGE(!lts.IsSimulated(0, 1), "0 is simulated by 1");
+	BOOST_CHECK_MESSAGE(!lts.IsSimulated(1, 2), "1 is simulated by 2");
+
+	BOOST_CHECK_THROW(lts.AddTransition(0, 0, 2), std::runtime_error);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,156 @@
+/*****************************************************************************
+ *  Symbolic Finite Tree Automata Library
+ *
+ *  Copyright (c) 2010  Ondra Lengal <ondra@lengal.net>
+ *
+ *  Description:
+ *    Benchmark of creation and lookup of leaves in MapLeafAllocator. The
+ *    number of leaves is doubled in every round so that the growth of the
+ *    time per leaf can be observed.
+ *
+ *****************************************************************************/
+
+// Standard library headers
+#include <cstdlib>
+#include <ctime>
+#include <iostream>
+#include <map>
+#include <vector>
+
+// SFTA headers
+#include <sfta/convert.hh>
+#include <sfta/map_leaf_allocator.hh>
+
+
+/******************************************************************************
+ *                                  Constants                                 *
+ ******************************************************************************/
+
+/**
+ * Number of leaves in the smallest round of the benchmark
+ */
+const unsigned BENCHMARK_MIN_LEAVES = 1 << 14;
+
+/**
+ * Default number of leaves in the largest round of the benchmark
+ */
+const unsigned BENCHMARK_MAX_LEAVES = 1 << 21;
+
+
+/******************************************************************************
+ *                                  Classes                                   *
+ ******************************************************************************/
+
+/**
+ * @brief  Dummy monadic Apply functor
+ *
+ * Monadic Apply functor used in place of the functor of the MTBDD package
+ * facade.
+ */
+class DummyMonadicApplyFunctor
+{
+public:
+
+	virtual unsigned operator()(const unsigned& val)
+	{
+		return val;
+	}
+
+	virtual ~DummyMonadicApplyFunctor()
+	{ }
+};
+
+
+/**
+ * @brief  Benchmarked allocator
+ *
+ * MapLeafAllocator with unsigned leaves that makes protected methods of the
+ * allocator accessible.
+ */
+class BenchmarkedAllocator
+	: public SFTA::Private::MapLeafAllocator
+		<
+			unsigned,
+			unsigned,
+			DummyMonadicApplyFunctor
+		>
+{
+public:   // public methods
+
+	inline HandleType CreateLeaf(const LeafType& leaf)
+	{
+		return createLeaf(leaf);
+	}
+
+	inline const LeafType& GetLeafOfHandle(const HandleType& handle) const
+	{
+		return getLeafOfHandle(handle);
+	}
+
+	inline void SetBottom(const LeafType& leaf)
+	{
+		setBottom(leaf);
+	}
+};
+
+
+/**
+ * @brief  Returns CPU time
+ *
+ * Returns the processor time used by the program in seconds.
+ *
+ * @returns  Used processor time
+ */
+double getCPUTime()
+{
+	return static_cast<double>(std::clock()) / CLOCKS_PER_SEC;
+}
+
+
+/******************************************************************************
+ *                                    Main                                    *
+ ******************************************************************************/
+
+int main(int argc, char* argv[])
+{
+	unsigned maxLeaves = BENCHMARK_MAX_LEAVES;
+	if (argc > 1)
+	{	// in case the size of the largest round is given
+		maxLeaves = static_cast<unsigned>(std::strtoul(argv[1], 0, 10));
+	}
+
+	BenchmarkedAllocator allocator;
+	allocator.SetBottom(0);
+
+	for (unsigned numLeaves = BENCHMARK_MIN_LEAVES;
+		numLeaves <= maxLeaves; numLeaves *= 2)
+	{	// for each round, double the number of leaves
+		unsigned base = numLeaves;
+
+		double startTime = getCPUTime();
+		for (unsigned i = 0; i < numLeaves; ++i)
+		{	// create new leaves
+			allocator.CreateLeaf(base + i);
+		}
+
+		double createTime = getCPUTime() - startTime;
+
+		startTime = getCPUTime();
+		for (unsigned i = 0; i < numLeaves; ++i)
+		{	// look up the leaves again
+			if (allocator.GetLeafOfHandle(allocator.CreateLeaf(base + i)) != base + i)
+			{	// in case the leaf is not found properly
+				std::cerr << "Invalid handle of leaf " << base + i << "\n";
+				return EXIT_FAILURE;
+			}
+		}
+
+		double lookupTime = getCPUTime() - startTime;
+
+		std::cout << numLeaves << " leaves: creation "
+			<< createTime * 1e9 / numLeaves << " ns/leaf, lookup "
+			<< lookupTime * 1e9 / numLeaves << " ns/leaf\n";
+	}
+
+	return EXIT_SUCCESS;
+}
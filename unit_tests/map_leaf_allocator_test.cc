@@ -0,0 +1,207 @@
+/*****************************************************************************
+ *  Symbolic Finite Tree Automata Library
+ *
+ *  Copyright (c) 2010  Ondra Lengal <ondra@lengal.net>
+ *
+ *  Description:
+ *    Test suite for MapLeafAllocator class.
+ *
+ *****************************************************************************/
+
+// Standard library headers
+#include <map>
+#include <stdexcept>
+
+// SFTA headers
+#include <sfta/convert.hh>
+#include <sfta/map_leaf_allocator.hh>
+
+// Boost headers
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE MapLeafAllocator
+#include <boost/test/unit_test.hpp>
+
+// testing headers
+#include "log_fixture.hh"
+
+
+/******************************************************************************
+ *                                  Constants                                 *
+ ******************************************************************************/
+
+/**
+ * Number of leaves in the smallest round of leaf creation
+ */
+const unsigned MIN_LEAVES = 1 << 8;
+
+/**
+ * Number of leaves in the largest round of leaf creation
+ */
+const unsigned MAX_LEAVES = 1 << 12;
+
+
+/******************************************************************************
+ *                                  Fixtures                                  *
+ ******************************************************************************/
+
+/**
+ * @brief  Dummy monadic Apply functor
+ *
+ * Monadic Apply functor used in place of the functor of the MTBDD package
+ * facade.
+ */
+class DummyMonadicApplyFunctor
+{
+public:
+
+	virtual unsigned operator()(const unsigned& val)
+	{
+		return val;
+	}
+
+	virtual ~DummyMonadicApplyFunctor()
+	{ }
+};
+
+
+/**
+ * @brief  MapLeafAllocator test fixture
+ *
+ * Fixture for test of MapLeafAllocator with unsigned leaves, it makes
+ * protected methods of the allocator accessible.
+ */
+class MapLeafAllocatorFixture
+	: public LogFixture,
+		public SFTA::Private::MapLeafAllocator
+		<
+			unsigned,
+			unsigned,
+			DummyMonadicApplyFunctor
+		>
+{
+public:   // public types
+
+	typedef SFTA::Private::MapLeafAllocator
+		<
+			unsigned,
+			unsigned,
+			DummyMonadicApplyFunctor
+		> AllocatorType;
+
+	typedef AllocatorType::LeafType LeafType;
+	typedef AllocatorType::HandleType HandleType;
+
+	typedef SFTA::Private::Convert Convert;
+
+public:   // public methods
+
+	MapLeafAllocatorFixture()
+		: AllocatorType()
+	{ }
+
+	inline HandleType CreateLeaf(const LeafType& leaf)
+	{
+		return createLeaf(leaf);
+	}
+
+	inline const LeafType& GetLeafOfHandle(const HandleType& handle) const
+	{
+		return getLeafOfHandle(handle);
+	}
+
+	inline void SetBottom(const LeafType& leaf)
+	{
+		setBottom(leaf);
+	}
+
+	inline size_t GetNumberOfHandles() const
+	{
+		return getAllHandles().size();
+	}
+
+	inline HandleType GetBottom() const
+	{
+		return BOTTOM;
+	}
+};
+
+
+/******************************************************************************
+ *                              Start of testing                              *
+ ******************************************************************************/
+
+BOOST_FIXTURE_TEST_SUITE(suite, MapLeafAllocatorFixture)
+
+BOOST_AUTO_TEST_CASE(handle_stability)
+{
+	SetBottom(0);
+
+	std::map<LeafType, HandleType> handles;
+	for (LeafType i = 1; i < 1000; ++i)
+	{	// create a number of leaves
+		handles[i] = CreateLeaf(i);
+	}
+
+	for (LeafType i = 999; i > 0; --i)
+	{	// check that repeated creation returns the original handle
+		BOOST_CHECK_MESSAGE(CreateLeaf(i) == handles[i], "Handle of leaf "
+			+ Convert::ToString(i) + " changed to " + Convert::ToString(CreateLeaf(i)));
+		BOOST_CHECK_MESSAGE(GetLeafOfHandle(handles[i]) == i, "Handle "
+			+ Convert::ToString(handles[i]) + " does not point to leaf "
+			+ Convert::ToString(i));
+	}
+
+	BOOST_CHECK_MESSAGE(CreateLeaf(0) == GetBottom(),
+		"Bottom leaf is not mapped to bottom handle");
+	BOOST_CHECK_MESSAGE(GetNumberOfHandles() == 1000,
+		"Duplicate leaves were created: " + Convert::ToString(GetNumberOfHandles()));
+}
+
+BOOST_AUTO_TEST_CASE(bottom_change)
+{
+	SetBottom(0);
+	HandleType handle = CreateLeaf(7);
+
+	// a leaf that already has a handle becomes the bottom
+	SetBottom(7);
+	BOOST_CHECK_MESSAGE(CreateLeaf(7) == GetBottom(),
+		"Leaf equal to bottom is not mapped to bottom handle");
+
+	// the former leaf of the bottom needs to get a new handle
+	HandleType zeroHandle = CreateLeaf(0);
+	BOOST_CHECK_MESSAGE(zeroHandle != GetBottom(),
+		"Former bottom leaf is still mapped to bottom handle");
+	BOOST_CHECK_MESSAGE(GetLeafOfHandle(zeroHandle) == 0,
+		"Former bottom leaf is not stored properly");
+
+	// when bottom changes again, the original handle of the leaf is used
+	SetBottom(0);
+	BOOST_CHECK_MESSAGE(CreateLeaf(7) == handle,
+		"Leaf is not mapped back to its original handle");
+}
+
+BOOST_AUTO_TEST_CASE(leaf_creation)
+{
+	for (unsigned numLeaves = MIN_LEAVES; numLeaves <= MAX_LEAVES; numLeaves *= 2)
+	{	// for each round, double the number of leaves
+		LeafType base = numLeaves;
+
+		for (unsigned i = 0; i < numLeaves; ++i)
+		{	// create new leaves
+			CreateLeaf(base + i);
+		}
+
+		for (unsigned i = 0; i < numLeaves; ++i)
+		{	// look up the leaves again
+			if (GetLeafOfHandle(CreateLeaf(base + i)) != base + i)
+			{	// in case the leaf is not found properly
+				BOOST_FAIL("Invalid handle of leaf " + Convert::ToString(base + i));
+			}
+		}
+	}
+
+	BOOST_CHECK_MESSAGE(GetNumberOfHandles() == 2 * MAX_LEAVES - MIN_LEAVES,
+		"Invalid number of leaves: " + Convert::ToString(GetNumberOfHandles()));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,200 @@
+/*****************************************************************************
+ *  Symbolic Finite Tree Automata Library
+ *
+ *  Copyright (c) 2010  Ondra Lengal <ondra@lengal.net>
+ *
+ *  Description:
+ *    Test suite for MemoryArena class.
+ *
+ *****************************************************************************/
+
+// Standard library headers
+#include <cstring>
+#include <vector>
+
+// SFTA headers
+#include <sfta/convert.hh>
+#include <sfta/memory_arena.hh>
+
+// Boost headers
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE MemoryArena
+#include <boost/test/unit_test.hpp>
+#include <boost/random/mersenne_twister.hpp>
+
+// testing headers
+#include "log_fixture.hh"
+
+
+/******************************************************************************
+ *                                  Constants                                 *
+ ******************************************************************************/
+
+/**
+ * Size of a block of the tested arena (small, so that many blocks are used)
+ */
+const size_t BLOCK_SIZE = 256;
+
+/**
+ * Number of random allocations
+ */
+const unsigned NUM_ALLOCATIONS = 2000;
+
+/**
+ * Maximum size of an allocation (bigger than a block)
+ */
+const unsigned MAX_SIZE = 600;
+
+
+/******************************************************************************
+ *                                  Fixtures                                  *
+ ******************************************************************************/
+
+/**
+ * @brief  MemoryArena test fixture
+ *
+ * Fixture for test of MemoryArena. Every allocated chunk is filled with
+ * a pattern that is checked later, so that overlapping chunks are detected.
+ */
+class MemoryArenaFixture : public LogFixture
+{
+public:   // public types
+
+	typedef SFTA::Private::MemoryArena ArenaType;
+
+	struct Chunk
+	{
+		unsigned char* memory;
+		size_t size;
+		unsigned char pattern;
+
+		Chunk(unsigned char* mem, size_t sz, unsigned char pat)
+			: memory(mem),
+				size(sz),
+				pattern(pat)
+		{ }
+	};
+
+	typedef std::vector<Chunk> ChunkVectorType;
+
+	typedef SFTA::Private::Convert Convert;
+
+public:   // public data members
+
+	boost::mt19937 generator;
+
+	ArenaType arena;
+
+public:   // public methods
+
+	MemoryArenaFixture()
+		: generator(), arena(BLOCK_SIZE)
+	{ }
+
+	/**
+	 * @brief  Allocates random chunks
+	 *
+	 * Allocates random chunks in the arena and fills them with random
+	 * patterns.
+	 *
+	 * @param[out]  chunks  The container the chunks are appended to
+	 * @param[in]   count   The number of allocated chunks
+	 */
+	void allocateChunks(ChunkVectorType& chunks, unsigned count)
+	{
+		for (unsigned i = 0; i < count; ++i)
+		{	// allocate chunks of random sizes
+			size_t size = generator() % MAX_SIZE;
+			unsigned char pattern = static_cast<unsigned char>(generator());
+			unsigned char* memory = static_cast<unsigned char*>(arena.Allocate(size));
+
+			BOOST_CHECK_MESSAGE(reinterpret_cast<size_t>(memory) % sizeof(double) == 0,
+				"Chunk of size " + Convert::ToString(size) + " is not aligned");
+
+			std::memset(memory, pattern, size);
+			chunks.push_back(Chunk(memory, size, pattern));
+		}
+	}
+
+	/**
+	 * @brief  Checks patterns of chunks
+	 *
+	 * @param[in]  chunks  The chunks
+	 */
+	static void checkChunks(const ChunkVectorType& chunks)
+	{
+		for (size_t i = 0; i < chunks.size(); ++i)
+		{	// check that no chunk was overwritten by another one
+			bool isIntact = true;
+			for (size_t j = 0; j < chunks[i].size; ++j)
+			{
+				if (chunks[i].memory[j] != chunks[i].pattern)
+				{
+					isIntact = false;
+				}
+			}
+
+			BOOST_CHECK_MESSAGE(isIntact,
+				"Chunk " + Convert::ToString(i) + " was overwritten");
+		}
+	}
+};
+
+
+/******************************************************************************
+ *                              Start of testing                              *
+ ******************************************************************************/
+
+BOOST_FIXTURE_TEST_SUITE(suite, MemoryArenaFixture)
+
+BOOST_AUTO_TEST_CASE(disjoint_chunks)
+{
+	ChunkVectorType chunks;
+	allocateChunks(chunks, NUM_ALLOCATIONS);
+
+	checkChunks(chunks);
+}
+
+BOOST_AUTO_TEST_CASE(nested_rewinding)
+{
+	ChunkVectorType outerChunks;
+	allocateChunks(outerChunks, NUM_ALLOCATIONS / 4);
+
+	ArenaType::MarkType mark = arena.GetMark();
+	for (unsigned i = 0; i < 10; ++i)
+	{	// perform nested computations that are released after each other
+		ChunkVectorType innerChunks;
+		allocateChunks(innerChunks, NUM_ALLOCATIONS / 10);
+		checkChunks(innerChunks);
+
+		arena.Rewind(mark);
+	}
+
+	// the memory after the mark is reused
+	void* memory = arena.Allocate(1);
+	arena.Rewind(mark);
+	BOOST_CHECK_MESSAGE(arena.Allocate(1) == memory,
+		"Memory after the mark is not reused");
+
+	allocateChunks(outerChunks, NUM_ALLOCATIONS / 4);
+	checkChunks(outerChunks);
+}
+
+BOOST_AUTO_TEST_CASE(creation)
+{
+	for (unsigned i = 0; i < NUM_ALLOCATIONS; ++i)
+	{	// created objects are value-initialized
+		size_t* value = arena.Create<size_t>();
+		BOOST_CHECK_MESSAGE(*value == 0,
+			"Created object is not initialized: " + Convert::ToString(*value));
+		*value = i + 1;
+	}
+
+	arena.Clear();
+
+	size_t* value = arena.Create<size_t>();
+	BOOST_CHECK_MESSAGE(*value == 0,
+		"Object created after clearing is not initialized");
+}
+
+BOOST_AUTO_TEST_SUITE_END()
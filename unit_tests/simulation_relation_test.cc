@@ -0,0 +1,266 @@
+/*****************************************************************************
+ *  Symbolic Finite Tree Automata Library
+ *
+ *  Copyright (c) 2010  Ondra Lengal <ondra@lengal.net>
+ *
+ *  Description:
+ *    Test suite for SimulationRelation class. The relation is compared with a
+ *    set of pairs of states.
+ *
+ *****************************************************************************/
+
+// Standard library headers
+#include <algorithm>
+#include <set>
+#include <stdexcept>
+#include <vector>
+
+// SFTA headers
+#include <sfta/convert.hh>
+#include <sfta/simulation_relation.hh>
+
+// Boost headers
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE SimulationRelation
+#include <boost/test/unit_test.hpp>
+#include <boost/random/mersenne_twister.hpp>
+
+// testing headers
+#include "log_fixture.hh"
+
+
+/******************************************************************************
+ *                                  Constants                                 *
+ ******************************************************************************/
+
+/**
+ * Number of states of the relation (spans several words of a row)
+ */
+const unsigned NUM_STATES = 200;
+
+/**
+ * Number of random pairs inserted into the relation
+ */
+const unsigned NUM_PAIRS = 4000;
+
+/**
+ * Number of random sets of states used for queries
+ */
+const unsigned NUM_QUERIES = 500;
+
+
+/******************************************************************************
+ *                                  Fixtures                                  *
+ ******************************************************************************/
+
+/**
+ * @brief  SimulationRelation test fixture
+ *
+ * Fixture for test of SimulationRelation with unsigned states. The fixture
+ * keeps a set of pairs of states that serves as the reference relation.
+ */
+class SimulationRelationFixture : public LogFixture
+{
+public:   // public types
+
+	typedef unsigned StateType;
+	typedef SFTA::SimulationRelation<StateType> RelationType;
+	typedef std::set<std::pair<StateType, StateType> > ReferenceType;
+	typedef std::vector<StateType> StateVectorType;
+
+	typedef SFTA::Private::Convert Convert;
+
+public:   // public data members
+
+	boost::mt19937 generator;
+
+	RelationType relation;
+
+	ReferenceType reference;
+
+public:   // public methods
+
+	SimulationRelationFixture()
+		: generator(), relation(), reference()
+	{ }
+
+	/**
+	 * @brief  Fills the relation with random pairs
+	 *
+	 * Inserts random pairs into both the relation and the reference and
+	 * erases some of them again.
+	 */
+	void fillRelation()
+	{
+		for (unsigned i = 0; i < NUM_PAIRS; ++i)
+		{	// insert random pairs
+			std::pair<StateType, StateType> value(generator() % NUM_STATES,
+				generator() % NUM_STATES);
+			relation.insert(value);
+			reference.insert(value);
+		}
+
+		for (unsigned i = 0; i < NUM_PAIRS / 4; ++i)
+		{	// erase random pairs
+			std::pair<StateType, StateType> value(generator() % NUM_STATES,
+				generator() % NUM_STATES);
+			relation.erase(value);
+			reference.erase(value);
+		}
+	}
+
+	/**
+	 * @brief  Creates a random sorted set of states
+	 *
+	 * @returns  A sorted vector of distinct states
+	 */
+	StateVectorType randomStateSet()
+	{
+		std::set<StateType> states;
+		unsigned size = generator() % 8;
+		for (unsigned i = 0; i < size; ++i)
+		{	// pick random states
+			states.insert(generator() % NUM_STATES);
+		}
+
+		return StateVectorType(states.begin(), states.end());
+	}
+
+	/**
+	 * @brief  Reference check that each state is simulated by a set
+	 *
+	 * @param[in]  smaller  Simulated states
+	 * @param[in]  bigger   Candidate simulators
+	 *
+	 * @returns  @p true iff each state of @p smaller is simulated by some
+	 *           state of @p bigger in the reference relation
+	 */
+	bool referenceForallExists(const StateVectorType& smaller,
+		const StateVectorType& bigger) const
+	{
+		for (StateVectorType::const_iterator itSmaller = smaller.begin();
+			itSmaller != smaller.end(); ++itSmaller)
+		{	// search for a simulator of each state
+			bool found = false;
+			for (StateVectorType::const_iterator itBigger = bigger.begin();
+				itBigger != bigger.end(); ++itBigger)
+			{
+				if (reference.find(std::make_pair(*itSmaller, *itBigger)) !=
+					reference.end())
+				{	// in case a simulator was found
+					found = true;
+					break;
+				}
+			}
+
+			if (!found)
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+};
+
+
+/******************************************************************************
+ *                              Start of testing                              *
+ ******************************************************************************/
+
+BOOST_FIXTURE_TEST_SUITE(suite, SimulationRelationFixture)
+
+BOOST_AUTO_TEST_CASE(membership)
+{
+	fillRelation();
+
+	for (StateType p = 0; p < NUM_STATES + 10; ++p)
+	{	// compare all pairs with the reference, including unknown states
+		StateVectorType simulators;
+		for (StateType q = 0; q < NUM_STATES + 10; ++q)
+		{
+			bool expected = reference.find(std::make_pair(p, q)) != reference.end();
+			if (expected)
+			{	// in case q simulates p
+				simulators.push_back(q);
+			}
+
+			BOOST_CHECK_MESSAGE(relation.is_in(std::make_pair(p, q)) == expected,
+				"Invalid membership of " + Convert::ToString(std::make_pair(p, q)));
+		}
+
+		BOOST_CHECK_MESSAGE(relation.GetSimulators(p) == simulators,
+			"Invalid simulators of " + Convert::ToString(p) + ": "
+			+ Convert::ToString(relation.GetSimulators(p)) + " instead of "
+			+ Convert::ToString(simulators));
+	}
+}
+
+BOOST_AUTO_TEST_CASE(set_queries)
+{
+	fillRelation();
+
+	for (unsigned i = 0; i < NUM_QUERIES; ++i)
+	{	// compare queries on random sets with the reference
+		StateVectorType smaller = randomStateSet();
+		StateVectorType bigger = randomStateSet();
+
+		bool expected = referenceForallExists(smaller, bigger);
+		bool result = relation.IsEachSimulatedByAny(smaller,
+			relation.CreateBitSet(bigger));
+
+		BOOST_CHECK_MESSAGE(result == expected,
+			"Invalid result for " + Convert::ToString(smaller) + " and "
+			+ Convert::ToString(bigger));
+
+		StateVectorType simulated = relation.GetSimulatedByAny(bigger);
+		BOOST_CHECK_MESSAGE(std::includes(simulated.begin(), simulated.end(),
+			smaller.begin(), smaller.end()) == expected,
+			"Invalid states simulated by " + Convert::ToString(bigger) + ": "
+			+ Convert::ToString(simulated));
+	}
+}
+
+BOOST_AUTO_TEST_CASE(first_state)
+{
+	// the states of the relation do not start at zero
+	const StateType FIRST_STATE = 1000000;
+	RelationType shifted(FIRST_STATE);
+
+	fillRelation();
+	for (ReferenceType::const_iterator itRef = reference.begin();
+		itRef != reference.end(); ++itRef)
+	{	// insert the shifted pairs of the reference
+		shifted.insert(std::make_pair(FIRST_STATE + itRef->first,
+			FIRST_STATE + itRef->second));
+	}
+
+	for (StateType p = 0; p < NUM_STATES; ++p)
+	{	// compare the shifted relation with the reference
+		StateVectorType simulators;
+		for (StateType q = 0; q < NUM_STATES; ++q)
+		{
+			bool expected = reference.find(std::make_pair(p, q)) != reference.end();
+			if (expected)
+			{	// in case q simulates p
+				simulators.push_back(FIRST_STATE + q);
+			}
+
+			BOOST_CHECK_MESSAGE(shifted.is_in(std::make_pair(FIRST_STATE + p,
+				FIRST_STATE + q)) == expected,
+				"Invalid membership of " + Convert::ToString(std::make_pair(p, q)));
+			BOOST_CHECK_MESSAGE(!shifted.is_in(std::make_pair(p, q)),
+				"State preceding the first state in " + Convert::ToString(std::make_pair(p, q)));
+		}
+
+		BOOST_CHECK_MESSAGE(shifted.GetSimulators(FIRST_STATE + p) == simulators,
+			"Invalid simulators of " + Convert::ToString(FIRST_STATE + p) + ": "
+			+ Convert::ToString(shifted.GetSimulators(FIRST_STATE + p)));
+		BOOST_CHECK(shifted.GetSimulators(p).empty());
+	}
+
+	BOOST_CHECK_THROW(shifted.insert(std::make_pair(FIRST_STATE - 1, FIRST_STATE)),
+		std::runtime_error);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
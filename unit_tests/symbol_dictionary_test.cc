@@ -0,0 +1,146 @@
+/*****************************************************************************
+ *  Symbolic Finite Tree Automata Library
+ *
+ *  Copyright (c) 2010  Ondra Lengal <ondra@lengal.net>
+ *
+ *  Description:
+ *    Test suite for SymbolDictionary class.
+ *
+ *****************************************************************************/
+
+// Standard library headers
+#include <map>
+#include <stdexcept>
+#include <string>
+
+// SFTA headers
+#include <sfta/compact_variable_assignment.hh>
+#include <sfta/convert.hh>
+#include <sfta/symbol_dictionary.hh>
+
+// Boost headers
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE SymbolDictionary
+#include <boost/test/unit_test.hpp>
+
+// testing headers
+#include "log_fixture.hh"
+
+
+/******************************************************************************
+ *                                  Constants                                 *
+ ******************************************************************************/
+
+/**
+ * Number of symbols translated in the test
+ */
+const unsigned NUM_SYMBOLS = 100;
+
+
+/******************************************************************************
+ *                                  Fixtures                                  *
+ ******************************************************************************/
+
+/**
+ * @brief  SymbolDictionary test fixture
+ *
+ * Fixture for test of SymbolDictionary with strings as input symbols and
+ * variable assignments as output symbols.
+ */
+class SymbolDictionaryFixture : public LogFixture
+{
+public:   // public types
+
+	typedef SFTA::Private::CompactVariableAssignment VariableAssignmentType;
+
+	typedef SFTA::SymbolDictionary
+		<
+			std::string,
+			VariableAssignmentType
+		> DictionaryType;
+
+	typedef SFTA::Private::Convert Convert;
+
+public:   // public methods
+
+	/**
+	 * @brief  Computes the expected width of the encoding
+	 *
+	 * Returns @f$\lceil \log_2 n \rceil@f$ for @f$n@f$ symbols.
+	 *
+	 * @param[in]  numSymbols  The number of symbols
+	 *
+	 * @returns  The expected number of variables of the encoding
+	 */
+	static size_t expectedWidth(size_t numSymbols)
+	{
+		size_t width = 0;
+		while ((static_cast<size_t>(1) << width) < numSymbols)
+		{	// find the smallest sufficient width
+			++width;
+		}
+
+		return width;
+	}
+};
+
+
+/******************************************************************************
+ *                              Start of testing                              *
+ ******************************************************************************/
+
+BOOST_FIXTURE_TEST_SUITE(suite, SymbolDictionaryFixture)
+
+BOOST_AUTO_TEST_CASE(encoding_growth)
+{
+	DictionaryType dict;
+
+	BOOST_CHECK_MESSAGE(dict.GetEncodingWidth() == 0,
+		"Empty dictionary has a nonempty encoding");
+
+	std::map<std::string, VariableAssignmentType> firstEncodings;
+	for (unsigned i = 1; i <= NUM_SYMBOLS; ++i)
+	{	// translate new symbols
+		std::string symbol = "a" + Convert::ToString(i);
+		firstEncodings.insert(std::make_pair(symbol, dict.Translate(symbol)));
+
+		BOOST_CHECK_MESSAGE(dict.GetEncodingWidth() == expectedWidth(i),
+			"Invalid width of the encoding for " + Convert::ToString(i)
+			+ " symbols: " + Convert::ToString(dict.GetEncodingWidth()));
+	}
+
+	std::map<VariableAssignmentType, std::string> seenEncodings;
+	for (std::map<std::string, VariableAssignmentType>::const_iterator itSymbols =
+		firstEncodings.begin(); itSymbols != firstEncodings.end(); ++itSymbols)
+	{	// check that encodings are extended by zeros and are unique
+		VariableAssignmentType encoding = dict.Translate(itSymbols->first);
+
+		BOOST_CHECK_MESSAGE(encoding.VariablesCount() == dict.GetEncodingWidth(),
+			"Encoding " + encoding.ToString() + " of " + itSymbols->first
+			+ " has invalid width");
+
+		for (size_t i = 0; i < encoding.VariablesCount(); ++i)
+		{	// compare with the first encoding of the symbol
+			char expected = VariableAssignmentType::ZERO;
+			if (i < itSymbols->second.VariablesCount())
+			{	// in case the variable was in the first encoding
+				expected = itSymbols->second.GetIthVariableValue(i);
+			}
+
+			BOOST_CHECK_MESSAGE(encoding.GetIthVariableValue(i) == expected,
+				"Encoding " + encoding.ToString() + " of " + itSymbols->first
+				+ " is not an extension of " + itSymbols->second.ToString());
+		}
+
+		BOOST_CHECK_MESSAGE(
+			seenEncodings.insert(std::make_pair(encoding, itSymbols->first)).second,
+			"Encoding " + encoding.ToString() + " is shared by " + itSymbols->first
+			+ " and " + seenEncodings[encoding]);
+
+		BOOST_CHECK_MESSAGE(dict.TranslateInverse(encoding) == itSymbols->first,
+			"Inverse translation of " + encoding.ToString() + " is not "
+			+ itSymbols->first);
+	}
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,253 @@
+/*****************************************************************************
+ *  Symbolic Finite Tree Automata Library
+ *
+ *  Copyright (c) 2010  Ondra Lengal <ondra@lengal.net>
+ *
+ *  Description:
+ *    Test suite for conversion of bottom-up automata to top-down automata.
+ *    The converted automaton is compared with transitions collected for
+ *    every pair of a state and a left-hand side of random automata.
+ *
+ *****************************************************************************/
+
+// Standard library headers
+#include <map>
+#include <vector>
+
+// SFTA headers
+#include <sfta/compact_variable_assignment.hh>
+#include <sfta/convert.hh>
+#include <sfta/cudd_shared_mtbdd.hh>
+#include <sfta/dual_hash_table_leaf_allocator.hh>
+#include <sfta/map_root_allocator.hh>
+#include <sfta/mtbdd_transition_table_wrapper.hh>
+#include <sfta/nd_symbolic_bu_tree_automaton.hh>
+#include <sfta/ordered_vector.hh>
+#include <sfta/vector.hh>
+
+// Boost headers
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE TDConversion
+#include <boost/test/unit_test.hpp>
+#include <boost/random/mersenne_twister.hpp>
+
+// testing headers
+#include "log_fixture.hh"
+
+
+/******************************************************************************
+ *                                  Constants                                 *
+ ******************************************************************************/
+
+/**
+ * Number of random automata
+ */
+const unsigned NUM_AUTOMATA = 20;
+
+/**
+ * Maximum number of states of an automaton
+ */
+const unsigned MAX_STATES = 16;
+
+/**
+ * Number of variables of the encoding of symbols
+ */
+const unsigned NUM_VARIABLES = 3;
+
+/**
+ * Maximum arity of a symbol
+ */
+const unsigned MAX_ARITY = 3;
+
+/**
+ * Maximum number of transitions of an automaton
+ */
+const unsigned MAX_TRANSITIONS = 300;
+
+
+/******************************************************************************
+ *                                  Fixtures                                  *
+ ******************************************************************************/
+
+/**
+ * @brief  Conversion test fixture
+ *
+ * Fixture for test of conversion of bottom-up automata with the same types
+ * as used by SFTA::BUTreeAutomatonCover.
+ */
+class TDConversionFixture : public LogFixture
+{
+public:   // public types
+
+	typedef unsigned StateType;
+	typedef SFTA::Private::CompactVariableAssignment SymbolType;
+	typedef SFTA::Vector<StateType> LeftHandSideType;
+	typedef SFTA::Private::ElemOrVector<StateType> DualStateType;
+	typedef SFTA::OrderedVector<DualStateType> RightHandSideType;
+
+	typedef SFTA::CUDDSharedMTBDD
+	<
+		unsigned,
+		RightHandSideType,
+		SymbolType,
+		SFTA::Private::DualHashTableLeafAllocator,
+		SFTA::Private::MapRootAllocator
+	> SharedMTBDDType;
+
+	typedef SFTA::MTBDDTransitionTableWrapper
+	<
+		StateType,
+		SharedMTBDDType
+	> TTWrapperType;
+
+	typedef SFTA::NDSymbolicBUTreeAutomaton
+	<
+		TTWrapperType,
+		StateType,
+		SymbolType,
+		SFTA::OrderedVector
+	> BUAutomatonType;
+
+	typedef BUAutomatonType::NDSymbolicTDTreeAutomatonType TDAutomatonType;
+
+	typedef std::vector<StateType> StateVectorType;
+	typedef std::vector<LeftHandSideType> LeftHandSideVectorType;
+
+	typedef SFTA::Private::Convert Convert;
+
+public:   // public data members
+
+	boost::mt19937 generator;
+
+	StateVectorType states;
+
+	LeftHandSideVectorType lhss;
+
+public:   // public methods
+
+	TDConversionFixture()
+		: generator(), states(), lhss()
+	{ }
+
+	/**
+	 * @brief  Fills an automaton with random transitions
+	 *
+	 * Creates random states and transitions of the automaton and remembers
+	 * the states and left-hand sides that were used.
+	 *
+	 * @param[in,out]  aut  The automaton to be filled
+	 */
+	void fillAutomaton(BUAutomatonType& aut)
+	{
+		states.clear();
+		lhss.clear();
+
+		unsigned numStates = 1 + generator() % MAX_STATES;
+		for (unsigned i = 0; i < numStates; ++i)
+		{	// create the states
+			states.push_back(aut.AddState());
+			if (generator() % 4 == 0)
+			{	// some of the states are final
+				aut.SetStateFinal(states.back());
+			}
+		}
+
+		std::map<LeftHandSideType, bool> usedLhss;
+		unsigned numTransitions = generator() % MAX_TRANSITIONS;
+		for (unsigned i = 0; i < numTransitions; ++i)
+		{	// add random transitions
+			LeftHandSideType lhs;
+			unsigned arity = generator() % (MAX_ARITY + 1);
+			for (unsigned j = 0; j < arity; ++j)
+			{
+				lhs.push_back(states[generator() % states.size()]);
+			}
+
+			SymbolType symbol(NUM_VARIABLES, generator() % (1 << NUM_VARIABLES));
+
+			RightHandSideType rhs = aut.GetTransition(lhs, symbol);
+			rhs.insert(DualStateType(states[generator() % states.size()]));
+			aut.AddTransition(lhs, symbol, rhs);
+
+			if (!usedLhss[lhs])
+			{	// in case the left-hand side is new
+				usedLhss[lhs] = true;
+				lhss.push_back(lhs);
+			}
+		}
+	}
+
+	/**
+	 * @brief  Reference conversion of a state
+	 *
+	 * Collects the left-hand sides from which there is a transition into
+	 * given state over given symbol by checking every left-hand side, as the
+	 * original conversion did.
+	 *
+	 * @param[in]  aut     The bottom-up automaton
+	 * @param[in]  state   The state
+	 * @param[in]  symbol  The symbol
+	 *
+	 * @returns  The top-down right-hand side of the state
+	 */
+	RightHandSideType referenceTransition(BUAutomatonType& aut,
+		const StateType& state, const SymbolType& symbol) const
+	{
+		RightHandSideType result;
+		for (LeftHandSideVectorType::const_iterator itLhss = lhss.begin();
+			itLhss != lhss.end(); ++itLhss)
+		{
+			RightHandSideType rhs = aut.GetTransition(*itLhss, symbol);
+			if (rhs.find(DualStateType(state)) != rhs.end())
+			{	// in case the left-hand side leads to the state
+				result.insert(DualStateType(*itLhss));
+			}
+		}
+
+		return result;
+	}
+};
+
+
+/******************************************************************************
+ *                              Start of testing                              *
+ ******************************************************************************/
+
+BOOST_FIXTURE_TEST_SUITE(suite, TDConversionFixture)
+
+BOOST_AUTO_TEST_CASE(random_automata)
+{
+	for (unsigned i = 0; i < NUM_AUTOMATA; ++i)
+	{	// compare the conversion of random automata with the reference
+		BUAutomatonType buAut;
+		fillAutomaton(buAut);
+
+		TDAutomatonType* tdAut = buAut.GetTopDownAutomaton();
+
+		for (StateVectorType::const_iterator itStates = states.begin();
+			itStates != states.end(); ++itStates)
+		{
+			BOOST_CHECK_MESSAGE(tdAut->IsStateInitial(*itStates) ==
+				buAut.IsStateFinal(*itStates),
+				"Invalid initial state " + Convert::ToString(*itStates));
+
+			for (unsigned n = 0; n < (1 << NUM_VARIABLES); ++n)
+			{
+				SymbolType symbol(NUM_VARIABLES, n);
+
+				RightHandSideType expected =
+					referenceTransition(buAut, *itStates, symbol);
+				RightHandSideType result = tdAut->GetTransition(*itStates, symbol);
+
+				BOOST_CHECK_MESSAGE(result == expected,
+					"Invalid transition of " + Convert::ToString(*itStates) + " over "
+					+ Convert::ToString(symbol) + ": " + Convert::ToString(result)
+					+ " instead of " + Convert::ToString(expected));
+			}
+		}
+
+		delete tdAut;
+	}
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,189 @@
+/*****************************************************************************
+ *  Symbolic Finite Tree Automata Library
+ *
+ *  Copyright (c) 2010  Ondra Lengal <ondra@lengal.net>
+ *
+ *  Description:
+ *    Test suite for VectorMap class.
+ *
+ *****************************************************************************/
+
+// Standard library headers
+#include <algorithm>
+#include <cassert>
+#include <set>
+#include <stdexcept>
+#include <vector>
+
+// SFTA headers
+#include <sfta/convert.hh>
+#include <sfta/sfta.hh>
+#include <sfta/vector.hh>
+#include <sfta/vector_map.hh>
+
+// Boost headers
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE VectorMap
+#include <boost/test/unit_test.hpp>
+#include <boost/random/mersenne_twister.hpp>
+
+// testing headers
+#include "log_fixture.hh"
+
+
+/******************************************************************************
+ *                                  Constants                                 *
+ ******************************************************************************/
+
+/**
+ * Number of distinct elements of vectors
+ */
+const unsigned NUM_ELEMENTS = 30;
+
+/**
+ * Number of random vectors inserted into the map
+ */
+const unsigned NUM_VECTORS = 1000;
+
+/**
+ * Maximum length of a vector
+ */
+const unsigned MAX_LENGTH = 5;
+
+
+/******************************************************************************
+ *                                  Fixtures                                  *
+ ******************************************************************************/
+
+/**
+ * @brief  VectorMap test fixture
+ *
+ * Fixture for test of VectorMap with unsigned elements and values.
+ */
+class VectorMapFixture : public LogFixture
+{
+public:   // public types
+
+	typedef SFTA::VectorMap<unsigned, unsigned> MapType;
+	typedef MapType::IndexType IndexType;
+	typedef MapType::IndexValueType IndexValueType;
+	typedef MapType::IndexValueArray IndexValueArray;
+	typedef std::set<IndexValueType> ItemSetType;
+
+	typedef SFTA::Private::Convert Convert;
+
+public:   // public data members
+
+	boost::mt19937 generator;
+
+public:   // public methods
+
+	VectorMapFixture()
+		: generator()
+	{ }
+
+	/**
+	 * @brief  Fills a map with random vectors
+	 *
+	 * @param[in]  vecMap  The map to be filled
+	 * @param[in]  count   The number of inserted vectors
+	 */
+	void fillMap(MapType& vecMap, unsigned count)
+	{
+		for (unsigned i = 0; i < count; ++i)
+		{	// insert random vectors, some of them repeatedly
+			IndexType index;
+			unsigned length = 1 + generator() % MAX_LENGTH;
+			for (unsigned j = 0; j < length; ++j)
+			{
+				index.push_back(generator() % NUM_ELEMENTS);
+			}
+
+			vecMap.SetValue(index, 1 + generator() % 100);
+		}
+	}
+
+	/**
+	 * @brief  Collects vectors with an element by traversing the map
+	 *
+	 * @param[in]  vecMap  The map
+	 * @param[in]  elem    The element
+	 *
+	 * @returns  Set of vectors with the element together with their values
+	 */
+	static ItemSetType collectItemsWith(const MapType& vecMap, unsigned elem)
+	{
+		ItemSetType result;
+		for (MapType::const_iterator itMap = vecMap.begin(); itMap != vecMap.end();
+			++itMap)
+		{
+			const IndexType& index = itMap->first;
+			if (std::find(index.begin(), index.end(), elem) != index.end())
+			{	// in case the element is in the vector
+				result.insert(*itMap);
+			}
+		}
+
+		return result;
+	}
+
+	/**
+	 * @brief  Checks the result of GetItemsWith() against a traversal
+	 *
+	 * @param[in]  vecMap  The map
+	 */
+	static void checkItemsWith(const MapType& vecMap)
+	{
+		for (unsigned elem = 0; elem <= NUM_ELEMENTS; ++elem)
+		{	// for each element (including one that is not in the map)
+			IndexValueArray items = vecMap.GetItemsWith(elem);
+
+			ItemSetType found;
+			for (size_t arity = 0; arity < items.size(); ++arity)
+			{
+				for (size_t i = 0; i < items[arity].size(); ++i)
+				{
+					BOOST_CHECK_MESSAGE(items[arity][i].first.size() == arity,
+						"Vector " + Convert::ToString(items[arity][i].first)
+						+ " is returned with invalid arity " + Convert::ToString(arity));
+					BOOST_CHECK_MESSAGE(found.insert(items[arity][i]).second,
+						"Vector " + Convert::ToString(items[arity][i].first)
+						+ " is returned more than once");
+				}
+			}
+
+			BOOST_CHECK_MESSAGE(found == collectItemsWith(vecMap, elem),
+				"Invalid vectors with element " + Convert::ToString(elem));
+		}
+	}
+};
+
+
+/******************************************************************************
+ *                              Start of testing                              *
+ ******************************************************************************/
+
+BOOST_FIXTURE_TEST_SUITE(suite, VectorMapFixture)
+
+BOOST_AUTO_TEST_CASE(items_with_element)
+{
+	MapType vecMap(0);
+	fillMap(vecMap, NUM_VECTORS);
+
+	checkItemsWith(vecMap);
+}
+
+BOOST_AUTO_TEST_CASE(items_after_insertion_of_map)
+{
+	MapType vecMap(0);
+	fillMap(vecMap, NUM_VECTORS / 2);
+
+	MapType otherMap(0);
+	fillMap(otherMap, NUM_VECTORS / 2);
+
+	vecMap.insert(otherMap);
+
+	checkItemsWith(vecMap);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,129 @@
+/*****************************************************************************
+ *  Symbolic Finite Tree Automata Library
+ *
+ *  Copyright (c) 2010  Ondra Lengal <ondra@lengal.net>
+ *
+ *  Description:
+ *    Test suite for WitnessTree class.
+ *
+ *****************************************************************************/
+
+// Standard library headers
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// SFTA headers
+#include <sfta/witness_tree.hh>
+
+// Boost headers
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE WitnessTree
+#include <boost/test/unit_test.hpp>
+
+// testing headers
+#include "log_fixture.hh"
+
+
+/******************************************************************************
+ *                                  Fixtures                                  *
+ ******************************************************************************/
+
+/**
+ * @brief  WitnessTree test fixture
+ *
+ * Fixture for test of WitnessTree with unsigned symbols.
+ */
+class WitnessTreeFixture : public LogFixture
+{
+public:   // public types
+
+	typedef SFTA::WitnessTree<unsigned> TreeType;
+	typedef TreeType::ChildrenType ChildrenType;
+
+
+	/**
+	 * @brief  Translator of symbols
+	 *
+	 * Translates symbol @p i to the @p i -th letter of the alphabet.
+	 */
+	struct LetterTranslator
+	{
+		std::string operator()(unsigned symbol) const
+		{
+			return std::string(1, static_cast<char>('a' + symbol));
+		}
+	};
+
+public:   // public data members
+
+	TreeType tree;
+
+public:   // public methods
+
+	WitnessTreeFixture()
+		: tree()
+	{ }
+
+	static ChildrenType children(size_t first, size_t second)
+	{
+		ChildrenType result;
+		result.push_back(first);
+		result.push_back(second);
+
+		return result;
+	}
+};
+
+
+/******************************************************************************
+ *                              Start of testing                              *
+ ******************************************************************************/
+
+BOOST_FIXTURE_TEST_SUITE(suite, WitnessTreeFixture)
+
+BOOST_AUTO_TEST_CASE(empty_tree)
+{
+	BOOST_CHECK_MESSAGE(tree.IsEmpty(), "New tree is not empty");
+	BOOST_CHECK_MESSAGE(tree.ToString() == "", "Invalid term of empty tree: "
+		+ tree.ToString());
+}
+
+BOOST_AUTO_TEST_CASE(terms)
+{
+	size_t leaf = tree.AddNode(0, ChildrenType());
+	BOOST_CHECK_MESSAGE(tree.ToString(LetterTranslator()) == "a",
+		"Invalid term of leaf: " + tree.ToString(LetterTranslator()));
+
+	size_t unary = tree.AddNode(6, ChildrenType(1, leaf));
+	size_t other = tree.AddNode(1, ChildrenType());
+
+	// the subtree of the unary node is shared
+	tree.AddNode(5, children(unary, other));
+	size_t root = tree.AddNode(5, children(unary, tree.GetRoot()));
+
+	BOOST_CHECK_MESSAGE(tree.GetRoot() == root, "The last node is not the root");
+	BOOST_CHECK_MESSAGE(tree.Size() == 5, "Invalid number of nodes");
+	BOOST_CHECK_MESSAGE(tree.ToString(LetterTranslator()) == "f(g(a), f(g(a), b))",
+		"Invalid term: " + tree.ToString(LetterTranslator()));
+	BOOST_CHECK_MESSAGE(tree.ToString() == "5(6(0), 5(6(0), 1))",
+		"Invalid default term: " + tree.ToString());
+
+	tree.SetRoot(unary);
+	BOOST_CHECK_MESSAGE(tree.ToString(LetterTranslator()) == "g(a)",
+		"Invalid term of subtree: " + tree.ToString(LetterTranslator()));
+
+	tree.Clear();
+	BOOST_CHECK_MESSAGE(tree.IsEmpty(), "Cleared tree is not empty");
+}
+
+BOOST_AUTO_TEST_CASE(invalid_nodes)
+{
+	BOOST_CHECK_THROW(tree.AddNode(0, ChildrenType(1, 0)), std::runtime_error);
+
+	tree.AddNode(0, ChildrenType());
+	BOOST_CHECK_THROW(tree.SetRoot(1), std::runtime_error);
+	BOOST_CHECK_THROW(tree.GetNode(1), std::runtime_error);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,166 @@
+/*****************************************************************************
+ *  Symbolic Finite Tree Automata Library
+ *
+ *  Copyright (c) 2010  Ondra Lengal <ondra@lengal.net>
+ *
+ *  Description:
+ *    Test suite for WorkStealingQueue class.
+ *
+ *****************************************************************************/
+
+// Standard library headers
+#include <stdexcept>
+#include <vector>
+
+// POSIX headers
+#include <pthread.h>
+
+// SFTA headers
+#include <sfta/convert.hh>
+#include <sfta/work_stealing_queue.hh>
+
+// Boost headers
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE WorkStealingQueue
+#include <boost/test/unit_test.hpp>
+
+// testing headers
+#include "log_fixture.hh"
+
+
+/******************************************************************************
+ *                                  Constants                                 *
+ ******************************************************************************/
+
+/**
+ * Number of worker threads
+ */
+const unsigned NUM_WORKERS = 4;
+
+/**
+ * Number of tasks processed by the threads
+ */
+const unsigned NUM_TASKS = 10000;
+
+
+/******************************************************************************
+ *                                  Fixtures                                  *
+ ******************************************************************************/
+
+/**
+ * @brief  WorkStealingQueue test fixture
+ *
+ * Fixture for test of WorkStealingQueue that records by which worker each
+ * task was processed.
+ */
+class WorkStealingQueueFixture : public LogFixture
+{
+public:   // public types
+
+	typedef SFTA::Private::WorkStealingQueue QueueType;
+	typedef QueueType::TaskType TaskType;
+
+	typedef SFTA::Private::Convert Convert;
+
+
+	/**
+	 * @brief  Parameters of a worker thread
+	 */
+	struct Worker
+	{
+		QueueType* queue;
+		size_t number;
+		std::vector<unsigned>* processed;
+
+		Worker()
+			: queue(static_cast<QueueType*>(0)),
+				number(0),
+				processed(static_cast<std::vector<unsigned>*>(0))
+		{ }
+	};
+
+public:   // public data members
+
+	std::vector<unsigned> processed;
+
+public:   // public methods
+
+	WorkStealingQueueFixture()
+		: processed()
+	{ }
+
+	static void* work(void* data)
+	{
+		Worker& worker = *static_cast<Worker*>(data);
+
+		TaskType task;
+		while (worker.queue->Pop(worker.number, task))
+		{	// every task is taken by a single worker, so no locking is needed
+			++(*worker.processed)[task];
+		}
+
+		return static_cast<void*>(0);
+	}
+};
+
+
+/******************************************************************************
+ *                              Start of testing                              *
+ ******************************************************************************/
+
+BOOST_FIXTURE_TEST_SUITE(suite, WorkStealingQueueFixture)
+
+BOOST_AUTO_TEST_CASE(stealing)
+{
+	QueueType queue(2);
+	queue.Push(0, 0);
+	queue.Push(0, 1);
+	queue.Push(0, 2);
+
+	TaskType task = 0;
+	BOOST_CHECK_MESSAGE(queue.Pop(0, task) && (task == 0),
+		"Invalid own task " + Convert::ToString(task));
+	BOOST_CHECK_MESSAGE(queue.Pop(1, task) && (task == 2),
+		"Invalid stolen task " + Convert::ToString(task));
+	BOOST_CHECK_MESSAGE(queue.Pop(1, task) && (task == 1),
+		"Invalid stolen task " + Convert::ToString(task));
+	BOOST_CHECK_MESSAGE(!queue.Pop(0, task), "Task taken from empty queue");
+	BOOST_CHECK_MESSAGE(queue.GetNumberOfStolenTasks() == 2,
+		"Invalid number of stolen tasks");
+
+	BOOST_CHECK_THROW(queue.Push(2, 0), std::runtime_error);
+	BOOST_CHECK_THROW(QueueType(0), std::runtime_error);
+}
+
+BOOST_AUTO_TEST_CASE(threads)
+{
+	processed.assign(NUM_TASKS, 0);
+
+	QueueType queue(NUM_WORKERS);
+	queue.PushRoundRobin(NUM_TASKS);
+
+	std::vector<Worker> workers(NUM_WORKERS);
+	std::vector<pthread_t> threads(NUM_WORKERS);
+	for (size_t i = 0; i < NUM_WORKERS; ++i)
+	{	// start the workers
+		workers[i].queue = &queue;
+		workers[i].number = i;
+		workers[i].processed = &processed;
+
+		BOOST_REQUIRE(pthread_create(&threads[i], static_cast<pthread_attr_t*>(0),
+			work, &workers[i]) == 0);
+	}
+
+	for (size_t i = 0; i < NUM_WORKERS; ++i)
+	{	// wait for the workers
+		pthread_join(threads[i], static_cast<void**>(0));
+	}
+
+	for (size_t task = 0; task < NUM_TASKS; ++task)
+	{	// every task needs to be processed exactly once
+		BOOST_CHECK_MESSAGE(processed[task] == 1, "Task " + Convert::ToString(task)
+			+ " processed " + Convert::ToString(processed[task]) + " times");
+	}
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,167 @@
+/*****************************************************************************
+ *  Symbolic Finite Tree Automata Library
+ *
+ *  Copyright (c) 2010  Ondra Lengal <ondra@lengal.net>
+ *
+ *  Description:
+ *    Test suite for Worklist class.
+ *
+ *****************************************************************************/
+
+// Standard library headers
+#include <vector>
+
+// SFTA headers
+#include <sfta/convert.hh>
+#include <sfta/worklist.hh>
+
+// Boost headers
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE Worklist
+#include <boost/test/unit_test.hpp>
+#include <boost/random/mersenne_twister.hpp>
+
+// testing headers
+#include "log_fixture.hh"
+
+
+/******************************************************************************
+ *                                  Constants                                 *
+ ******************************************************************************/
+
+/**
+ * Number of inserted items
+ */
+const unsigned NUM_ITEMS = 1000;
+
+/**
+ * Number of distinct priorities
+ */
+const unsigned NUM_PRIORITIES = 10;
+
+
+/******************************************************************************
+ *                                  Fixtures                                  *
+ ******************************************************************************/
+
+/**
+ * @brief  Worklist test fixture
+ *
+ * Fixture for test of Worklist with items that are pairs of a priority and
+ * the number of insertion.
+ */
+class WorklistFixture : public LogFixture
+{
+public:   // public types
+
+	typedef std::pair<unsigned, unsigned> ItemType;
+	typedef std::vector<ItemType> ItemVectorType;
+
+	struct ItemPriority
+	{
+		size_t operator()(const ItemType& item) const
+		{
+			return item.first;
+		}
+	};
+
+	typedef SFTA::Private::Worklist<ItemType, ItemPriority> WorklistType;
+
+	typedef SFTA::Private::Convert Convert;
+
+public:   // public data members
+
+	boost::mt19937 generator;
+
+public:   // public methods
+
+	WorklistFixture()
+		: generator()
+	{ }
+
+	/**
+	 * @brief  Fills a worklist and empties it again
+	 *
+	 * Inserts random items into a worklist with given strategy, interleaved
+	 * with some removals, and returns the items in the order in which they
+	 * were removed.
+	 *
+	 * @param[in]  strategy  The strategy of the worklist
+	 *
+	 * @returns  The removed items
+	 */
+	ItemVectorType fillAndEmpty(SFTA::WorklistStrategy strategy)
+	{
+		WorklistType worklist(strategy);
+		ItemVectorType result;
+
+		for (unsigned i = 0; i < NUM_ITEMS; ++i)
+		{	// insert random items
+			worklist.Push(std::make_pair(generator() % NUM_PRIORITIES, i));
+		}
+
+		BOOST_CHECK_MESSAGE(worklist.Size() == NUM_ITEMS,
+			"Invalid size of the worklist: " + Convert::ToString(worklist.Size()));
+
+		while (!worklist.IsEmpty())
+		{	// remove all items
+			result.push_back(worklist.Pop());
+		}
+
+		return result;
+	}
+};
+
+
+/******************************************************************************
+ *                              Start of testing                              *
+ ******************************************************************************/
+
+BOOST_FIXTURE_TEST_SUITE(suite, WorklistFixture)
+
+BOOST_AUTO_TEST_CASE(breadth_first)
+{
+	ItemVectorType items = fillAndEmpty(SFTA::WORKLIST_BFS);
+
+	BOOST_REQUIRE(items.size() == NUM_ITEMS);
+	for (unsigned i = 0; i < NUM_ITEMS; ++i)
+	{	// the items are removed in the order of insertion
+		BOOST_CHECK_MESSAGE(items[i].second == i,
+			"Invalid item " + Convert::ToString(items[i]) + " at " + Convert::ToString(i));
+	}
+}
+
+BOOST_AUTO_TEST_CASE(depth_first)
+{
+	ItemVectorType items = fillAndEmpty(SFTA::WORKLIST_DFS);
+
+	BOOST_REQUIRE(items.size() == NUM_ITEMS);
+	for (unsigned i = 0; i < NUM_ITEMS; ++i)
+	{	// the items are removed in the reverse order of insertion
+		BOOST_CHECK_MESSAGE(items[i].second == NUM_ITEMS - i - 1,
+			"Invalid item " + Convert::ToString(items[i]) + " at " + Convert::ToString(i));
+	}
+}
+
+BOOST_AUTO_TEST_CASE(priority)
+{
+	ItemVectorType items = fillAndEmpty(SFTA::WORKLIST_PRIORITY);
+
+	BOOST_REQUIRE(items.size() == NUM_ITEMS);
+	for (unsigned i = 1; i < NUM_ITEMS; ++i)
+	{	// the items are ordered by priority, then by the order of insertion
+		BOOST_CHECK_MESSAGE(items[i - 1] < items[i],
+			"Item " + Convert::ToString(items[i - 1]) + " is removed before "
+			+ Convert::ToString(items[i]));
+	}
+}
+
+BOOST_AUTO_TEST_CASE(empty_worklist)
+{
+	WorklistType worklist(SFTA::WORKLIST_BFS);
+
+	BOOST_CHECK(worklist.IsEmpty());
+	BOOST_CHECK_THROW(worklist.Pop(), std::runtime_error);
+}
+
+BOOST_AUTO_TEST_SUITE_END()